@@ -0,0 +1,114 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "mis.c"
+
+/*
+	Orca: Single-Pass Asynchronous Maximal Independent Set
+
+	The driver symmetrizes the input graph (if it is not symmetric), computes a maximal independent set
+	using Orca and validates it.
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 32);
+		assert(exec_info != NULL);
+
+	// Symmetrizing the graph
+		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
+		{
+			struct ll_400_graph* sym_graph = symmetrize_graph(pe, graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+
+			// Releasing the input graph
+				if(read_flags & 1U<<31)
+					release_shm_ll_400_graph(graph);
+				else
+					release_numa_interleaved_ll_400_graph(graph);
+				graph = sym_graph;
+				sym_graph = NULL;
+		}
+		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// MIS
+		unsigned long mis_size = 0;
+		unsigned char* states = orca_mis(pe, graph, 1U, exec_info, &mis_size);
+
+	// Validating
+		assert(mis_validate(pe, graph, states, mis_size));
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-10s; %-10s; %-10s;", "Dataset", "|V|", "|E|", "MIS", "Pushed", "Time(ms)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			char temp3 [16];
+			char temp4 [16];
+			fprintf(out, "%-20s; %8s; %8s; %10s; %10s; %'10.1f;", LL_INPUT_GRAPH_BASE_NAME, ul2s(graph->vertices_count, temp1),
+				ul2s(graph->edges_count, temp2), ul2s(mis_size, temp3), ul2s(exec_info[9], temp4), exec_info[0] / 1e6);
+			for(unsigned int i = 0; i < pe->hw_events_count; i++)
+				fprintf(out, " %15s;", ul2s(exec_info[1 + i], temp1));
+			fprintf(out, "\n");
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		mis_release(graph, states);
+		states = NULL;
+
+		if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+			release_shm_ll_400_graph(graph);
+		else
+			release_numa_interleaved_ll_400_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
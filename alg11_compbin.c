@@ -33,6 +33,7 @@ int main(int argc, char** args)
 		int transpose = 0;
 		int symmetrize = 0;
 		int randomize = 0;
+		int in_place = 0;
 		char* output_path = NULL;
 		for(int r = 1; r < argc; r++)
 		{
@@ -45,6 +46,9 @@ int main(int argc, char** args)
 			if(!strcmp(args[r], "-r"))
 				randomize = 1;
 
+			if(!strcmp(args[r], "-l"))
+				in_place = 1;
+
 			if(!strcmp(args[r], "-o"))
 			{
 				assert(r + 1 < argc);
@@ -52,7 +56,7 @@ int main(int argc, char** args)
 			}
 		}
 
-		printf("Transform: transpose: %d, symmetrize: %d, randomize: %d\n", transpose, symmetrize, randomize);
+		printf("Transform: transpose: %d, symmetrize: %d, randomize: %d, in-place: %d\n", transpose, symmetrize, randomize, in_place);
 		assert(output_path != NULL);
 		printf("Output path: %s\n", output_path);
 		assert(transpose == 0 || symmetrize == 0);
@@ -62,11 +66,14 @@ int main(int argc, char** args)
 		int read_flags = 0;
 		
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that do not require omp 
+			// Reading the textual graph
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		assert((read_flags & (1U<<31)) == 0);
 		assert(graph != NULL);
 		assert(graph->vertices_count >= (1UL<<24));
@@ -105,14 +112,26 @@ int main(int argc, char** args)
 		{
 			unsigned int* RA_o2n = get_create_fixed_random_ordering(pe, LL_INPUT_GRAPH_BASE_NAME, graph->vertices_count, 5);
 
-			struct ll_400_graph* rel_graph = relabel_graph(pe, graph, RA_o2n, 0); // 2U: sort neighborlists
-			assert(rel_graph != NULL);
+			if(in_place)
+			{
+				// Low-memory relabeling without a second copy of the edges, requires |V| < 2^31
+				assert(graph->vertices_count < (1UL<<31));
+				relabel_graph_in_place(pe, graph, RA_o2n, 0); // 2U: sort neighborlists
 
-			munmap(RA_o2n, sizeof(unsigned int) * graph->vertices_count);
-			RA_o2n = NULL;
-			release_numa_interleaved_ll_400_graph(graph);
-			graph = rel_graph;
-			rel_graph = NULL;	
+				munmap(RA_o2n, sizeof(unsigned int) * graph->vertices_count);
+				RA_o2n = NULL;
+			}
+			else
+			{
+				struct ll_400_graph* rel_graph = relabel_graph(pe, graph, RA_o2n, 0); // 2U: sort neighborlists
+				assert(rel_graph != NULL);
+
+				munmap(RA_o2n, sizeof(unsigned int) * graph->vertices_count);
+				RA_o2n = NULL;
+				release_numa_interleaved_ll_400_graph(graph);
+				graph = rel_graph;
+				rel_graph = NULL;	
+			}
 		}
 
 	// Writing the graph in CompBin format
@@ -0,0 +1,146 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "bfs.c"
+
+/*
+	Direction-Optimizing BFS
+
+	The driver runs BFS from `roots` vertices with non-zero out-degrees, prints the time of each level, and
+	validates the levels against the serial BFS. For non-symmetric graphs, the CSC is created using
+	`atomic_transpose()`.
+
+	args[1]: number of roots, default: 8
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int roots = 8;
+		if(argc > 1)
+			roots = max(1, atoi(args[1]));
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 32);
+		assert(exec_info != NULL);
+
+	// Transposing the graph
+		struct ll_400_graph* csr_graph = graph;
+		struct ll_400_graph* csc_graph = csr_graph;
+		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
+		{
+			csc_graph = atomic_transpose(pe, csr_graph, 0);
+			printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csc_graph->vertices_count,csc_graph->edges_count);
+		}
+
+	// BFS from the roots
+		unsigned long total_time = 0;
+		unsigned long total_levels = 0;
+		unsigned long total_visited = 0;
+		unsigned long root_seed = 1;
+		for(unsigned int r = 0; r < roots; r++)
+		{
+			// Selecting a root with non-zero out-degree
+			unsigned int root = 0;
+			for(unsigned int t = 0; t < 1000; t++)
+			{
+				root_seed = root_seed * 6364136223846793005UL + 1442695040888963407UL;
+				root = (root_seed >> 33) % csr_graph->vertices_count;
+				if(csr_graph->offsets_list[root + 1] != csr_graph->offsets_list[root])
+					break;
+			}
+
+			unsigned int* levels = bfs_do(pe, csr_graph, csc_graph, root, 1U, exec_info);
+			total_time += exec_info[0];
+			total_levels += exec_info[8];
+			total_visited += exec_info[9];
+
+			// Validating
+			unsigned int* levels_s = bfs_serial(csr_graph, root);
+			unsigned long errors = 0;
+			#pragma omp parallel for reduction(+:errors)
+			for(unsigned int v = 0; v < csr_graph->vertices_count; v++)
+				if(levels[v] != levels_s[v])
+					errors++;
+			if(errors)
+				printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors\n", errors);
+			else
+				printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+			assert(errors == 0);
+
+			bfs_release(csr_graph, levels_s);
+			levels_s = NULL;
+			bfs_release(csr_graph, levels);
+			levels = NULL;
+		}
+		printf("\nRoots: %'u, Avg. time: %'.2f (ms), Avg. levels: %'.1f, Avg. visited vertices: %'.1f\n", roots,
+			total_time / 1e6 / roots, 1.0 * total_levels / roots, 1.0 * total_visited / roots);
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+				fprintf(out, "%-20s; %-8s; %-8s; %-6s; %-12s; %-10s; %-10s;\n", "Dataset", "|V|", "|E|", "Roots",
+					"Avg.Time(ms)", "Avg.Levels", "Avg.Visited");
+
+			char temp1 [16];
+			char temp2 [16];
+			char temp3 [16];
+			fprintf(out, "%-20s; %8s; %8s; %6u; %'12.2f; %'10.1f; %10s;\n", LL_INPUT_GRAPH_BASE_NAME,
+				ul2s(csr_graph->vertices_count, temp1), ul2s(csr_graph->edges_count, temp2), roots, total_time / 1e6 / roots,
+				1.0 * total_levels / roots, ul2s(total_visited / roots, temp3));
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		if(csc_graph != csr_graph)
+			release_numa_interleaved_ll_400_graph(csc_graph);
+		csc_graph = NULL;
+
+		if(read_flags & 1U<<31)
+			release_shm_ll_400_graph(csr_graph);
+		else
+			release_numa_interleaved_ll_400_graph(csr_graph);
+		csr_graph = NULL;
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
@@ -0,0 +1,183 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "sssp.c"
+
+/*
+	Delta-Stepping SSSP
+
+	The driver runs delta-stepping SSSP from `sources` vertices with non-zero degrees and validates the
+	distances against the serial Dijkstra. Similar to MASTIFF, if the input graph is not weighted, it is
+	symmetrized and random weights are added to its edges.
+
+	args[1]: number of sources, default: 4
+	args[2]: delta, default: 0 (automatically selected)
+*/
+
+int main(int argc, char** args)
+{	
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int sources = 4;
+		if(argc > 1)
+			sources = max(1, atoi(args[1]));
+		unsigned int delta = 0;
+		if(argc > 2)
+			delta = atoi(args[2]);
+
+	// Reading the grpah
+		struct ll_400_graph* csr_graph = NULL;
+		struct ll_400_graph* sym_graph = NULL;
+		struct ll_404_graph* wgraph = NULL;
+		int read_flags = 0;
+		
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			csr_graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			csr_graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			csr_graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_404_AP"))	
+			wgraph = get_ll_404_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		assert(csr_graph != NULL || wgraph != NULL);
+		
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store input graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+		{
+			if(csr_graph != NULL)
+				store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+			else
+				store_shm_ll_404_graph(pe, LL_INPUT_GRAPH_PATH, wgraph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+		}
+		
+	// Initializing exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 20);
+		assert(exec_info != NULL);
+
+	// Symmetrizing and adding weights to the graph if it is not weighted (weighted graphs are used as they are)
+		if(wgraph == NULL)
+		{
+			printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csr_graph->vertices_count,csr_graph->edges_count);
+			
+			if(LL_INPUT_GRAPH_IS_SYMMETRIC == 0)
+			{
+				sym_graph = symmetrize_graph(pe, csr_graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+				printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,sym_graph->vertices_count,sym_graph->edges_count);
+
+				if(read_flags & 1U<<31)
+					release_shm_ll_400_graph(csr_graph);
+				else
+					release_numa_interleaved_ll_400_graph(csr_graph);
+			}
+			else
+				sym_graph = csr_graph;
+
+			csr_graph = NULL;
+
+			wgraph = add_4B_weight_to_ll_400_graph(pe, sym_graph, 1024*100, 0); // 1U: validate
+			printf("Weighted: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,wgraph->vertices_count,wgraph->edges_count);
+		}
+		else
+			printf("Weighted: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,wgraph->vertices_count,wgraph->edges_count);
+
+	// SSSP from the sources
+		unsigned long total_time = 0;
+		unsigned long total_reached = 0;
+		unsigned long source_seed = 1;
+		for(unsigned int s = 0; s < sources; s++)
+		{
+			// Selecting a source with non-zero degree
+			unsigned int source = 0;
+			for(unsigned int t = 0; t < 1000; t++)
+			{
+				source_seed = source_seed * 6364136223846793005UL + 1442695040888963407UL;
+				source = (source_seed >> 33) % wgraph->vertices_count;
+				if(wgraph->offsets_list[source + 1] != wgraph->offsets_list[source])
+					break;
+			}
+
+			unsigned long* dist = sssp_delta_stepping(pe, wgraph, source, delta, 1U, exec_info);
+			total_time += exec_info[0];
+			total_reached += exec_info[11];
+
+			// Validating
+			unsigned long* dist_d = sssp_dijkstra_serial(wgraph, source);
+			unsigned long errors = 0;
+			#pragma omp parallel for reduction(+:errors)
+			for(unsigned int v = 0; v < wgraph->vertices_count; v++)
+				if(dist[v] != dist_d[v])
+					errors++;
+			if(errors)
+				printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors\n", errors);
+			else
+				printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+			assert(errors == 0);
+
+			sssp_release(wgraph, dist_d);
+			dist_d = NULL;
+			sssp_release(wgraph, dist);
+			dist = NULL;
+		}
+		printf("\nSources: %'u, Delta: %'lu, Avg. time: %'.2f (ms), Avg. reached vertices: %'.1f\n", sources, exec_info[8],
+			total_time / 1e6 / sources, 1.0 * total_reached / sources);
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-7s; %-8s; %-12s;", "Dataset", "|V|", "|E|", "Sources", "Delta", "Avg.Time(ms)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			fprintf(out, "%-20s; %8s; %8s; %7u; %8lu; %'12.2f;", LL_INPUT_GRAPH_BASE_NAME, ul2s(wgraph->vertices_count, temp1),
+				ul2s(wgraph->edges_count, temp2), sources, exec_info[8], total_time / 1e6 / sources);
+			for(unsigned int i = 0; i < pe->hw_events_count; i++)
+				fprintf(out, " %15s;", ul2s(exec_info[1 + i], temp1));
+			fprintf(out, "\n");
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing graph and memory
+		if(sym_graph != NULL)
+		{
+			if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+				release_shm_ll_400_graph(sym_graph);
+			else
+				release_numa_interleaved_ll_400_graph(sym_graph);
+			sym_graph = NULL;
+		}
+
+		if(strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_404_AP") == 0 && (read_flags & 1U<<31))
+			release_shm_ll_404_graph(wgraph);
+		else
+			release_numa_interleaved_ll_404_graph(wgraph);
+		wgraph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
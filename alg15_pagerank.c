@@ -0,0 +1,152 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "pagerank.c"
+
+/*
+	PageRank using pull, push, and cache-blocked pull SpMV
+
+	The driver transposes the input graph using PoTra (with sorted neighbour-lists, as required by
+	the blocked mode), runs PageRank in the selected mode(s), and validates the results of the push and
+	blocked modes against the pull mode. If both the pull and blocked modes are run, the speedup of 
+	the blocked mode over the pull mode is reported.
+
+	args[1]: number of iterations, default: 10
+	args[2]: mode, 0: pull, 1: push, 2: blocked, default: all modes
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int iterations = 10;
+		if(argc > 1)
+			iterations = max(1, atoi(args[1]));
+		unsigned int first_mode = LL_PR_PULL;
+		unsigned int last_mode = LL_PR_BLOCKED;
+		if(argc > 2)
+		{
+			first_mode = atoi(args[2]);
+			assert(first_mode <= LL_PR_BLOCKED);
+			last_mode = first_mode;
+		}
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info: [0-39] for PoTra and [40 * (1 + mode), 40 * (2 + mode)) for each mode
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 40 * 4);
+		assert(exec_info != NULL);
+
+	// Transposing the input CSR graph
+		struct ll_400_graph* csr_graph = graph;
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csr_graph->vertices_count,csr_graph->edges_count);
+
+		struct ll_400_graph* csc_graph = NULL;
+		if(first_mode != LL_PR_PUSH || last_mode != LL_PR_PUSH)
+		{
+			csc_graph = potra(pe, csr_graph, 2U, exec_info); // sort neighbour-lists
+			printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csc_graph->vertices_count,csc_graph->edges_count);
+		}
+
+	// PageRank
+		unsigned long vc = csr_graph->vertices_count;
+		double* ranks[3] = {NULL, NULL, NULL};
+		for(unsigned int mode = first_mode; mode <= last_mode; mode++)
+		{
+			ranks[mode] = pagerank(pe, csr_graph, csc_graph, mode, iterations, 1U, &exec_info[40 * (1 + mode)]);
+			if(mode != LL_PR_PULL && ranks[LL_PR_PULL] != NULL)
+				assert(pagerank_validate(pe, vc, ranks[LL_PR_PULL], ranks[mode]));
+		}
+
+	// Comparing the blocked mode against the pull mode
+		if(ranks[LL_PR_PULL] != NULL && ranks[LL_PR_BLOCKED] != NULL)
+		{
+			unsigned long* pull_ei = &exec_info[40 * (1 + LL_PR_PULL)];
+			unsigned long* blocked_ei = &exec_info[40 * (1 + LL_PR_BLOCKED)];
+			printf("Blocked vs. Pull: \t\t iterations time: %'.1f vs. %'.1f (ms), speedup: %.2f, blocked preprocessing: %'.1f (ms), segments: %'lu\n\n",
+				blocked_ei[13] / 1e6, pull_ei[13] / 1e6, 1.0 * pull_ei[13] / max(1UL, blocked_ei[13]), blocked_ei[12] / 1e6, blocked_ei[15]);
+		}
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-8s; %-6s; %-8s; %-10s; %-10s; %-10s; %-10s; %-10s;", "Dataset", "|V|", "|E|",
+					"Mode", "Iters", "Blocks", "Trans(ms)", "Prep(ms)", "Iters(ms)", "PkgE(J)", "DRAME(J)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			for(unsigned int mode = first_mode; mode <= last_mode; mode++)
+			{
+				unsigned long* ei = &exec_info[40 * (1 + mode)];
+				fprintf(out, "%-20s; %8s; %8s; %-8s; %6lu; %8lu; %'10.1f; %'10.1f; %'10.1f; %10lu; %10lu;", LL_INPUT_GRAPH_BASE_NAME,
+					ul2s(csr_graph->vertices_count, temp1), ul2s(csr_graph->edges_count, temp2), pagerank_mode_names[mode],
+					ei[9], ei[10], exec_info[0] / 1e6, ei[12] / 1e6, ei[13] / 1e6, ei[18], ei[19]);
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %15s;", ul2s(ei[1 + i], temp1));
+				fprintf(out, "\n");
+			}
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		for(unsigned int mode = first_mode; mode <= last_mode; mode++)
+		{
+			pagerank_release(vc, ranks[mode]);
+			ranks[mode] = NULL;
+		}
+
+		if(csc_graph != NULL)
+		{
+			release_numa_interleaved_ll_400_graph(csc_graph);
+			csc_graph = NULL;
+		}
+
+		if(read_flags & 1U<<31)
+			release_shm_ll_400_graph(csr_graph);
+		else
+			release_numa_interleaved_ll_400_graph(csr_graph);
+		csr_graph = NULL;
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
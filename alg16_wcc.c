@@ -0,0 +1,133 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "wcc.c"
+
+/*
+	Weakly Connected Components of directed graphs without symmetrization
+
+	The driver runs:
+		0: Thrifty over the CSR and its CSC (created by PoTra), `wcc_thrifty()`
+		1: Afforest with a push pass over the CSR, `wcc_afforest_push()`
+	and validates their results.
+
+	args[1]: the variant, default: both
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int first_variant = 0;
+		unsigned int last_variant = 1;
+		if(argc > 1)
+		{
+			first_variant = atoi(args[1]);
+			assert(first_variant <= 1);
+			last_variant = first_variant;
+		}
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info: [0-39] for PoTra and [40 * (1 + variant), 40 * (2 + variant)) for each variant
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 40 * 3);
+		assert(exec_info != NULL);
+
+	// Thrifty over the CSR and CSC
+		unsigned int ccs[2] = {0, 0};
+		if(first_variant == 0)
+		{
+			struct ll_400_graph* csc_graph = potra(pe, graph, 0, exec_info);
+			printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, csc_graph->vertices_count, csc_graph->edges_count);
+
+			unsigned int* cc = wcc_thrifty(pe, graph, csc_graph, 1U, &exec_info[40], &ccs[0]);
+
+			release_numa_interleaved_ll_400_graph(csc_graph);
+			csc_graph = NULL;
+
+			assert(wcc_validate(pe, graph, cc, ccs[0]));
+			wcc_release(graph, cc);
+			cc = NULL;
+		}
+
+	// Afforest with push over the CSR
+		if(last_variant == 1)
+		{
+			unsigned int* cc = wcc_afforest_push(pe, graph, 1U, &exec_info[80], &ccs[1]);
+			assert(wcc_validate(pe, graph, cc, ccs[1]));
+			wcc_release(graph, cc);
+			cc = NULL;
+		}
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-10s; %-8s; %-10s; %-10s;", "Dataset", "|V|", "|E|",
+					"Variant", "|CCs|", "Trans(ms)", "Time(ms)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			char temp3 [16];
+			for(unsigned int variant = first_variant; variant <= last_variant; variant++)
+			{
+				unsigned long* ei = &exec_info[40 * (1 + variant)];
+				fprintf(out, "%-20s; %8s; %8s; %-10s; %8s; %'10.1f; %'10.1f;", LL_INPUT_GRAPH_BASE_NAME,
+					ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), variant == 0 ? "Thrifty" : "Afforest",
+					ul2s(ccs[variant], temp3), variant == 0 ? exec_info[0] / 1e6 : 0.0, ei[0] / 1e6);
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %15s;", ul2s(ei[1 + i], temp1));
+				fprintf(out, "\n");
+			}
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		if(read_flags & 1U<<31)
+			release_shm_ll_400_graph(graph);
+		else
+			release_numa_interleaved_ll_400_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
@@ -0,0 +1,136 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "scc.c"
+
+/*
+	Strongly Connected Components using Trimming, Forward-Backward, and Coloring
+
+	The driver transposes the input graph using PoTra, identifies the SCCs, prints the size of the
+	largest SCC, and validates the result against the serial Tarjan's algorithm.
+
+	args[1]: validate, default: 1
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int validate = 1;
+		if(argc > 1)
+			validate = atoi(args[1]);
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info: [0-39] for PoTra and [40-79] for SCC
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 80);
+		assert(exec_info != NULL);
+
+	// Transposing the input CSR graph
+		struct ll_400_graph* csc_graph = potra(pe, graph, 0, exec_info);
+		printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, csc_graph->vertices_count, csc_graph->edges_count);
+
+	// SCC
+		unsigned int sccs = 0;
+		unsigned int* scc = scc_multistep(pe, graph, csc_graph, 1U, &exec_info[40], &sccs);
+
+	// Largest SCC
+		unsigned long largest_scc = 0;
+		{
+			unsigned int* sizes = numa_alloc_interleaved(sizeof(unsigned int) * graph->vertices_count);
+			assert(sizes != NULL);
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < graph->vertices_count; v++)
+				sizes[v] = 0;
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < graph->vertices_count; v++)
+				__atomic_add_fetch(&sizes[scc[v]], 1U, __ATOMIC_RELAXED);
+			#pragma omp parallel for reduction(max:largest_scc)
+			for(unsigned int v = 0; v < graph->vertices_count; v++)
+				if(sizes[v] > largest_scc)
+					largest_scc = sizes[v];
+			numa_free(sizes, sizeof(unsigned int) * graph->vertices_count);
+			sizes = NULL;
+		}
+		printf("Largest SCC:      \t\t%'lu (%.1f%%)\n", largest_scc, 100.0 * largest_scc / graph->vertices_count);
+
+	// Validating
+		if(validate)
+			assert(scc_validate(pe, graph, scc, sccs));
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			unsigned long* ei = &exec_info[40];
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-8s; %-8s; %-10s; %-10s; %-10s; %-10s; %-10s; %-6s;", "Dataset", "|V|", "|E|",
+					"|SCCs|", "Largest", "Trans(ms)", "Total(ms)", "Trim(ms)", "FB(ms)", "Color(ms)", "Rounds");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			char temp3 [16];
+			char temp4 [16];
+			fprintf(out, "%-20s; %8s; %8s; %8s; %8s; %'10.1f; %'10.1f; %'10.1f; %'10.1f; %'10.1f; %6lu;", LL_INPUT_GRAPH_BASE_NAME,
+				ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), ul2s(sccs, temp3), ul2s(largest_scc, temp4),
+				exec_info[0] / 1e6, ei[0] / 1e6, ei[13] / 1e6, ei[14] / 1e6, ei[15] / 1e6, ei[12]);
+			for(unsigned int i = 0; i < pe->hw_events_count; i++)
+				fprintf(out, " %15s;", ul2s(ei[1 + i], temp1));
+			fprintf(out, "\n");
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		scc_release(graph, scc);
+		scc = NULL;
+
+		release_numa_interleaved_ll_400_graph(csc_graph);
+		csc_graph = NULL;
+
+		if(read_flags & 1U<<31)
+			release_shm_ll_400_graph(graph);
+		else
+			release_numa_interleaved_ll_400_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
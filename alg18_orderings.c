@@ -0,0 +1,184 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "cc.c"
+
+/*
+	Locality-Optimizing Vertex Orderings
+
+	The driver creates the relabeling arrays of the selected orderings, validates them, relabels the 
+	(symmetrized) graph, and executes Thrifty on the relabeled graph to measure the impacts of the ordering.
+
+	args[1]: ordering, 0: initial IDs, 1: RCM, 2: hub-cluster, 3: hub-sort, 4: Gorder-lite (on RCM), default: all
+	args[2]: 1: load/store the orderings from/in LL_GRAPH_RA_BIN_FOLDER using `get_create_cached_ordering()`, default: 0
+*/
+
+char* ordering_names[] = {"Initial", "RCM", "HubCluster", "HubSort", "GorderLite"};
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int first_ordering = 0;
+		unsigned int last_ordering = 4;
+		if(argc > 1)
+		{
+			first_ordering = atoi(args[1]);
+			assert(first_ordering <= 4);
+			last_ordering = first_ordering;
+		}
+		unsigned int use_cache = 0;
+		if(argc > 2)
+			use_cache = atoi(args[2]);
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info: for each ordering, [80 * ordering, 80 * ordering + 40) for the ordering and 
+	// [80 * ordering + 40, 80 * ordering + 80) for Thrifty on the relabeled graph
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 80 * 5);
+		assert(exec_info != NULL);
+		unsigned long relabel_times[5] = {0};
+
+	// Symmetrizing the graph
+		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
+		{
+			struct ll_400_graph* sym_graph = symmetrize_graph(pe, graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+
+			// Releasing the input graph
+				if(read_flags & 1U<<31)
+					release_shm_ll_400_graph(graph);
+				else
+					release_numa_interleaved_ll_400_graph(graph);
+				graph = sym_graph;
+				sym_graph = NULL;
+		}
+		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Orderings
+		unsigned int ccs[5] = {0};
+		for(unsigned int ordering = first_ordering; ordering <= last_ordering; ordering++)
+		{
+			unsigned long* ei = &exec_info[80 * ordering];
+			unsigned int* RA_o2n = NULL;
+			if(use_cache && ordering != 0)
+			{
+				// The LL_ORDERING_* types 1 to 4 match the orderings of this driver
+				ei[0] = - get_nano_time();
+				RA_o2n = get_create_cached_ordering(pe, LL_INPUT_GRAPH_BASE_NAME, graph, ordering, 0);
+				ei[0] += get_nano_time();
+			}
+			else if(ordering == 1)
+				RA_o2n = rcm_ordering(pe, graph, ei, 1U);
+			else if(ordering == 2)
+				RA_o2n = hub_ordering(pe, graph, ei, 1U);
+			else if(ordering == 3)
+				RA_o2n = hub_ordering(pe, graph, ei, 1U + 4U);  // 4U: hub-sort
+			else if(ordering == 4)
+			{
+				// Gorder-lite over the partitions of RCM
+				unsigned int* base_RA_o2n = rcm_ordering(pe, graph, ei, 1U);
+				unsigned long base_time = ei[0];
+				RA_o2n = gorder_lite_ordering(pe, graph, base_RA_o2n, ei, 1U);
+				ei[0] += base_time;
+
+				numa_free(base_RA_o2n, sizeof(unsigned int) * graph->vertices_count);
+				base_RA_o2n = NULL;
+			}
+
+			struct ll_400_graph* rel_graph = graph;
+			if(RA_o2n != NULL)
+			{
+				assert(relabeling_array_validate(pe, RA_o2n, graph->vertices_count));
+
+				relabel_times[ordering] = - get_nano_time();
+				rel_graph = relabel_graph(pe, graph, RA_o2n, 2U); // 2U: sort neighbour-lists
+				relabel_times[ordering] += get_nano_time();
+
+				if(use_cache)
+					munmap(RA_o2n, sizeof(unsigned int) * graph->vertices_count);
+				else
+					numa_free(RA_o2n, sizeof(unsigned int) * graph->vertices_count);
+				RA_o2n = NULL;
+			}
+
+			unsigned int* cc = cc_thrifty_400(pe, rel_graph, 1U, &ei[40], &ccs[ordering]);
+			assert(ccs[ordering] == ccs[first_ordering]);
+			cc_release(rel_graph, cc);
+			cc = NULL;
+
+			if(rel_graph != graph)
+				release_numa_interleaved_ll_400_graph(rel_graph);
+			rel_graph = NULL;
+		}
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-10s; %-10s; %-11s; %-10s;", "Dataset", "|V|", "|E|",
+					"Ordering", "Order(ms)", "Relabel(ms)", "CC(ms)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			for(unsigned int ordering = first_ordering; ordering <= last_ordering; ordering++)
+			{
+				unsigned long* ei = &exec_info[80 * ordering];
+				fprintf(out, "%-20s; %8s; %8s; %-10s; %'10.1f; %'11.1f; %'10.1f;", LL_INPUT_GRAPH_BASE_NAME,
+					ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), ordering_names[ordering],
+					ei[0] / 1e6, relabel_times[ordering] / 1e6, ei[40] / 1e6);
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %15s;", ul2s(ei[40 + 1 + i], temp1));
+				fprintf(out, "\n");
+			}
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+			release_shm_ll_400_graph(graph);
+		else
+			release_numa_interleaved_ll_400_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
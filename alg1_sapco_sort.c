@@ -16,11 +16,17 @@ int main(int argc, char** args)
 		struct ll_400_graph* graph = NULL;
 		int read_flags = 0;
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that does not require omp 
+			// Reading the textual graph
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(LL_STREAM_INPUT_GRAPH)
+			// Streaming a WebGraph: the first pass of the algorithm is overlapped with loading the edges
+			read_flags |= 4U;
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		assert(graph != NULL);
 		
 	// Initializing omp
@@ -28,7 +34,7 @@ int main(int argc, char** args)
 
 	// Store graph in shm
 		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
-			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 	
 	// Exec info	
 		unsigned long* exec_info = calloc(sizeof(unsigned long), 20);
@@ -39,6 +45,7 @@ int main(int argc, char** args)
 		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csr_graph->vertices_count,csr_graph->edges_count);
 
 		struct ll_400_graph* csc_graph = atomic_transpose(pe, csr_graph, 8U); // bit 3: do not write edges
+		ll_400_stream_finish(csr_graph);
 		printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csc_graph->vertices_count,csc_graph->edges_count);
 
 	// Creating the reordering array
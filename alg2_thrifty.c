@@ -19,7 +19,273 @@
 	  publisher={IEEE Computer Society},
 	  doi={10.1109/Cluster48925.2021.00042}
 	}
+
+	args[1]: CC algorithm, 0: Thrifty (default), 1: Jayanti-Tarjan, 2: Afforest, 3: Incremental (Jayanti-Tarjan and batches)
+	args[2]: number of batches for the incremental CC, default: 4
+*/
+
+void write_report(struct par_env* pe, unsigned long vertices_count, unsigned long edges_count, unsigned long* exec_info)
+{
+	if(LL_OUTPUT_REPORT_PATH != NULL)
+	{
+		FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+		if(out != NULL)
+		{
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-13s;", "Dataset", "|V|", "|E|", "Time (ms)");
+				if(exec_info)
+					for(unsigned int i=0; i<pe->hw_events_count; i++)
+						fprintf(out, " %-8s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];			
+			char* name = strrchr(LL_INPUT_GRAPH_PATH, '/');
+			if(name == NULL)
+				name = LL_INPUT_GRAPH_PATH;
+			else
+				name++;
+			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
+				name = strndup(name, strrchr(name, '.') - name);
+			
+			fprintf(out, "%-20s; %'8s; %'8s; %'13.1f;", 
+				name, ul2s(vertices_count, temp1), ul2s(edges_count, temp2), exec_info[10 + 0] / 1e6);
+			if(exec_info)
+				for(unsigned int i=0; i<pe->hw_events_count; i++)					
+					fprintf(out, " %'8s;", ul2s(exec_info[10 + i + 1], temp1));
+			fprintf(out, "\n");
+
+			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
+				free(name);
+			name = NULL;
+
+			fclose(out);
+			out = NULL;
+		}
+	}
+
+	return;
+}
+
+/*
+	Thrifty on graphs with 8 Bytes vertex IDs, i.e., |V| >= 2^32
+*/
+int thrifty_800()
+{
+	// Reading the grpah
+		unsigned int read_flags = 0;
+		struct ll_800_graph* graph = get_ll_800_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_800_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+		
+	// Exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 32);
+		assert(exec_info != NULL);
+
+	// Symmetrizing the graph		
+		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
+		{
+			struct ll_800_graph* sym_graph = symmetrize_graph_800(pe, graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+
+			// Releasing the input graph
+				if(read_flags & 1U<<31)
+					release_shm_ll_800_graph(graph);
+				else
+					release_numa_interleaved_ll_800_graph(graph);
+				graph = sym_graph;
+				sym_graph = NULL;
+		}		
+		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// CC
+		unsigned long ccs_t = 0;
+		unsigned long* cc_t = cc_thrifty_800(pe, graph, 1U, &exec_info[10], &ccs_t);
+
+	// Writing to the report
+		write_report(pe, graph->vertices_count, graph->edges_count, exec_info);
+
+	// Releasing memory
+		cc_release_800(graph, cc_t);
+		cc_t = NULL;
+		
+		if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+			release_shm_ll_800_graph(graph);
+		else
+			release_numa_interleaved_ll_800_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+	
+	return 0;
+}
+
+/*
+	Returns the subgraph of the symmetric `graph` containing the edges of batches `first` to `last`.
+	Edge (u, v) belongs to batch `(u + v) % (batches_count + 1)`, so both directions of an edge are in the
+	same batch and the subgraph is symmetric. The neighbour-lists remain sorted.
+*/
+struct ll_400_graph* get_batches_graph(struct ll_400_graph* graph, unsigned int batches_count, unsigned int first, unsigned int last)
+{
+	struct ll_400_graph* g = calloc(sizeof(struct ll_400_graph), 1);
+	assert(g != NULL);
+	g->vertices_count = graph->vertices_count;
+	g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+	assert(g->offsets_list != NULL);
+
+	// Counting edges of each vertex
+	g->offsets_list[0] = 0;
+	#pragma omp parallel for schedule(dynamic, 1024)
+	for(unsigned int v = 0; v < graph->vertices_count; v++)
+	{
+		unsigned long count = 0;
+		for(unsigned long e = graph->offsets_list[v]; e < graph->offsets_list[v + 1]; e++)
+		{
+			unsigned int b = (v + graph->edges_list[e]) % (batches_count + 1);
+			if(b >= first && b <= last)
+				count++;
+		}
+		g->offsets_list[v + 1] = count;
+	}
+
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+		g->offsets_list[v + 1] += g->offsets_list[v];
+	g->edges_count = g->offsets_list[g->vertices_count];
+
+	// Writing the edges
+	if(g->edges_count)
+	{
+		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+		assert(g->edges_list != NULL);
+
+		#pragma omp parallel for schedule(dynamic, 1024)
+		for(unsigned int v = 0; v < graph->vertices_count; v++)
+		{
+			unsigned long index = g->offsets_list[v];
+			for(unsigned long e = graph->offsets_list[v]; e < graph->offsets_list[v + 1]; e++)
+			{
+				unsigned int b = (v + graph->edges_list[e]) % (batches_count + 1);
+				if(b >= first && b <= last)
+					g->edges_list[index++] = graph->edges_list[e];
+			}
+		}
+	}
+
+	return g;
+}
+
+/*
+	Incremental CC: the edges of the symmetric `graph` are split into a base graph (batch 0) and `batches_count`
+	batches by `get_batches_graph()`. `cc_jt()` computes the components of the base graph and the batches are
+	applied by `cc_incremental_add_graph()` (odd batches, as delta graphs) and `cc_incremental_add_edges()`
+	(even batches, as arrays of vertex pairs). The last batch performs full pointer jumping, so the returned
+	labels can be read directly.
+
+	After each batch, `cc_incremental_find()` and the number of components are validated against `cc_jt()` on
+	the union of the base graph and the applied batches. As the roots of both are the minimum vertex IDs of
+	the components, the component ID of each vertex should be the same.
+
+	exec_info: if not NULL, [0] will have the total exec time of the base graph and the batches
 */
+unsigned int* cc_incremental_batches(struct par_env* pe, struct ll_400_graph* graph, unsigned int batches_count, unsigned int flags,
+	unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Base graph
+		struct ll_400_graph* base = get_batches_graph(graph, batches_count, 0, 0);
+		printf("Base graph: \t\t |V|: %'lu, |E|: %'lu, batches: %'u\n", base->vertices_count, base->edges_count, batches_count);
+
+		unsigned long batch_exec_info[20] = {0};
+		unsigned int ccs = 0;
+		unsigned int* cc = cc_jt(pe, base, flags, batch_exec_info, &ccs);
+		unsigned long total_time = batch_exec_info[0];
+		release_numa_interleaved_ll_400_graph(base);
+		base = NULL;
+
+	// Applying the batches
+		for(unsigned int b = 1; b <= batches_count; b++)
+		{
+			struct ll_400_graph* delta = get_batches_graph(graph, batches_count, b, b);
+			unsigned int batch_flags = flags | (b == batches_count ? 4U : 0U);
+
+			if(b % 2)
+				cc_incremental_add_graph(pe, cc, delta, batch_flags, batch_exec_info, &ccs);
+			else
+			{
+				// One direction of each edge is sufficient, self-edges are skipped
+				unsigned long edges_count = 0;
+				#pragma omp parallel for reduction(+:edges_count)
+				for(unsigned int v = 0; v < delta->vertices_count; v++)
+					for(unsigned long e = delta->offsets_list[v]; e < delta->offsets_list[v + 1]; e++)
+						if(v < delta->edges_list[e])
+							edges_count++;
+
+				unsigned int* edges = numa_alloc_interleaved(sizeof(unsigned int) * 2 * max(1UL, edges_count));
+				assert(edges != NULL);
+				unsigned long index = 0;
+				for(unsigned int v = 0; v < delta->vertices_count; v++)
+					for(unsigned long e = delta->offsets_list[v]; e < delta->offsets_list[v + 1]; e++)
+						if(v < delta->edges_list[e])
+						{
+							edges[2 * index] = v;
+							edges[2 * index + 1] = delta->edges_list[e];
+							index++;
+						}
+				assert(index == edges_count);
+
+				cc_incremental_add_edges(pe, cc, delta->vertices_count, edges, edges_count, batch_flags, batch_exec_info, &ccs);
+
+				numa_free(edges, sizeof(unsigned int) * 2 * max(1UL, edges_count));
+				edges = NULL;
+			}
+			total_time += batch_exec_info[0];
+			printf("Batch %'u, |E|: %'lu, merged components: %'lu\n", b, delta->edges_count, batch_exec_info[8]);
+
+			release_numa_interleaved_ll_400_graph(delta);
+			delta = NULL;
+
+			// Validating against cc_jt() on the union
+			struct ll_400_graph* union_graph = get_batches_graph(graph, batches_count, 0, b);
+			unsigned int ccs_u = 0;
+			unsigned int* cc_u = cc_jt(pe, union_graph, 2U, NULL, &ccs_u);
+
+			unsigned long errors = 0;
+			#pragma omp parallel for reduction(+:errors)
+			for(unsigned int v = 0; v < union_graph->vertices_count; v++)
+				if(cc_incremental_find(cc, v) != cc_u[v])
+					errors++;
+
+			if(errors == 0 && ccs == ccs_u)
+				printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+			else
+				printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors, |CCs|: %'u, cc_jt |CCs|: %'u\n", errors, ccs, ccs_u);
+			assert(errors == 0 && ccs == ccs_u);
+
+			cc_release(union_graph, cc_u);
+			cc_u = NULL;
+			release_numa_interleaved_ll_400_graph(union_graph);
+			union_graph = NULL;
+		}
+
+	// Finalizing
+		printf("Total exec. time of base graph and batches: \t %'.1f (ms)\n\n", total_time / 1e6);
+		if(exec_info)
+			exec_info[0] = total_time;
+		if(ccs_p)
+			*ccs_p = ccs;
+
+	return cc;
+}
 
 int main(int argc, char** args)
 {	
@@ -30,16 +296,41 @@ int main(int argc, char** args)
 		read_env_vars();
 		printf("\n");
 
+		unsigned int cc_algorithm = 0;
+		if(argc > 1)
+			cc_algorithm = atoi(args[1]);
+		assert(cc_algorithm <= 3);
+		unsigned int batches_count = 4;
+		if(argc > 2)
+			batches_count = max(1, atoi(args[2]));
+
+	// Graphs with |V| >= 2^32 require 8 Bytes vertex IDs
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+		{
+			unsigned long vertices_count = get_webgraph_vertices_count(LL_INPUT_GRAPH_PATH);
+			if(vertices_count != -1UL && vertices_count >= (1UL << 32))
+			{
+				assert(cc_algorithm == 0 && "Only Thrifty supports 8 Bytes vertex IDs.");
+				return thrifty_800();
+			}
+		}
+
 	// Reading the grpah
 		struct ll_400_graph* graph = NULL;
 		int read_flags = 0;
 		
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that do not require omp 
+			// Reading the textual graph
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(LL_STREAM_INPUT_GRAPH)
+			// Streaming a WebGraph: the first pass of the algorithm is overlapped with loading the edges
+			read_flags |= 4U;
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		assert(graph != NULL);
 		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
 
@@ -48,7 +339,7 @@ int main(int argc, char** args)
 
 	// Store graph in shm
 		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
-			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 		
 	// Exec info
 		unsigned long* exec_info = calloc(sizeof(unsigned long), 32);
@@ -69,14 +360,94 @@ int main(int argc, char** args)
 		}		
 		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
 
+	// Thrifty on the compressed graph
+		if(LL_COMPRESS_INPUT_GRAPH)
+		{
+			ll_400_stream_finish(graph);
+
+			// The encoder requires sorted neighbour-lists, symmetrize_graph() has sorted them for the non-symmetric inputs
+				if(LL_INPUT_GRAPH_IS_SYMMETRIC)
+				{
+					if(read_flags & 1U<<31)
+					{
+						// The graph mapped from shm is read-only
+						struct ll_400_graph* copy = copy_ll_400_graph(pe, graph, NULL);
+						release_shm_ll_400_graph(graph);
+						graph = copy;
+						copy = NULL;
+						read_flags &= ~(1U<<31);
+					}
+					sort_neighbor_lists(pe, graph);
+				}
+
+			struct ll_c400_graph* c_graph = compress_ll_400_graph(pe, graph, 1U | 2U);  // print stats and validate
+
+			// Releasing the uncompressed graph
+				if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+					release_shm_ll_400_graph(graph);
+				else
+					release_numa_interleaved_ll_400_graph(graph);
+				graph = NULL;
+
+			assert(cc_algorithm <= 1 && "Afforest and the incremental CC are not implemented for compressed graphs.");
+			unsigned int ccs_t = 0;
+			unsigned int* cc_t = NULL;
+			if(cc_algorithm == 0)
+				cc_t = cc_thrifty_c400(pe, c_graph, 1U, &exec_info[10], &ccs_t);
+			else
+				cc_t = cc_jt_c400(pe, c_graph, 1U, &exec_info[10], &ccs_t);
+
+			assert(cc_validate_c400(pe, c_graph, cc_t, ccs_t));
+
+			write_report(pe, c_graph->vertices_count, c_graph->edges_count, exec_info);
+
+			cc_release_c400(c_graph, cc_t);
+			cc_t = NULL;
+			release_ll_c400_graph(c_graph);
+			c_graph = NULL;
+
+			free(exec_info);
+			exec_info = NULL;
+
+			printf("\n\n");
+			return 0;
+		}
+
+	// Using 4 Bytes offsets for Thrifty if |E| < 2^32, unless the graph is being streamed or is mapped from shm
+		struct ll_400s_graph* s_graph = NULL;
+		unsigned long vertices_count = graph->vertices_count;
+		unsigned long edges_count = graph->edges_count;
+		if(cc_algorithm == 0 && edges_count < (1UL << 32) && !ll_400_stream_is_active(graph) && !(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31)))
+		{
+			s_graph = compact_ll_400_graph(graph, 0);
+			graph = NULL;
+		}
+
 	// CC
 		unsigned int flags = 1U;  // 1U print stats
 		unsigned int ccs_t = 0;
-		unsigned int* cc_t = cc_thrifty_400(pe, graph, flags, &exec_info[10], &ccs_t);
+		unsigned int* cc_t = NULL;
+		if(s_graph)
+			cc_t = cc_thrifty_400s(pe, s_graph, flags, &exec_info[10], &ccs_t);
+		else if(cc_algorithm == 0)
+		{
+			cc_t = cc_thrifty_400(pe, graph, flags, &exec_info[10], &ccs_t);
+			ll_400_stream_finish(graph);
+		}
+		else
+		{
+			ll_400_stream_finish(graph);
+			if(cc_algorithm == 1)
+				cc_t = cc_jt(pe, graph, flags, &exec_info[10], &ccs_t);
+			else if(cc_algorithm == 2)
+				cc_t = cc_afforest(pe, graph, flags, &exec_info[10], &ccs_t);
+			else
+				cc_t = cc_incremental_batches(pe, graph, batches_count, flags, &exec_info[10], &ccs_t);
+		}
 		unsigned int max_degree_ID  = exec_info[10 + 9];
 		
-	// Validating
-		if(0)
+	// Validating (requires the ll_400_graph)
+		if(0 && graph != NULL)
 		{
 			unsigned int ccs_p = 0;
 			unsigned int* cc_p = cc_pull(pe, graph, flags, exec_info, &ccs_p);
@@ -111,47 +482,20 @@ int main(int argc, char** args)
 		}
 
 	// Writing to the report
-		if(LL_OUTPUT_REPORT_PATH != NULL)
-		{
-			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
-			if(out != NULL)
-			{
-				if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
-				{
-					fprintf(out, "%-20s; %-8s; %-8s; %-13s;", "Dataset", "|V|", "|E|", "Time (ms)");
-					if(exec_info)
-						for(unsigned int i=0; i<pe->hw_events_count; i++)
-							fprintf(out, " %-8s;", pe->hw_events_names[i]);
-					fprintf(out, "\n");
-				}
+		write_report(pe, vertices_count, edges_count, exec_info);
 
-				char temp1 [16];
-				char temp2 [16];			
-				char* name = strrchr(LL_INPUT_GRAPH_PATH, '/');
-				if(name == NULL)
-					name = LL_INPUT_GRAPH_PATH;
-				else
-					name++;
-				if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
-					name = strndup(name, strrchr(name, '.') - name);
-				
-				fprintf(out, "%-20s; %'8s; %'8s; %'13.1f;", 
-					name, ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), exec_info[10 + 0] / 1e6);
-				if(exec_info)
-					for(unsigned int i=0; i<pe->hw_events_count; i++)					
-						fprintf(out, " %'8s;", ul2s(exec_info[10 + i + 1], temp1));
-				fprintf(out, "\n");
-
-				if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
-					free(name);
-				name = NULL;
+	// Releasing memory
+		if(s_graph)
+		{
+			cc_release_400s(s_graph, cc_t);
+			cc_t = NULL;
+			release_numa_interleaved_ll_400s_graph(s_graph);
+			s_graph = NULL;
 
-				fclose(out);
-				out = NULL;
-			}
+			printf("\n\n");
+			return 0;
 		}
 
-	// Releasing memory
 		cc_release(graph, cc_t);
 		cc_t = NULL;
 		
@@ -40,11 +40,14 @@ int main(int argc, char** args)
 		int read_flags = 0;
 		
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that do not require omp 
+			// Reading the textual graph
 			csr_graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			csr_graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			csr_graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_404_AP"))	
 			wgraph = get_ll_404_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
 		assert(csr_graph != NULL || wgraph != NULL);
@@ -56,9 +59,9 @@ int main(int argc, char** args)
 		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
 		{
 			if(csr_graph != NULL)
-				store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 0);
+				store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 			else
-				store_shm_ll_404_graph(pe, LL_INPUT_GRAPH_PATH, wgraph, 0);
+				store_shm_ll_404_graph(pe, LL_INPUT_GRAPH_PATH, wgraph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 		}
 		
 	// Initializing exec info
@@ -183,7 +186,7 @@ int main(int argc, char** args)
 		if(sym_graph != NULL)
 		{
 			if(
-				(strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") == 0 || strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP") == 0) 
+				(strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") == 0 || strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP") == 0 || strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN") == 0) 
 				&& LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31) == 1
 			)
 				release_shm_ll_400_graph(sym_graph);
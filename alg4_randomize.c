@@ -202,11 +202,14 @@ int main(int argc, char** args)
 		int read_flags = 0;
 		unsigned long load_time = - get_nano_time();
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that does not require omp 
+			// Reading the textual graph
 			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		assert(graph != NULL);
 		load_time += get_nano_time();
 		
@@ -215,7 +218,7 @@ int main(int argc, char** args)
 
 	// Store graph in shm
 		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
-			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 0);
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 	
 		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,graph->vertices_count,graph->edges_count);
 
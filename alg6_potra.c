@@ -19,6 +19,16 @@ int main(int argc, char** args)
 			if(strcmp(LL_INPUT_GRAPH_TYPE,"text") == 0)
 				graph_name = strndup(graph_name, strrchr(graph_name, '.') - graph_name);
 		}
+
+		// args[1]: processing method, 0: MSP (default), 1: HLH, 2: Atomic, 3: Blocked
+		unsigned int method_flags = 0;
+		if(argc > 1)
+		{
+			unsigned int method = atoi(args[1]);
+			assert(method <= 3);
+			if(method != 0)
+				method_flags = 1U << (3 + method);
+		}
 		printf("\n");
 		
 	// Loading the graph
@@ -26,11 +36,14 @@ int main(int argc, char** args)
 		unsigned long load_time = - get_nano_time();
 		struct ll_400_graph* csr_graph = NULL;
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
-			// Reading the textual graph that does not require omp 
+			// Reading the textual graph
 			csr_graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
 			// Reading a WebGraph using ParaGrapher library
 			csr_graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			csr_graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
 		assert(csr_graph != NULL);
 		load_time += get_nano_time();
 
@@ -44,7 +57,7 @@ int main(int argc, char** args)
 
 	// Store graph in shm
 		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
-			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 0);
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, csr_graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
 		if(read_flags & (1U << 31))
 		{
 			unsigned long mt = - get_nano_time();
@@ -109,6 +122,7 @@ int main(int argc, char** args)
 			unsigned int flags = 0;
 			if(graph->edges_count < 3e9)
 				flags |= 3U; // 1U: Validation + 2U: Sort
+			flags |= method_flags;
 
 			struct ll_400_graph* out_graph = potra(pe, graph, flags, exec_info + 40 * m);
 			
@@ -0,0 +1,196 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+#include "ihtl.c"
+
+/*
+	In-Hub Temporal Locality (iHTL) SpMV
+
+	https://doi.org/10.1145/3472456.3472462
+
+	The driver runs `iterations` SpMV iterations in pull direction and using iHTL, validates the iHTL result
+	against the pull result, and compares PageRank using both traversals. The PageRank result of the pull
+	traversal is also validated against `pagerank()` (pagerank.c).
+
+	args[1]: number of iterations, default: 10
+*/
+
+// Returns 1 if `a` and `b` are equal with a relative error of 1e-9
+int spmv_validate(struct par_env* pe, double* a, double* b, unsigned long count)
+{
+	unsigned long errors = 0;
+	#pragma omp parallel for reduction(+:errors)
+	for(unsigned long v = 0; v < count; v++)
+	{
+		double diff = fabs(a[v] - b[v]);
+		if(diff > 1e-9 * max(1.0, fabs(a[v])))
+			errors++;
+	}
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors\n", errors);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	return errors == 0;
+}
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+		unsigned int iterations = 10;
+		if(argc > 1)
+			iterations = max(1, atoi(args[1]));
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(LL_STREAM_INPUT_GRAPH)
+			// Streaming a WebGraph: the first pass of the algorithm is overlapped with loading the edges
+			read_flags |= 4U;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 40);
+		assert(exec_info != NULL);
+
+	// Transposing the input CSR graph
+		struct ll_400_graph* csr_graph = graph;
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csr_graph->vertices_count,csr_graph->edges_count);
+
+		struct ll_400_graph* csc_graph = atomic_transpose(pe, csr_graph, 0);
+		ll_400_stream_finish(csr_graph);
+		printf("CSC: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH,csc_graph->vertices_count,csc_graph->edges_count);
+
+	// Building iHTL blocks
+		struct ihtl_graph* ig = ihtl_build(pe, csc_graph, 1U, &exec_info[0]);
+
+	// Allocating memory
+		unsigned long vc = csr_graph->vertices_count;
+		double* x = numa_alloc_interleaved(sizeof(double) * vc);
+		double* y_pull = numa_alloc_interleaved(sizeof(double) * vc);
+		double* y_ihtl = numa_alloc_interleaved(sizeof(double) * vc);
+		assert(x != NULL && y_pull != NULL && y_ihtl != NULL);
+
+		#pragma omp parallel for
+		for(unsigned long v = 0; v < vc; v++)
+			x[v] = 1.0 / (1 + v % 13);
+
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(csc_graph, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// SpMV iterations in pull direction
+		printf("\n\033[3;31mSpMV, pull\033[0;37m\n");
+		unsigned long mt = - get_nano_time();
+		for(unsigned int i = 0; i < iterations; i++)
+			spmv_pull(pe, csc_graph, partitions, dp, x, y_pull);
+		mt += get_nano_time();
+		exec_info[1] = mt / iterations;
+		printf("Avg. iteration time: \t\t %'.2f (ms)\n", exec_info[1] / 1e6);
+
+	// SpMV iterations using iHTL
+		printf("\n\033[3;31mSpMV, iHTL\033[0;37m\n");
+		ihtl_spmv(pe, ig, x, y_ihtl, 1U);
+		mt = - get_nano_time();
+		for(unsigned int i = 0; i < iterations; i++)
+			ihtl_spmv(pe, ig, x, y_ihtl, 0);
+		mt += get_nano_time();
+		exec_info[2] = mt / iterations;
+		printf("Avg. iteration time: \t\t %'.2f (ms)\n", exec_info[2] / 1e6);
+		printf("Speedup: \t\t\t %.2f\n", 1.0 * exec_info[1] / max(1, exec_info[2]));
+
+	// Validating SpMV
+		assert(spmv_validate(pe, y_pull, y_ihtl, vc));
+
+	// PageRank
+		double* rank_pull = spmv_pagerank(pe, csr_graph, csc_graph, NULL, iterations, 1U, &exec_info[10]);
+		double* rank_ihtl = spmv_pagerank(pe, csr_graph, NULL, ig, iterations, 1U, &exec_info[20]);
+		assert(spmv_validate(pe, rank_pull, rank_ihtl, vc));
+
+		double* rank_ref = pagerank(pe, csr_graph, csc_graph, LL_PR_PULL, iterations, 0, NULL);
+		assert(pagerank_validate(pe, vc, rank_ref, rank_pull));
+		pagerank_release(vc, rank_ref);
+		rank_ref = NULL;
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+				fprintf(out, "%-20s; %-8s; %-8s; %-10s; %-8s; %-12s; %-12s; %-12s; %-12s;\n", "Dataset", "|V|", "|E|",
+					"Build(ms)", "#FBlocks", "Pull(ms)", "iHTL(ms)", "PR Pull(ms)", "PR iHTL(ms)");
+
+			char temp1 [16];
+			char temp2 [16];
+			fprintf(out, "%-20s; %8s; %8s; %'10.1f; %8u; %'12.2f; %'12.2f; %'12.1f; %'12.1f;\n", LL_INPUT_GRAPH_BASE_NAME,
+				ul2s(csr_graph->vertices_count, temp1), ul2s(csr_graph->edges_count, temp2), exec_info[0] / 1e6,
+				ig->flipped_blocks_count, exec_info[1] / 1e6, exec_info[2] / 1e6, exec_info[10] / 1e6, exec_info[20] / 1e6);
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		numa_free(rank_pull, sizeof(double) * vc);
+		rank_pull = NULL;
+		numa_free(rank_ihtl, sizeof(double) * vc);
+		rank_ihtl = NULL;
+		numa_free(x, sizeof(double) * vc);
+		x = NULL;
+		numa_free(y_pull, sizeof(double) * vc);
+		y_pull = NULL;
+		numa_free(y_ihtl, sizeof(double) * vc);
+		y_ihtl = NULL;
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+		ihtl_release(ig);
+		ig = NULL;
+
+		release_numa_interleaved_ll_400_graph(csc_graph);
+		csc_graph = NULL;
+
+		if(read_flags & 1U<<31)
+			release_shm_ll_400_graph(csr_graph);
+		else
+			release_numa_interleaved_ll_400_graph(csr_graph);
+		csr_graph = NULL;
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
@@ -0,0 +1,126 @@
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+#include "lotus.c"
+
+/*
+	LOTUS: Locality Optimizing Triangle Counting
+
+	https://doi.org/10.1145/3503221.3508402
+
+	The driver symmetrizes the input graph (if it is not symmetric), counts triangles using LOTUS and
+	validates the result against the merge-based triangle counting.
+*/
+
+int main(int argc, char** args)
+{
+	// Locale initialization
+		setlocale(LC_NUMERIC, "");
+		setbuf(stdout, NULL);
+		setbuf(stderr, NULL);
+		read_env_vars();
+		printf("\n");
+
+	// Reading the grpah
+		struct ll_400_graph* graph = NULL;
+		int read_flags = 0;
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"text"))
+			// Reading the textual graph
+			graph = get_ll_400_txt_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_400_AP") || !strcmp(LL_INPUT_GRAPH_TYPE,"PARAGRAPHER_CSX_WG_800_AP"))
+			// Reading a WebGraph using ParaGrapher library
+			graph = get_ll_400_webgraph(LL_INPUT_GRAPH_PATH, LL_INPUT_GRAPH_TYPE, &read_flags);
+		if(!strcmp(LL_INPUT_GRAPH_TYPE,"COMPBIN"))
+			// Reading a graph in CompBin format
+			graph = get_ll_400_compbin_graph(LL_INPUT_GRAPH_PATH, &read_flags);
+		assert(graph != NULL);
+		printf("CSR: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n", LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// Initializing omp
+		struct par_env* pe= initialize_omp_par_env();
+
+	// Store graph in shm
+		if(LL_STORE_INPUT_GRAPH_IN_SHM && (read_flags & 1U<<31) == 0)
+			store_shm_ll_400_graph(pe, LL_INPUT_GRAPH_PATH, graph, 2U * LL_INPUT_GRAPH_IS_SYMMETRIC);
+
+	// Exec info
+		unsigned long* exec_info = calloc(sizeof(unsigned long), 32);
+		assert(exec_info != NULL);
+
+	// Symmetrizing the graph
+		if(!LL_INPUT_GRAPH_IS_SYMMETRIC)
+		{
+			struct ll_400_graph* sym_graph = symmetrize_graph(pe, graph,  2U + 4U); // sort neighbour-lists and remove self-edges
+
+			// Releasing the input graph
+				if(read_flags & 1U<<31)
+					release_shm_ll_400_graph(graph);
+				else
+					release_numa_interleaved_ll_400_graph(graph);
+				graph = sym_graph;
+				sym_graph = NULL;
+		}
+		printf("SYM: %-30s;\t |V|: %'20lu;\t |E|:%'20lu;\n",LL_INPUT_GRAPH_PATH, graph->vertices_count, graph->edges_count);
+
+	// LOTUS
+		unsigned long triangles = lotus(pe, graph, 1U, exec_info);
+
+	// Validating
+		unsigned long triangles_m = tc_merge(pe, graph);
+		if(triangles == triangles_m)
+			printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+		else
+			printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, LOTUS: %'lu, Merge: %'lu\n", triangles, triangles_m);
+		assert(triangles == triangles_m);
+
+	// Printing per-phase times
+		printf("\nLOTUS phases:\n");
+		printf("  Relabelling:            \t\t %'10.1f (ms)\n", exec_info[12] / 1e6);
+		printf("  Creating data structures:\t\t %'10.1f (ms)\n", exec_info[13] / 1e6);
+		printf("  HHH & HHN:              \t\t %'10.1f (ms)\n", exec_info[14] / 1e6);
+		printf("  HNN & NNN:              \t\t %'10.1f (ms)\n", exec_info[15] / 1e6);
+
+	// Writing to the report
+		if(LL_OUTPUT_REPORT_PATH != NULL)
+		{
+			FILE* out = fopen(LL_OUTPUT_REPORT_PATH, "a");
+			assert(out != NULL);
+
+			if(LL_INPUT_GRAPH_BATCH_ORDER == 0)
+			{
+				fprintf(out, "%-20s; %-8s; %-8s; %-12s; %-8s; %-10s; %-10s; %-10s; %-10s; %-10s;", "Dataset", "|V|", "|E|",
+					"Triangles", "Hubs", "Total(ms)", "Relab(ms)", "Build(ms)", "HH*(ms)", "*NN(ms)");
+				for(unsigned int i = 0; i < pe->hw_events_count; i++)
+					fprintf(out, " %-15s;", pe->hw_events_names[i]);
+				fprintf(out, "\n");
+			}
+
+			char temp1 [16];
+			char temp2 [16];
+			char temp3 [16];
+			fprintf(out, "%-20s; %8s; %8s; %12s; %8lu; %'10.1f; %'10.1f; %'10.1f; %'10.1f; %'10.1f;", LL_INPUT_GRAPH_BASE_NAME,
+				ul2s(graph->vertices_count, temp1), ul2s(graph->edges_count, temp2), ul2s(triangles, temp3), exec_info[16],
+				exec_info[0] / 1e6, exec_info[12] / 1e6, exec_info[13] / 1e6, exec_info[14] / 1e6, exec_info[15] / 1e6);
+			for(unsigned int i = 0; i < pe->hw_events_count; i++)
+				fprintf(out, " %15s;", ul2s(exec_info[1 + i], temp1));
+			fprintf(out, "\n");
+
+			fclose(out);
+			out = NULL;
+		}
+
+	// Releasing memory
+		if(LL_INPUT_GRAPH_IS_SYMMETRIC && (read_flags & 1U<<31))
+			release_shm_ll_400_graph(graph);
+		else
+			release_numa_interleaved_ll_400_graph(graph);
+		graph = NULL;
+
+		free(exec_info);
+		exec_info = NULL;
+
+	printf("\n\n");
+
+	return 0;
+}
@@ -29,6 +29,7 @@
 #include <sys/stat.h>
 #include <sys/sysinfo.h>
 #include <sys/resource.h>
+#include <limits.h>
 
 #define max(a,b)             \
 ({                           \
@@ -50,6 +51,9 @@ char LL_INPUT_GRAPH_BASE_NAME [256] = {0};
 unsigned int LL_INPUT_GRAPH_BATCH_ORDER = 0;
 unsigned int LL_INPUT_GRAPH_IS_SYMMETRIC = 0;
 unsigned int LL_STORE_INPUT_GRAPH_IN_SHM = 0;
+unsigned int LL_SHM_HUGE_PAGES = 0;
+unsigned int LL_STREAM_INPUT_GRAPH = 0;
+unsigned int LL_COMPRESS_INPUT_GRAPH = 0;
 char* LL_OUTPUT_REPORT_PATH = NULL;
 char* LL_GRAPH_RA_BIN_FOLDER = "data/RA_bin_arrays";
 
@@ -87,6 +91,14 @@ void read_env_vars()
 			bn_len = min(bn_len - strlen(".properties"), 256);
 			sprintf(LL_INPUT_GRAPH_BASE_NAME, "%.*s", bn_len, bn);
 		}
+		else if(strcmp(LL_INPUT_GRAPH_TYPE, "COMPBIN") == 0)
+		{
+			sprintf(temp, "%s_props.txt", LL_INPUT_GRAPH_PATH);
+			char* bn = basename(temp);
+			int bn_len = strlen(bn);
+			bn_len = min(bn_len - strlen("_props.txt"), 256);
+			sprintf(LL_INPUT_GRAPH_BASE_NAME, "%.*s", bn_len, bn);
+		}
 
 		free(temp);
 		temp = NULL;
@@ -104,6 +116,18 @@ void read_env_vars()
 	if(temp != NULL && strcmp(temp, "1") == 0)
 		LL_STORE_INPUT_GRAPH_IN_SHM = 1;
 
+	temp = getenv("LL_SHM_HUGE_PAGES");
+	if(temp != NULL && strcmp(temp, "1") == 0)
+		LL_SHM_HUGE_PAGES = 1;
+
+	temp = getenv("LL_STREAM_INPUT_GRAPH");
+	if(temp != NULL && strcmp(temp, "1") == 0)
+		LL_STREAM_INPUT_GRAPH = 1;
+
+	temp = getenv("LL_COMPRESS_INPUT_GRAPH");
+	if(temp != NULL && strcmp(temp, "1") == 0)
+		LL_COMPRESS_INPUT_GRAPH = 1;
+
 	temp = getenv("LL_OUTPUT_REPORT_PATH");
 	if(temp != NULL && strlen(temp) > 0)
 		LL_OUTPUT_REPORT_PATH = strdup(temp);
@@ -119,6 +143,9 @@ void read_env_vars()
 	printf("    LL_INPUT_GRAPH_BATCH_ORDER:  %u\n", LL_INPUT_GRAPH_BATCH_ORDER);
 	printf("    LL_INPUT_GRAPH_IS_SYMMETRIC: %u\n", LL_INPUT_GRAPH_IS_SYMMETRIC);
 	printf("    LL_STORE_INPUT_GRAPH_IN_SHM: %u\n", LL_STORE_INPUT_GRAPH_IN_SHM);
+	printf("    LL_SHM_HUGE_PAGES:           %u\n", LL_SHM_HUGE_PAGES);
+	printf("    LL_STREAM_INPUT_GRAPH:       %u\n", LL_STREAM_INPUT_GRAPH);
+	printf("    LL_COMPRESS_INPUT_GRAPH:     %u\n", LL_COMPRESS_INPUT_GRAPH);
 	printf("    LL_OUTPUT_REPORT_PATH:       %s\n", LL_OUTPUT_REPORT_PATH);
 	printf("    LL_GRAPH_RA_BIN_FOLDER:      %s\n", LL_GRAPH_RA_BIN_FOLDER);
 	
@@ -276,6 +303,71 @@ void quick_sort_ushort(unsigned short* bucket, unsigned long start, unsigned lon
 	return;
 }
 
+void quick_sort_ulong(unsigned long* bucket, unsigned long start, unsigned long end)
+{
+	if(end - start < 16)
+	{
+		do{
+			unsigned long new_end = start;
+
+			for(unsigned long i=start+1; i<=end; i++)	
+				if(bucket[i-1] > bucket[i])
+				{
+					unsigned long t=bucket[i];
+					bucket[i]=bucket[i-1];
+					bucket[i-1]=t;
+
+					new_end = i;
+				}
+
+			end = new_end;
+		}
+		while(end > start);
+
+		return;
+	}
+
+	// moving the middle index to the end to suffle for semi-sorted arrays
+	unsigned long t=bucket[(end+start)/2];
+	bucket[(end+start)/2] = bucket[end];
+	bucket[end] = t;
+
+	unsigned long pivot_index=end;
+	unsigned long front_index=start;
+
+	unsigned long bp;
+	unsigned long p=bucket[pivot_index];
+	unsigned long f;
+
+	while(pivot_index > front_index)
+	{
+		//printf("%2d %2d ** \t",pivot_index, front_index);
+		if(bucket[front_index] >= p)
+		{
+			bp=bucket[pivot_index-1];
+			f=bucket[front_index];
+
+			bucket[pivot_index]=f;
+			bucket[front_index]=bp;
+
+			pivot_index--;
+			
+		}
+		else
+			front_index++;
+	}
+
+	bucket[pivot_index]=p;
+
+	if(pivot_index > start + 1)
+		quick_sort_ulong(bucket, start, pivot_index-1);
+
+	if(pivot_index < end - 1)
+		quick_sort_ulong(bucket, pivot_index+1, end);
+
+	return;
+}
+
 char* get_date_time(char* in)
 {
 	time_t t0 = time(NULL);
@@ -397,6 +489,54 @@ unsigned long uint_binary_search(unsigned int* vals, unsigned long in_start, uns
 	return -1UL;
 }
 
+// Binary Search for `val` in [`start`, `end`) of `vals` as a sorted array  
+// returns -1UL if it cannot find
+// otherwise, returns index of the element that is equal to val
+unsigned long ulong_binary_search(unsigned long* vals, unsigned long in_start, unsigned long in_end, unsigned long val)
+{
+	unsigned long end = in_end;
+	unsigned long start = in_start;
+	assert(start <= end);
+	if(start == end)
+		return -1UL;
+
+	if(vals[start] > val) 
+		return -1UL;
+
+	if(vals[end - 1] < val)
+		return -1UL; 
+
+	unsigned long m = (start + end)/2;
+	unsigned int r = 0;
+	unsigned int r_max = 1 + log2(end + 1 - start);
+	while(1)
+	{
+		unsigned long m_val = vals[m];
+		if( m_val == val )
+			return m;
+
+		if(m + 1 < in_end)
+		{
+			if(vals[m+1] == val)
+				return m+1;
+
+			if(m_val < val && vals[m + 1] > val)
+				return -1UL;
+		}
+
+		if(m_val > val)
+			end = m;
+		if(m_val < val)
+			start = m;
+		m = (start + end)/2;
+
+		assert(r++ <= r_max);
+	}
+
+	assert("Don't reach here.");
+	return -1UL;
+}
+
 void flush_os_cache()
 {
 	char* ts = calloc(1024 + get_nprocs()/4, 1);
@@ -414,6 +554,28 @@ void flush_os_cache()
 	return;
 }
 
+/*
+	Blocks the calling thread while `*addr == val`, or until `timeout` (if not NULL) expires.
+	Returns 0 if woken up or if `*addr != val` and -1 on timeout.
+*/
+int futex_wait(unsigned int* addr, unsigned int val, struct timespec* timeout)
+{
+	long ret = syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeout, NULL, 0);
+	if(ret == -1 && errno == ETIMEDOUT)
+		return -1;
+
+	assert(ret == 0 || errno == EAGAIN || errno == EINTR);
+	return 0;
+}
+
+void futex_wake_all(unsigned int* addr)
+{
+	long ret = syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+	assert(ret >= 0);
+
+	return;
+}
+
 void* create_shm(char* shm_file_name, unsigned long length)
 {
 	assert(shm_file_name != NULL);
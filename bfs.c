@@ -0,0 +1,396 @@
+#ifndef __BFS_C
+#define __BFS_C
+
+// This file contains the implementation of the Breadth-First Search
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+
+/*
+	Direction-Optimizing BFS
+
+	https://doi.org/10.1109/SC.2012.50
+
+	Each level is processed either in push direction (top-down) using a sparse frontier, or in
+	pull direction (bottom-up) using a bitmap frontier:
+		- Push: the worklist of the vertices of the current level is traversed on `csr` and unvisited
+		  neighbours are claimed using CAS and added to the next worklist.
+		- Pull: each unvisited vertex scans its in-neighbours on `csc` and stops at the first neighbour
+		  that is in the frontier bitmap.
+
+	Similar to Thrifty, the density of the next frontier is `(next_vertices + next_edges) / |E|`, where
+	`next_edges` is the sum of out-degrees of the vertices of the next frontier. The traversal switches to the
+	pull direction when the density exceeds `LL_BFS_PULL_DENSITY` and returns to the push direction when the
+	density falls below `LL_BFS_PUSH_DENSITY`.
+
+	The worklists are shared SPF arrays between threads, as in Thrifty, and each thread reserves chunks of
+	`waspr` elements of them.
+
+	csr, csc:
+		The graph and its transpose. For symmetric graphs, both can point to the same graph.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of levels
+		[9]: number of visited vertices
+		[10]: number of push levels
+		[11]: number of pull levels
+
+	Returns the array of levels, with -1U for unreachable vertices
+*/
+
+#define LL_BFS_PULL_DENSITY 0.05
+#define LL_BFS_PUSH_DENSITY 0.01
+
+// Adds `v` to a shared worklist and reserves a new chunk when the current chunk of the thread is full
+static inline void __bfs_worklist_add(unsigned int* worklist, unsigned int* worklist_length, unsigned long worklist_size,
+	unsigned int waspr, unsigned int* index, unsigned int* end, unsigned int v)
+{
+	worklist[(*index)++] = v;
+	if(*index == *end)
+	{
+		// grab a new chunk
+		do
+		{
+			*index = *worklist_length;
+			*end = *index + waspr;
+		}while(__sync_val_compare_and_swap(worklist_length, *index, *end) != *index);
+		assert(*worklist_length <= worklist_size);
+	}
+
+	return;
+}
+
+unsigned int* bfs_do(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, unsigned int root, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && csr != NULL && csc != NULL && csr->vertices_count == csc->vertices_count);
+		assert(root < csr->vertices_count);
+		unsigned long t0 = - get_nano_time();
+		if(flags & 1U)
+			printf("\n\033[3;31mbfs_do\033[0;37m, root: %'u, using \033[3;31m%d\033[0;37m threads.\n", root, pe->threads_count);
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned long vc = csr->vertices_count;
+		unsigned int* levels = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		assert(levels != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < vc; v++)
+			levels[v] = -1U;
+
+		unsigned long bitmap_words = (vc + 63) / 64;
+		unsigned long* bitmap = numa_alloc_interleaved(sizeof(unsigned long) * bitmap_words);
+		unsigned long* next_bitmap = numa_alloc_interleaved(sizeof(unsigned long) * bitmap_words);
+		assert(bitmap != NULL && next_bitmap != NULL);
+
+		unsigned int waspr = 16;  // worklist_allocation_size_per_request
+		unsigned long worklist_size = vc + 3 * waspr * pe->threads_count;
+		unsigned int* worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+		unsigned int* next_worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+		assert(worklist != NULL && next_worklist != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning of the CSC for pull levels
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(csc, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Initial frontier
+		levels[root] = 0;
+		for(unsigned int t = 0; t < pe->threads_count * waspr; t++)
+			worklist[t] = -1U;
+		worklist[0] = root;
+		unsigned int worklist_length = waspr * pe->threads_count;
+		unsigned int direction = 0;  // 0: push with worklist, 1: pull with bitmap
+
+	// Levels
+		unsigned int level = 0;
+		unsigned long visited = 1;
+		unsigned int push_levels = 0;
+		unsigned int pull_levels = 0;
+		unsigned int next_vertices = 0;
+		do
+		{
+			unsigned long mt = - get_nano_time();
+			unsigned long next_edges = 0;
+			next_vertices = 0;
+
+			if(direction == 0)
+			{
+				// Push level
+				unsigned int next_worklist_length = waspr * pe->threads_count;
+
+				#pragma omp parallel reduction(+:next_edges, next_vertices)
+				{
+					unsigned tid = omp_get_thread_num();
+					ttimes[tid] = - get_nano_time();
+					unsigned int index = tid * waspr;
+					unsigned int end = (tid + 1) * waspr;
+
+					#pragma omp for schedule(dynamic, 64) nowait
+					for(unsigned int i = 0; i < worklist_length; i++)
+					{
+						unsigned int v = worklist[i];
+						if(v == -1U)
+							continue;
+
+						for(unsigned long e = csr->offsets_list[v]; e < csr->offsets_list[v + 1]; e++)
+						{
+							unsigned int u = csr->edges_list[e];
+							if(levels[u] != -1U)
+								continue;
+							if(!__sync_bool_compare_and_swap(&levels[u], -1U, level + 1))
+								continue;
+
+							next_vertices++;
+							next_edges += csr->offsets_list[u + 1] - csr->offsets_list[u];
+							__bfs_worklist_add(next_worklist, &next_worklist_length, worklist_size, waspr, &index, &end, u);
+						}
+					}
+
+					// fill unused indecis with -1 to prevent from being processed in the next level
+					while(index < end)
+						next_worklist[index++] = -1U;
+
+					ttimes[tid] += get_nano_time();
+				}
+				push_levels++;
+
+				// swapping
+				{
+					unsigned int* temp = worklist;
+					worklist = next_worklist;
+					next_worklist = temp;
+					worklist_length = next_worklist_length;
+				}
+			}
+			else
+			{
+				// Pull level
+				#pragma omp parallel for
+				for(unsigned long w = 0; w < bitmap_words; w++)
+					next_bitmap[w] = 0;
+
+				#pragma omp parallel reduction(+:next_edges, next_vertices)
+				{
+					unsigned tid = omp_get_thread_num();
+					ttimes[tid] = - get_nano_time();
+					unsigned int partition = -1U;
+
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+
+						for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+						{
+							if(levels[v] != -1U)
+								continue;
+
+							for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+							{
+								unsigned int u = csc->edges_list[e];
+								if(bitmap[u >> 6] & (1UL << (u & 63)))
+								{
+									levels[v] = level + 1;
+									__atomic_fetch_or(&next_bitmap[v >> 6], 1UL << (v & 63), __ATOMIC_RELAXED);
+									next_vertices++;
+									next_edges += csr->offsets_list[v + 1] - csr->offsets_list[v];
+									break;
+								}
+							}
+						}
+					}
+
+					ttimes[tid] += get_nano_time();
+				}
+				dynamic_partitioning_reset(dp);
+				pull_levels++;
+
+				// swapping
+				{
+					unsigned long* temp = bitmap;
+					bitmap = next_bitmap;
+					next_bitmap = temp;
+				}
+			}
+			mt += get_nano_time();
+
+			level++;
+			visited += next_vertices;
+			double frontier_density = 1.0 * (next_vertices + next_edges) / max(1, csr->edges_count);
+			if(flags & 1U)
+			{
+				char temp[255];
+				sprintf(temp, "%s %'3u, |F|: %'10u, Dns: %'5.2f, time:", direction == 0 ? "Push" : "Pull", level, next_vertices, frontier_density);
+				PTIP(temp);
+			}
+
+			if(next_vertices == 0)
+				break;
+
+			// Switching the direction
+			if(direction == 0 && frontier_density > LL_BFS_PULL_DENSITY)
+			{
+				// Worklist to bitmap
+				#pragma omp parallel for
+				for(unsigned long w = 0; w < bitmap_words; w++)
+					bitmap[w] = 0;
+
+				#pragma omp parallel for
+				for(unsigned int i = 0; i < worklist_length; i++)
+				{
+					unsigned int v = worklist[i];
+					if(v != -1U)
+						__atomic_fetch_or(&bitmap[v >> 6], 1UL << (v & 63), __ATOMIC_RELAXED);
+				}
+
+				direction = 1;
+			}
+			else if(direction == 1 && frontier_density < LL_BFS_PUSH_DENSITY)
+			{
+				// Bitmap to worklist
+				worklist_length = waspr * pe->threads_count;
+				#pragma omp parallel
+				{
+					unsigned tid = omp_get_thread_num();
+					unsigned int index = tid * waspr;
+					unsigned int end = (tid + 1) * waspr;
+
+					#pragma omp for nowait
+					for(unsigned long w = 0; w < bitmap_words; w++)
+					{
+						unsigned long word = bitmap[w];
+						while(word)
+						{
+							unsigned int v = w * 64 + __builtin_ctzl(word);
+							word &= word - 1;
+							__bfs_worklist_add(worklist, &worklist_length, worklist_size, waspr, &index, &end, v);
+						}
+					}
+
+					while(index < end)
+						worklist[index++] = -1U;
+				}
+
+				direction = 0;
+			}
+		}while(1);
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		if(flags & 1U)
+		{
+			printf("Levels: %'u, Push levels: %'u, Pull levels: %'u\n", level, push_levels, pull_levels);
+			printf("Visited vertices: \t\t%'lu\n", visited);
+			printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		}
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = level;
+			exec_info[9] = visited;
+			exec_info[10] = push_levels;
+			exec_info[11] = pull_levels;
+		}
+
+	// Releasing memory
+		numa_free(bitmap, sizeof(unsigned long) * bitmap_words);
+		bitmap = NULL;
+		numa_free(next_bitmap, sizeof(unsigned long) * bitmap_words);
+		next_bitmap = NULL;
+		numa_free(worklist, sizeof(unsigned int) * worklist_size);
+		worklist = NULL;
+		numa_free(next_worklist, sizeof(unsigned int) * worklist_size);
+		next_worklist = NULL;
+
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return levels;
+}
+
+/*
+	Serial BFS using a queue. We use this for validation of results.
+*/
+unsigned int* bfs_serial(struct ll_400_graph* g, unsigned int root)
+{
+	assert(g != NULL && root < g->vertices_count);
+
+	unsigned int* levels = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+	unsigned int* queue = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+	assert(levels != NULL && queue != NULL);
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+		levels[v] = -1U;
+
+	unsigned long head = 0;
+	unsigned long tail = 0;
+	levels[root] = 0;
+	queue[tail++] = root;
+	while(head < tail)
+	{
+		unsigned int v = queue[head++];
+		for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+		{
+			unsigned int u = g->edges_list[e];
+			if(levels[u] != -1U)
+				continue;
+			levels[u] = levels[v] + 1;
+			queue[tail++] = u;
+		}
+	}
+
+	numa_free(queue, sizeof(unsigned int) * g->vertices_count);
+	queue = NULL;
+
+	return levels;
+}
+
+void bfs_release(struct ll_400_graph* g, unsigned int* levels)
+{
+	assert(g != NULL && levels != NULL);
+
+	numa_free(levels, sizeof(unsigned int) * g->vertices_count);
+	levels = NULL;
+
+	return;
+}
+
+#endif
@@ -1,6 +1,8 @@
 #ifndef __CC_C
 #define __CC_C
 
+#include "cgraph.c"
+
 // This file contains implementation of the Connected Components algorithms
 
 /*
@@ -146,38 +148,84 @@ unsigned int* cc_pull(struct par_env* pe, struct ll_400_graph* g, unsigned int f
 }
 
 /*
-	Thrifty Label Propagation Connected Components
-
-	https://blogs.qub.ac.uk/DIPSA/Thrifty-Label-Propagation-Fast-Connected-Components-for-Skewed-Degree-Graphs/
-
-	@INPROCEEDINGS{10.1109/Cluster48925.2021.00042,
-	  author={Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
-	  booktitle={2021 IEEE International Conference on Cluster Computing (CLUSTER)}, 
-	  title={Thrifty Label Propagation: Fast Connected Components for Skewed-Degree Graphs}, 
-	  year={2021},
-	  volume={},
-	  number={},
-	  pages={226-237},
-	  publisher={IEEE Computer Society},
-	  doi={10.1109/Cluster48925.2021.00042}
-	}
+	The 4 Bytes (ll_400) and 8 Bytes (ll_800) vertex ID versions of the Thrifty CC and the version for
+	graphs with 4 Bytes offsets (ll_400s) share their implementation in `cc_thrifty.tpl.c`.
+*/
+#define LL_T_GRAPH                         ll_400_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning
+#define LL_T_STREAM_WAIT_VERTICES          ll_400_stream_wait_vertices
+#define LL_T_CC_THRIFTY                    cc_thrifty_400
+#define LL_T_CC_RELEASE                    cc_release
+#include "cc_thrifty.tpl.c"
+
+#define LL_T_GRAPH                         ll_800_graph
+#define LL_T_VID                           unsigned long
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_800
+#define LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex) do{}while(0)
+#define LL_T_CC_THRIFTY                    cc_thrifty_800
+#define LL_T_CC_RELEASE                    cc_release_800
+#include "cc_thrifty.tpl.c"
+
+#define LL_T_GRAPH                         ll_400s_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_400s
+#define LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex) do{}while(0)
+#define LL_T_CC_THRIFTY                    cc_thrifty_400s
+#define LL_T_CC_RELEASE                    cc_release_400s
+#include "cc_thrifty.tpl.c"
 
-	flags:
-		bit 0: print stats
-		bit 1: do not reset papi
+/*
+	Thrifty on the compressed graph (ll_c400, `cgraph.c`): `cc_thrifty_c400()` and `cc_release_c400()`
 
-	exec_info: if not NULL, will have
-		[0]: exec time
-		[1-7]: papi events
-		[8]: push max-degree
-		[9]: ID of vertex with max degree, i.e., with zero CC val.
+	The partitions are aligned to the sampled vertices of the compressed graph and traversed by a cursor. 
+	Neighbour-lists are decoded in batches of `LL_C400_BATCH` neighbours, so the Zero Convergence also skips 
+	decoding the remaining neighbours of a vertex. In the push iterations, the neighbour-list of each vertex 
+	of the worklist is located from its sample. The Initial Push is performed by one thread.
+*/
+struct __cc_c400_neighbours
+{
+	struct ll_c400_list list;
+	unsigned long degree;
+	unsigned long count;
+	unsigned long index;
+	unsigned int neighbours[LL_C400_BATCH];
+};
+
+#define LL_T_GRAPH                         ll_c400_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    ll_c400_edge_partitioning
+#define LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex) do{}while(0)
+#define LL_T_CC_THRIFTY                    cc_thrifty_c400
+#define LL_T_CC_RELEASE                    cc_release_c400
+#define LL_T_NEIGHBOURS                    struct __cc_c400_neighbours
+#define LL_T_CURSOR(g, c, v)               struct ll_c400_cursor c; ll_c400_cursor_init(g, &c, v);
+#define LL_T_CURSOR_NEXT(g, c, it, v)      do{(it).count = 0; (it).index = 0; (it).degree = ll_c400_cursor_next(&c, &(it).list);}while(0)
+#define LL_T_GET_NEIGHBOURS(g, it, v)      do{(it).count = 0; (it).index = 0; (it).degree = ll_c400_get_list(g, v, &(it).list);}while(0)
+#define LL_T_DEGREE(g, it, v)              ((it).degree)
+#define LL_T_NEXT_NEIGHBOUR(g, it, u) \
+	(((it).index < (it).count || ((it).index = 0, (it).count = ll_c400_decode(&(it).list, (it).neighbours, LL_C400_BATCH))) ? \
+		((u) = (it).neighbours[(it).index++], 1) : 0)
+#define LL_T_INITIAL_PUSH(g, cc, v, tid) \
+	if((tid) == 0) \
+	{ \
+		struct __cc_c400_neighbours __it; \
+		unsigned int __u; \
+		LL_T_GET_NEIGHBOURS(g, __it, v); \
+		while(LL_T_NEXT_NEIGHBOUR(g, __it, __u)) \
+			(cc)[__u] = 0; \
+	}
+#include "cc_thrifty.tpl.c"
+
+/*
+	It is the thrifty for weighted graphs
 */
-unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
 {
 	// Initial checks
 		assert(pe != NULL && g != NULL);
 		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_thrifty\033[0;37m\n");
+		printf("\n\033[3;31mcc_thrifty_w4\033[0;37m\n");
 
 	// Reset papi
 		if(!(flags & 2U))
@@ -198,7 +246,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
 		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
 		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
+		parallel_edge_partitioning((struct ll_400_graph*)g, partitions, partitions_count);
 		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
 
 	// Zero Planting: Assigning the zero label to the vertex with max degree
@@ -244,8 +292,6 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 			// Plant the zero label
 			cc[max_vals[1]] = 0;
 			max_degree_id = max_vals[1];
-			if(exec_info)
-				exec_info[9] = max_degree_id;
 		}
 
 	// Initial Push: Propagate the zero label to the neighbours of the max-degree vertex
@@ -256,7 +302,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 			ttimes[tid] = - get_nano_time();
 
 			#pragma omp for nowait
-			for(unsigned long e = g->offsets_list[max_degree_id]; e < g->offsets_list[max_degree_id + 1]; e++)
+			for(unsigned long e = 2 * g->offsets_list[max_degree_id]; e < 2 * g->offsets_list[max_degree_id + 1]; e+=2)
 				cc[g->edges_list[e]] = 0;
 
 			ttimes[tid] += get_nano_time();
@@ -296,7 +342,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 						if(!component)
 							continue;
 
-						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+						for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
 						{
 							unsigned int neighbour = g->edges_list[e];
 							if(cc[neighbour] < component)
@@ -341,18 +387,18 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 	// Allocating memory for the shared worklists
 		/*
 			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
-			Since push iterations are sparse, we dedicate a chunk (with a size of cacheline, i.e., 16 uints) to each thread and after filling it we allocate another chunk. This way, we do not need to allocate per thread worklist. 
+			Since push iterations are sparse, we dedicate a chunk of `waspr` size to each thread and 
+			after filling it we allocate another chunk. This way, we do not need to alocate per vertex worklist.
 			
-			The another point is about tiling. The initial implementation of thrifty used the 
-			edge-tiling [Galois, DOI:10.1145/2517349.2522739] in the push iterations to allow
+			The another point is about tiling. The initial implementation of thrifty had edge-tiling to allow
 			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
-			push direction, we do not expect to see very high degree vertices and we do not use edge-tiling in this implementation. 
+			push direction, we do not expect to see very high degree vertices. 
 
 			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
 			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
 			
 			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
-			previously stored in the worklist. We do not use atomics for accessing `df` as it is correct to process a 
+			previously stored in the worklist. We do not use atomics for accessing df as it is correct to process a 
 			vertex multiple times in a CC iteration. 
 		*/
 
@@ -392,7 +438,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 					if(!component)
 						continue;
 
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
 					{
 						unsigned int neighbour = g->edges_list[e];
 						if(cc[neighbour] < component)
@@ -478,7 +524,7 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 					if(degree > push_max_degree)
 						push_max_degree = degree;
 
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v+1]; e++)
+					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v+1]; e += 2)
 					{
 						unsigned int neighbour = g->edges_list[e];
 						unsigned int changed = 0;
@@ -605,14 +651,81 @@ unsigned int* cc_thrifty_400(struct par_env* pe, struct ll_400_graph* g, unsigne
 }
 
 /*
-	It is the thrifty for weighted graphs
+	Links the trees of `x` and `y` by CAS-ing the larger root to the smaller root, as in `cc_jt()`.
+	Returns 1 if two trees have been merged by this call and 0 if `x` and `y` were already in the same tree.
 */
-unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+static inline unsigned int __cc_jt_link(unsigned int* cc, unsigned int x, unsigned int y)
+{
+	while(1)
+	{
+		while(x != cc[x])
+			x = cc[x];
+
+		while(y != cc[y])
+			y = cc[y];
+
+		if(x == y)
+			return 0;
+
+		if(x < y)
+		{
+			if(__sync_bool_compare_and_swap(&cc[y], y, x))
+				return 1;
+		}
+		else
+		{
+			if(__sync_bool_compare_and_swap(&cc[x], x, y))
+				return 1;
+		}
+	}
+
+	return 0;
+}
+
+/*
+	Pointer jumping: replaces the parent of `v` by its root.
+*/
+static inline void __cc_jt_compress(unsigned int* cc, unsigned int v)
+{
+	while(cc[cc[v]] != cc[v])
+		cc[v] = cc[cc[v]];
+
+	return;
+}
+
+/*
+	An implementation of a Disjoint-Set Union CC 
+	introduced by Siddhartha Jayanti and Robert Tarjan in the following paper
+
+	@article{ DBLP:journals/corr/JayantiT16,
+	author    = {Siddhartha V. Jayanti and Robert E. Tarjan},
+	title     = {A Randomized Concurrent Algorithm for Disjoint Set Union},
+	journal   = {CoRR},
+	volume    = {abs/1612.01514},
+	year      = {2016},
+	url       = {http://arxiv.org/abs/1612.01514},
+	eprinttype = {arXiv},
+	eprint    = {1612.01514},
+	}
+
+ 	g:
+  		Should be symmetric, otherwise `if(neighbour >= v) break;` should be removed.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+*/
+
+unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
 {
 	// Initial checks
 		assert(pe != NULL && g != NULL);
 		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_thrifty_w4\033[0;37m\n");
+		printf("\n\033[3;31mcc_jt\033[0;37m\n");
 
 	// Reset papi
 		if(!(flags & 2U))
@@ -633,361 +746,733 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
 		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
 		assert(partitions != NULL);
-		parallel_edge_partitioning((struct ll_400_graph*)g, partitions, partitions_count);
+		parallel_edge_partitioning(g, partitions, partitions_count);
 		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
 
-	// Zero Planting: Assigning the zero label to the vertex with max degree
+	// (1) Initializing
 		unsigned long mt = - get_nano_time();
-		unsigned int max_degree_id = 0;
+		#pragma omp parallel  
 		{
-			unsigned int max_vals[2] = {0,0};
-
-			#pragma omp parallel  
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			
+			while(1)
 			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int thread_max_vals[2] = {0,0};
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+					cc[v] = v;
 				
-				#pragma omp for nowait
-				for(unsigned int v = 0; v < g->vertices_count; v++)
-				{
-					cc[v] = v + 1;
-
-					unsigned int degree = g->offsets_list[v+1] - g->offsets_list[v];
-					if(degree > thread_max_vals[0])
-					{
-						thread_max_vals[0] = degree;
-						thread_max_vals[1] = v;
-					}
-				}
-
-				// Update max_vals
-				while(1)
-				{
-					unsigned long prev_val = *(unsigned long*)max_vals;
-					if((unsigned int)prev_val >= thread_max_vals[0])
-						break;
-					__sync_val_compare_and_swap((unsigned long*)max_vals, prev_val, *(unsigned long*)thread_max_vals);
-				}
-
-				ttimes[tid] += get_nano_time();
 			}
-			mt += get_nano_time();
-			if(flags & 1U)
-				PTIP("Zero Planting:");
-			printf("Max. degree: \t %'u \t\t (ID: %'u)\n", max_vals[0], max_vals[1]);
-			// Plant the zero label
-			cc[max_vals[1]] = 0;
-			max_degree_id = max_vals[1];
+
+			ttimes[tid] += get_nano_time();
 		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+			PTIP("(1) Initializing");
 
-	// Initial Push: Propagate the zero label to the neighbours of the max-degree vertex
+	// (2) Traversing edges
 		mt = - get_nano_time();
 		#pragma omp parallel  
 		{
 			unsigned tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int neighbour = g->edges_list[e];
+						if(neighbour >= v)    // These two lines should be removed for non-symmetric inputs
+							break;
 
-			#pragma omp for nowait
-			for(unsigned long e = 2 * g->offsets_list[max_degree_id]; e < 2 * g->offsets_list[max_degree_id + 1]; e+=2)
-				cc[g->edges_list[e]] = 0;
+						__cc_jt_link(cc, v, neighbour);
+					}
+			}
 
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
 		if(flags & 1U)
-			PTIP("Initial Push:");
+			PTIP("(2) Traversing edges:");
 
-	// Pull iterations with Zero Convergence: 
-		// If a vertex has reached zero label, its label cannot be reduced => do not process it.
-		double frontier_density;
-		unsigned int next_vertices;
-		unsigned int cc_iter = 0;
-		do
+	// (3) Pointer jumping
+		mt = - get_nano_time();
+		#pragma omp parallel   
 		{
-			unsigned long next_edges = 0;
-			next_vertices = 0;
-	
-			unsigned long mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int thread_next_vertices = 0;
-				unsigned long thread_next_edges = 0;
-				unsigned int partition = -1U;		
-				
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					{
-						unsigned int component = cc[v];
-						// Zero Convergence
-						if(!component)
-							continue;
-
-						for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
-						{
-							unsigned int neighbour = g->edges_list[e];
-							if(cc[neighbour] < component)
-							{
-								component = cc[neighbour];
-								// Zero Convergence
-								if(!component)
-									break;
-							}
-						}
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
 
-						if(component < cc[v])
-						{
-							cc[v] = component;
-							thread_next_vertices++;
-							thread_next_edges += g->offsets_list[v+1] - g->offsets_list[v];
-						}
-					}
-				}
+			#pragma omp for 
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				__cc_jt_compress(cc, v);
 
-				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
-				__sync_fetch_and_add(&next_edges, thread_next_edges, __ATOMIC_SEQ_CST);
-				
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(3) Pointer jumping:");
 
-			frontier_density = 1.0 * (next_vertices + next_edges) / g->edges_count;
-			if(flags & 1U)
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
 			{
-				char temp[255];
-				if(next_vertices < 100)
-					sprintf(temp, "Pull %'3u, |F|: %5u, Dns: %'5.2f, time:", cc_iter, next_vertices, frontier_density);
-				else
-					sprintf(temp, "Pull %'3u, |F|: %'4.1f%, Dns: %'5.2f, time:", cc_iter, 100.0 * next_vertices/g->vertices_count, frontier_density);
-				PTIP(temp);
+				assert(0 == thread_papi_read(pe));
 			}
-			cc_iter++;
-		}while(frontier_density >= 0.01);
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
 
-	// Allocating memory for the shared worklists
-		/*
-			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
-			Since push iterations are sparse, we dedicate a chunk of `waspr` size to each thread and 
-			after filling it we allocate another chunk. This way, we do not need to alocate per vertex worklist.
-			
-			The another point is about tiling. The initial implementation of thrifty had edge-tiling to allow
-			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
-			push direction, we do not expect to see very high degree vertices. 
+	// Counting number of components
+		if(ccs_p)
+		{
+			unsigned int ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'u\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
 
-			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
-			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
-			
-			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
-			previously stored in the worklist. We do not use atomics for accessing df as it is correct to process a 
-			vertex multiple times in a CC iteration. 
-		*/
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		free(ttimes);
+		ttimes = NULL;
+	
+	return cc;
+}
 
-		unsigned int waspr = 16;  // worklist_allocation_size_per_request
-		unsigned int worklist_size = max(2 * next_vertices + waspr * pe->threads_count, 1024U * 1024);
-		
-		unsigned int* worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
-		unsigned int worklist_length = waspr * pe->threads_count;				 // initial allocation per thread
-		
-		unsigned int* next_worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
-		unsigned int next_worklist_length = waspr * pe->threads_count;    // initial allocation per thread
+/*
+	Jayanti-Tarjan CC (`cc_jt()`) on the compressed graph (ll_c400, `cgraph.c`).
 
-		unsigned char* df = numa_alloc_interleaved(sizeof(unsigned char) * g->vertices_count);
-		unsigned char* next_df = numa_alloc_interleaved(sizeof(unsigned char) * g->vertices_count);
-		assert(worklist != NULL && next_worklist != NULL && df != NULL && next_df != NULL);
+	g:
+		Should be symmetric. As the neighbour-lists are sorted, decoding a neighbour-list stops at the first neighbour 
+		that is not smaller than the vertex.
 
-	// Pull-Frontier: One more pull iteration to store active vertices into worklist
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+*/
+unsigned int* cc_jt_c400(struct par_env* pe, struct ll_c400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_jt_c400\033[0;37m\n");
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+	
+	// Allocate memory
+		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(cc != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		ll_c400_edge_partitioning(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (1) Initializing
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for 
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				cc[v] = v;
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(1) Initializing");
+
+	// (2) Traversing edges
 		mt = - get_nano_time();
 		#pragma omp parallel  
 		{
 			unsigned tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
 			unsigned int partition = -1U;		
-
-			unsigned int thread_worklist_index = tid * waspr;
-			unsigned int thread_worklist_end = (tid + 1) * waspr;
+			unsigned int neighbours[LL_C400_BATCH];
 			
 			while(1)
 			{
 				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
 				if(partition == -1U)
 					break; 
+
+				struct ll_c400_cursor c;
+				ll_c400_cursor_init(g, &c, partitions[partition]);
 				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
 				{
-					unsigned int component = cc[v];
-					// Zero Convergence
-					if(!component)
-						continue;
+					struct ll_c400_list list;
+					ll_c400_cursor_next(&c, &list);
 
-					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v + 1]; e += 2)
-					{
-						unsigned int neighbour = g->edges_list[e];
-						if(cc[neighbour] < component)
+					unsigned long count;
+					unsigned int done = 0;
+					while(!done && (count = ll_c400_decode(&list, neighbours, LL_C400_BATCH)))
+						for(unsigned long i = 0; i < count; i++)
 						{
-							component = cc[neighbour];
-							// Zero Convergence
-							if(!component)
+							unsigned int neighbour = neighbours[i];
+							if(neighbour >= v)
+							{
+								done = 1;
 								break;
+							}
+
+							__cc_jt_link(cc, v, neighbour);
 						}
-					}
+				}
+			}
 
-					// if new label has been found
-					if(component < cc[v])
-					{
-						cc[v] = component;
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+			PTIP("(2) Traversing edges:");
 
-						// set the frontier
-						if(df[v])
-							continue;
+	// (3) Pointer jumping
+		mt = - get_nano_time();
+		#pragma omp parallel   
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
 
-						// add to worklist
-						df[v] = 1;
-						worklist[thread_worklist_index++] = v;
-						if(thread_worklist_index == thread_worklist_end)
-						{
-							// grab a new chunk
-							do
-							{
-								thread_worklist_index = worklist_length;
-								thread_worklist_end = thread_worklist_index + waspr;
-							}while(__sync_val_compare_and_swap(&worklist_length, thread_worklist_index, thread_worklist_end) != thread_worklist_index);
-							assert(worklist_length <= worklist_size);
-						}
-					}
+			#pragma omp for 
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				__cc_jt_compress(cc, v);
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(3) Pointer jumping:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			unsigned int ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'u\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		free(ttimes);
+		ttimes = NULL;
+	
+	return cc;
+}
+
+/*
+	Validates the CC labels of the compressed graph `g` using a serial union-find over the edges decoded by 
+	the ll_c400 cursor:
+		(1) all vertices of a component have the same label,
+		(2) the number of components is the same.
+	As explained in `alg2_thrifty.c`, (1) and (2) guarantee that the vertices of different components have
+	different labels. The labels of both `cc_thrifty_c400()` and `cc_jt_c400()` can be validated.
+
+	Returns 1 if the labels are valid.
+*/
+int cc_validate_c400(struct par_env* pe, struct ll_c400_graph* g, unsigned int* cc, unsigned int ccs)
+{
+	assert(pe != NULL && g != NULL && cc != NULL);
+	const unsigned int vc = g->vertices_count;
+
+	unsigned int* root = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	assert(root != NULL);
+	for(unsigned int v = 0; v < vc; v++)
+		root[v] = v;
+
+	unsigned int neighbours[LL_C400_BATCH];
+	struct ll_c400_cursor c;
+	ll_c400_cursor_init(g, &c, 0);
+	for(unsigned int v = 0; v < vc; v++)
+	{
+		struct ll_c400_list list;
+		ll_c400_cursor_next(&c, &list);
+
+		unsigned long count;
+		while((count = ll_c400_decode(&list, neighbours, LL_C400_BATCH)))
+			for(unsigned long i = 0; i < count; i++)
+			{
+				unsigned int a = v;
+				while(root[a] != a)
+					a = root[a] = root[root[a]];
+				unsigned int b = neighbours[i];
+				while(root[b] != b)
+					b = root[b] = root[root[b]];
+				if(a < b)
+					root[b] = a;
+				else if(b < a)
+					root[a] = b;
+			}
+	}
+
+	unsigned int serial_ccs = 0;
+	unsigned long errors = 0;
+	for(unsigned int v = 0; v < vc; v++)
+	{
+		unsigned int r = v;
+		while(root[r] != r)
+			r = root[r];
+		root[v] = r;
+		if(r == v)
+			serial_ccs++;
+		else if(cc[v] != cc[r])
+			errors++;
+	}
+	if(serial_ccs != ccs)
+		errors++;
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors, |CCs|: %'u, serial |CCs|: %'u\n", errors, ccs, serial_ccs);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	numa_free(root, sizeof(unsigned int) * vc);
+	root = NULL;
+
+	return errors == 0;
+}
+
+/*
+	Returns the most frequent label among `LL_CC_AFFOREST_SAMPLES` randomly sampled vertices, i.e.,
+	the likely label of the largest component in Afforest.
+*/
+
+#define LL_CC_AFFOREST_ROUNDS 2
+#define LL_CC_AFFOREST_SAMPLES 1024
+
+unsigned int __cc_afforest_largest(unsigned int* cc, unsigned int vertices_count)
+{
+	unsigned int samples_count = min(LL_CC_AFFOREST_SAMPLES, vertices_count);
+	unsigned int* samples = malloc(sizeof(unsigned int) * samples_count);
+	assert(samples != NULL);
+	unsigned long seed = 0x9E3779B97F4A7C15UL;
+	for(unsigned int s = 0; s < samples_count; s++)
+	{
+		seed = seed * 6364136223846793005UL + 1442695040888963407UL;
+		samples[s] = cc[(seed >> 32) % vertices_count];
+	}
+
+	unsigned int largest = samples[0];
+	unsigned int best_count = 0;
+	for(unsigned int s = 0; s < samples_count; s++)
+	{
+		unsigned int count = 0;
+		for(unsigned int t = 0; t < samples_count; t++)
+			if(samples[t] == samples[s])
+				count++;
+		if(count > best_count)
+		{
+			best_count = count;
+			largest = samples[s];
+		}
+	}
+
+	free(samples);
+	samples = NULL;
+
+	return largest;
+}
+
+/*
+	Afforest CC
+
+	@INPROCEEDINGS{10.1109/IPDPS.2018.00100,
+	author={Sutton, Michael and Ben-Nun, Tal and Barak, Amnon},
+	booktitle={2018 IEEE International Parallel and Distributed Processing Symposium (IPDPS)},
+	title={Optimizing Parallel Graph Connectivity Computation via Subgraph Sampling},
+	year={2018},
+	pages={12-21},
+	doi={10.1109/IPDPS.2018.00100}
+	}
+
+	(1) Sampled linking: the first `LL_CC_AFFOREST_ROUNDS` neighbours of each vertex are linked using the
+	CAS linking of `cc_jt()` followed by pointer jumping after each round.
+	(2) The label of the largest intermediate component is found by sampling.
+	(3) The remaining edges of the vertices that are not in the largest component are linked. As the graph is
+	symmetric, an edge between a vertex of the largest component and another vertex is processed from the
+	other vertex, so the vertices of the largest component, i.e., most of the edges, are skipped.
+	(4) Pointer jumping.
+
+	g:
+		Should be symmetric. For directed graphs, see `wcc_afforest_push()`.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: label of the largest intermediate component
+		[9]: number of vertices in the largest intermediate component
+		[10]: number of edges linked in step (3)
+*/
+unsigned int* cc_afforest(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && g->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_afforest\033[0;37m\n");
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+	
+	// Allocate memory
+		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(cc != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (1) Sampled linking
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				cc[v] = v;
+
+			for(unsigned int r = 0; r < LL_CC_AFFOREST_ROUNDS; r++)
+			{
+				#pragma omp for schedule(dynamic, 4096)
+				for(unsigned int v = 0; v < g->vertices_count; v++)
+					if(g->offsets_list[v] + r < g->offsets_list[v + 1])
+						__cc_jt_link(cc, v, g->edges_list[g->offsets_list[v] + r]);
+
+				#pragma omp for schedule(dynamic, 4096)
+				for(unsigned int v = 0; v < g->vertices_count; v++)
+					__cc_jt_compress(cc, v);
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(1) Sampled linking:");
+
+	// (2) Finding the largest intermediate component
+		mt = - get_nano_time();
+		unsigned int largest = __cc_afforest_largest(cc, g->vertices_count);
+		unsigned long largest_size = 0;
+		#pragma omp parallel for reduction(+:largest_size)
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			if(cc[v] == largest)
+				largest_size++;
+		mt += get_nano_time();
+		if(flags & 1U)
+		{
+			PT("(2) Largest component:");
+			printf("Largest intermediate component: %'lu vertices (%.1f%%), label: %'u\n", largest_size, 100.0 * largest_size / g->vertices_count, largest);
+		}
+
+	// (3) Linking the remaining edges of the vertices out of the largest component
+		mt = - get_nano_time();
+		unsigned long linked_edges = 0;
+		#pragma omp parallel reduction(+:linked_edges)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					if(cc[v] == largest)
+						continue;
+
+					for(unsigned long e = g->offsets_list[v] + LL_CC_AFFOREST_ROUNDS; e < g->offsets_list[v + 1]; e++)
+						__cc_jt_link(cc, v, g->edges_list[e]);
+					if(g->offsets_list[v + 1] > g->offsets_list[v] + LL_CC_AFFOREST_ROUNDS)
+						linked_edges += g->offsets_list[v + 1] - g->offsets_list[v] - LL_CC_AFFOREST_ROUNDS;
 				}
 			}
 
-			// fill unused indecis with -1U to prevent from being processed in the next iteration
-			while(thread_worklist_index < thread_worklist_end)
-				worklist[thread_worklist_index++] = -1U;
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "(3) Linking, edges: %'lu (%.1f%%):", linked_edges, 100.0 * linked_edges / max(1UL, g->edges_count));
+			PTIP(temp);
+		}
+
+	// (4) Pointer jumping
+		mt = - get_nano_time();
+		#pragma omp parallel   
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for 
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				__cc_jt_compress(cc, v);
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(4) Pointer jumping:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			unsigned int ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'u\n",ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = largest;
+			exec_info[9] = largest_size;
+			exec_info[10] = linked_edges;
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+	
+	return cc;
+}
+
+/*
+	Incremental CC under batched edge insertions
+
+	The parent array returned by `cc_jt()` (or `cc_afforest()`) is kept alive and batches of new edges are
+	applied to it in parallel using the CAS linking of `cc_jt()`, without recomputing the components of the
+	base graph. The roots of the trees remain the minimum vertex ID of each component.
+
+	Compression is lazy: after a batch, only the endpoints of the new edges are pointed to their roots,
+	so the other vertices of a merged component may be one or more hops away from the root. The component
+	ID of a vertex should therefore be read using `cc_incremental_find()` rather than `cc[v]`. Setting
+	bit 2 of `flags` performs a full pointer jumping after the batch so that `cc[v]` is the component ID of
+	all vertices, e.g., before passing `cc` to code that reads it directly.
+
+	Returns the number of merged components, i.e., the number of components is decreased by this value.
+*/
+
+/*
+	Returns the component ID (root) of `v` and halves the path from `v` to the root.
+	Safe to call concurrently with `cc_incremental_add_edges()` and `cc_incremental_add_graph()`,
+	but a concurrent call may return a root that is being merged by the batch.
+*/
+static inline unsigned int cc_incremental_find(unsigned int* cc, unsigned int v)
+{
+	while(cc[v] != v)
+	{
+		unsigned int p = cc[v];
+		unsigned int gp = cc[p];
+		if(gp != p)
+			cc[v] = gp;
+		v = gp;
+	}
+
+	return v;
+}
+
+/*
+	edges:
+		An array of `2 * edges_count` elements where the i-th edge is (edges[2 * i], edges[2 * i + 1]).
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+		bit 2: full pointer jumping after the batch
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of merged components
+		[9]: number of edges in the batch
+
+	ccs_p: if not NULL, should contain the number of components before the batch and will be updated
+*/
+unsigned long cc_incremental_add_edges(struct par_env* pe, unsigned int* cc, unsigned long vertices_count, 
+	unsigned int* edges, unsigned long edges_count, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && cc != NULL && (edges != NULL || edges_count == 0));
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mcc_incremental_add_edges\033[0;37m\n");
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (1) Linking
+		unsigned long merges = 0;
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel reduction(+:merges)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for schedule(dynamic, 4096)
+			for(unsigned long e = 0; e < edges_count; e++)
+			{
+				unsigned int x = edges[2 * e];
+				unsigned int y = edges[2 * e + 1];
+				assert(x < vertices_count && y < vertices_count);
+
+				merges += __cc_jt_link(cc, x, y);
+			}
 
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-
 		if(flags & 1U)
 		{
 			char temp[255];
-			sprintf(temp, "Pull-Frontier, |F|: %'u, time:", worklist_length);
+			sprintf(temp, "(1) Linking, merges: %'lu:", merges);
 			PTIP(temp);
 		}
-		cc_iter++;
 
-	// Push iterations
-		unsigned int push_max_degree = 0;
-		do
+	// (2) Pointer jumping
+		mt = - get_nano_time();
+		#pragma omp parallel
 		{
-			mt = - get_nano_time();
-			next_vertices = 0;
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
 
-			#pragma omp parallel  
+			if(flags & 4U)
 			{
-				unsigned tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-			
-				unsigned int thread_next_worklist_index = tid * waspr;
-				unsigned int thread_next_worklist_end = (tid + 1) * waspr;
-				unsigned int thread_next_vertices = 0;
-
-				#pragma omp for nowait reduction(max:push_max_degree)
-				for(unsigned int index = 0; index < worklist_length; index++)
-				{
-					if(worklist[index] == -1U)
-						continue;
-
-					unsigned int v = worklist[index];
-					if(df[v] == 0)
-						continue;
-					df[v] = 0;
-
-					unsigned int degree = g->offsets_list[v+1] - g->offsets_list[v];
-					if(degree > push_max_degree)
-						push_max_degree = degree;
-
-					for(unsigned long e = 2 * g->offsets_list[v]; e < 2 * g->offsets_list[v+1]; e += 2)
-					{
-						unsigned int neighbour = g->edges_list[e];
-						unsigned int changed = 0;
-
-						while(1)
-						{
-							unsigned int cc_neighbour = cc[neighbour];
-							unsigned int cc_v = cc[v];
-							if(cc_neighbour <= cc_v)
-								break;
-
-							unsigned int prev_val = __sync_val_compare_and_swap(&cc[neighbour], cc_neighbour, cc_v);
-							if(prev_val == cc_neighbour)
-							{
-								changed = 1;
-								break;
-							}
-						}
-
-						if(!changed)
-							continue;
-
-						if(next_df[neighbour])
-							continue;
-
-						next_df[neighbour] = 1;
-						thread_next_vertices++;
-						next_worklist[thread_next_worklist_index++] = neighbour;
-						if(thread_next_worklist_index == thread_next_worklist_end)
-						{
-							// grab a new chunk
-							do
-							{
-								thread_next_worklist_index = next_worklist_length;
-								thread_next_worklist_end = thread_next_worklist_index + waspr;
-							}while(__sync_val_compare_and_swap(&next_worklist_length, thread_next_worklist_index, thread_next_worklist_end) != thread_next_worklist_index);
-							assert(next_worklist_length <= worklist_size);
-						}
-					}
-				}	
-
-				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
-
-				// fill unused indecis with -1U to prevent from being processed in the next iteration
-				while(thread_next_worklist_index < thread_next_worklist_end)
-					next_worklist[thread_next_worklist_index++] = -1U;
-
-				ttimes[tid] += get_nano_time();
+				#pragma omp for 
+				for(unsigned int v = 0; v < vertices_count; v++)
+					__cc_jt_compress(cc, v);
 			}
-			mt += get_nano_time();
-			if(flags & 1U)
+			else if(merges)
 			{
-				char temp[255];
-				sprintf(temp, "Push, |F|: %5u, time:", next_vertices);
-				PTIP(temp);
+				#pragma omp for schedule(dynamic, 4096)
+				for(unsigned long e = 0; e < 2 * edges_count; e++)
+					__cc_jt_compress(cc, edges[e]);
 			}
-			cc_iter++;
-
-			// swapping
-				{
-					unsigned int* temp = worklist;
-					worklist = next_worklist;
-					next_worklist = temp;
-
-					worklist_length = next_worklist_length;
-					next_worklist_length = waspr * pe->threads_count;
 
-					unsigned char* temp2 = df;
-					df = next_df;
-					next_df = temp2;
-				}
-		}while(next_vertices);
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
 		if(flags & 1U)
-			printf("Max-degree in push iterations: \t\t%'u\n", push_max_degree);
-		if(exec_info)
-			exec_info[8] = push_max_degree;
+			PTIP("(2) Pointer jumping:");
 
 	// Saving events
 		if(!(flags & 2U))
@@ -1002,81 +1487,55 @@ unsigned int* cc_thrifty_404(struct par_env* pe, struct ll_404_graph* g, unsigne
 				copy_reset_hw_events(pe, &exec_info[1], 1);
 		}
 
-	// Counting number of components
+	// Updating number of components
 		if(ccs_p)
 		{
-			unsigned int ccs = 1;
-			#pragma omp parallel for reduction(+:ccs)
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				if(cc[v] == v + 1)
-					ccs++;
-			printf("|CCs|:            \t\t%'u\n",ccs);
-			*ccs_p = ccs;
+			assert(*ccs_p >= merges);
+			*ccs_p -= merges;
+			printf("|CCs|:            \t\t%'u\n", *ccs_p);
 		}
-		
+
 	// Finalizing
 		t0 += get_nano_time();
 		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
 		if(exec_info)
+		{
 			exec_info[0] = t0;
+			exec_info[8] = merges;
+			exec_info[9] = edges_count;
+		}
 
 	// Releasing memory
-		free(partitions);
-		partitions = NULL;
 		free(ttimes);
 		ttimes = NULL;
-		numa_free(worklist, sizeof(unsigned int) * worklist_size);
-		worklist = NULL;
-		numa_free(next_worklist, sizeof(unsigned int) * worklist_size);
-		next_worklist = NULL;
-		numa_free(df, sizeof(unsigned char) * g->vertices_count);
-		df = NULL;
-		numa_free(next_df, sizeof(unsigned char) * g->vertices_count);
-		next_df = NULL;
 
-	return cc;
+	return merges;
 }
 
-void cc_release(struct ll_400_graph* g, unsigned int* cc)
-{
-	assert(cc != NULL && g != NULL);
-	numa_free(cc, sizeof(unsigned int) * g->vertices_count);
-	return;
-} 
-
 /*
-	An implementation of a Disjoint-Set Union CC 
-	introduced by Siddhartha Jayanti and Robert Tarjan in the following paper
-
-	@article{ DBLP:journals/corr/JayantiT16,
-	author    = {Siddhartha V. Jayanti and Robert E. Tarjan},
-	title     = {A Randomized Concurrent Algorithm for Disjoint Set Union},
-	journal   = {CoRR},
-	volume    = {abs/1612.01514},
-	year      = {2016},
-	url       = {http://arxiv.org/abs/1612.01514},
-	eprinttype = {arXiv},
-	eprint    = {1612.01514},
-	}
-
- 	g:
-  		Should be symmetric, otherwise `if(neighbour >= v) break;` should be removed.
+	Similar to `cc_incremental_add_edges()`, but the batch is a delta graph with the same vertex IDs as 
+	the base graph. The delta does not need to be symmetric or sorted.
 
 	flags:
 		bit 0: print stats
 		bit 1: do not reset papi
+		bit 2: full pointer jumping after the batch
 
 	exec_info: if not NULL, will have
 		[0]: exec time
 		[1-7]: papi events
-*/
+		[8]: number of merged components
+		[9]: number of edges in the batch
 
-unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+	ccs_p: if not NULL, should contain the number of components before the batch and will be updated
+*/
+unsigned long cc_incremental_add_graph(struct par_env* pe, unsigned int* cc, struct ll_400_graph* delta, 
+	unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
 {
 	// Initial checks
-		assert(pe != NULL && g != NULL);
+		assert(pe != NULL && cc != NULL && delta != NULL);
 		unsigned long t0 = - get_nano_time();
-		printf("\n\033[3;31mcc_jt\033[0;37m\n");
+		printf("\n\033[3;31mcc_incremental_add_graph\033[0;37m\n");
 
 	// Reset papi
 		if(!(flags & 2U))
@@ -1085,10 +1544,8 @@ unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int fla
 				unsigned tid = omp_get_thread_num();
 				papi_reset(pe->papi_args[tid]);
 			}
-	
+
 	// Allocate memory
-		unsigned int* cc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
-		assert(cc != NULL);
 		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
 		assert(ttimes != NULL);
 
@@ -1097,12 +1554,13 @@ unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int fla
 		unsigned int partitions_count = pe->threads_count * thread_partitions;
 		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
 		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
+		parallel_edge_partitioning(delta, partitions, partitions_count);
 		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
 
-	// (1) Initializing
+	// (1) Linking
+		unsigned long merges = 0;
 		unsigned long mt = - get_nano_time();
-		#pragma omp parallel  
+		#pragma omp parallel reduction(+:merges)
 		{
 			unsigned tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
@@ -1113,9 +1571,10 @@ unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int fla
 				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
 				if(partition == -1U)
 					break; 
+
 				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					cc[v] = v;
-				
+					for(unsigned long e = delta->offsets_list[v]; e < delta->offsets_list[v + 1]; e++)
+						merges += __cc_jt_link(cc, v, delta->edges_list[e]);
 			}
 
 			ttimes[tid] += get_nano_time();
@@ -1123,81 +1582,49 @@ unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int fla
 		mt += get_nano_time();
 		dynamic_partitioning_reset(dp);
 		if(flags & 1U)
-			PTIP("(1) Initializing");
+		{
+			char temp[255];
+			sprintf(temp, "(1) Linking, merges: %'lu:", merges);
+			PTIP(temp);
+		}
 
-	// (2) Traversing edges
+	// (2) Pointer jumping
 		mt = - get_nano_time();
-		#pragma omp parallel  
+		#pragma omp parallel
 		{
 			unsigned tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
-					{
-						unsigned int neighbour = g->edges_list[e];
-						if(neighbour >= v)    // These two lines should be removed for non-symmetric inputs
-							break;
 
-						unsigned int x = v;
-						unsigned int y = neighbour;
+			if(flags & 4U)
+			{
+				#pragma omp for 
+				for(unsigned int v = 0; v < delta->vertices_count; v++)
+					__cc_jt_compress(cc, v);
+			}
+			else if(merges)
+			{
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
 
-						while(1)
+					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+						if(delta->offsets_list[v] != delta->offsets_list[v + 1])
 						{
-							while(x != cc[x])
-								x = cc[x];
-
-							while(y != cc[y])
-								y = cc[y];
-
-							if(x == y)
-								break;
-
-							if(x < y)
-							{
-								if(__sync_bool_compare_and_swap(&cc[y], y, x))
-									break;
-							}
-							else
-							{
-								if(__sync_bool_compare_and_swap(&cc[x], x, y))
-									break;
-							}
-
+							__cc_jt_compress(cc, v);
+							for(unsigned long e = delta->offsets_list[v]; e < delta->offsets_list[v + 1]; e++)
+								__cc_jt_compress(cc, delta->edges_list[e]);
 						}
-					}
+				}
 			}
 
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		if(flags & 1U)
-			PTIP("(2) Traversing edges:");
-
-	// (3) Pointer jumping
-		mt = - get_nano_time();
-		#pragma omp parallel   
-		{
-			unsigned tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-
-			#pragma omp for 
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				while(cc[cc[v]] != cc[v])
-					cc[v] = cc[cc[v]];
-
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
 		if(flags & 1U)
-			PTIP("(3) Pointer jumping:");
+			PTIP("(2) Pointer jumping:");
 
 	// Saving events
 		if(!(flags & 2U))
@@ -1212,31 +1639,33 @@ unsigned int* cc_jt(struct par_env* pe, struct ll_400_graph* g, unsigned int fla
 				copy_reset_hw_events(pe, &exec_info[1], 1);
 		}
 
-	// Counting number of components
+	// Updating number of components
 		if(ccs_p)
 		{
-			unsigned int ccs = 0;
-			#pragma omp parallel for reduction(+:ccs)
-			for(unsigned int v = 0; v < g->vertices_count; v++)
-				if(cc[v] == v)
-					ccs++;
-			printf("|CCs|:            \t\t%'u\n",ccs);
-			*ccs_p = ccs;
+			assert(*ccs_p >= merges);
+			*ccs_p -= merges;
+			printf("|CCs|:            \t\t%'u\n", *ccs_p);
 		}
-		
+
 	// Finalizing
 		t0 += get_nano_time();
 		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
 		if(exec_info)
+		{
 			exec_info[0] = t0;
+			exec_info[8] = merges;
+			exec_info[9] = delta->edges_count;
+		}
 
 	// Releasing memory
 		free(partitions);
 		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
 		free(ttimes);
 		ttimes = NULL;
-	
-	return cc;
+
+	return merges;
 }
 
 #endif
@@ -0,0 +1,567 @@
+/*
+	Template of the Thrifty CC for graphs with 4 Bytes and 8 Bytes vertex IDs.
+	This file is included by `cc.c` once per graph type with the following macros defined:
+		`LL_T_GRAPH`: struct name of the graph, e.g., `ll_400_graph` or `ll_400s_graph` (4 Bytes offsets)
+		`LL_T_VID`: type of vertex IDs and CC labels, e.g., `unsigned int`
+		`LL_T_PARALLEL_EDGE_PARTITIONING`: the partitioning function of the graph type
+		`LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex)`: waits for the edges of a streamed graph to be loaded,
+			defined as `do{}while(0)` for the graphs that are not streamed
+		`LL_T_CC_THRIFTY` and `LL_T_CC_RELEASE`: names of the functions, `LL_T_CC_RELEASE` is optional
+
+	The neighbour iteration is defined by the following macros. If `LL_T_NEIGHBOURS` is not defined, they are 
+	defined for graphs with `offsets_list` and `edges_list`, i.e., `ll_400_graph`, `ll_800_graph`, and `ll_400s_graph`.
+		`LL_T_NEIGHBOURS`: type of the iterator over the neighbours of a vertex
+		`LL_T_CURSOR(g, c, v)`: declares the cursor `c` to traverse the consecutive vertices starting from `v`
+		`LL_T_CURSOR_NEXT(g, c, it, v)`: moves `c` to its next vertex, `v`, and initializes `it` for `v`
+		`LL_T_GET_NEIGHBOURS(g, it, v)`: initializes `it` for `v`
+		`LL_T_DEGREE(g, it, v)`: the degree of `v`, valid after initializing `it` and before the first `LL_T_NEXT_NEIGHBOUR`
+		`LL_T_NEXT_NEIGHBOUR(g, it, u)`: sets `u` to the next neighbour and returns 1, or returns 0 at the end of the list
+		`LL_T_INITIAL_PUSH(g, cc, v, tid)`: the part of thread `tid` in setting the labels of the neighbours of `v` to zero
+*/
+
+#ifndef LL_T_NEIGHBOURS
+	#define LL_T_NEIGHBOURS                 struct __cc_csr_neighbours
+	#define LL_T_CURSOR(g, c, v)
+	#define LL_T_CURSOR_NEXT(g, c, it, v)   LL_T_GET_NEIGHBOURS(g, it, v)
+	#define LL_T_GET_NEIGHBOURS(g, it, v)   do{(it).e = (g)->offsets_list[v]; (it).end = (g)->offsets_list[(v) + 1];}while(0)
+	#define LL_T_DEGREE(g, it, v)           ((it).end - (it).e)
+	#define LL_T_NEXT_NEIGHBOUR(g, it, u)   ((it).e < (it).end ? ((u) = (g)->edges_list[(it).e++], 1) : 0)
+	#define LL_T_INITIAL_PUSH(g, cc, v, tid) \
+		{ \
+			unsigned long __length = (g)->offsets_list[(v) + 1] - (g)->offsets_list[v]; \
+			unsigned long __start = (g)->offsets_list[v] + __length * (tid) / pe->threads_count; \
+			unsigned long __end = (g)->offsets_list[v] + __length * ((tid) + 1) / pe->threads_count; \
+			for(unsigned long __e = __start; __e < __end; __e++) \
+				(cc)[(g)->edges_list[__e]] = 0; \
+		}
+
+	#ifndef __CC_CSR_NEIGHBOURS
+	#define __CC_CSR_NEIGHBOURS
+	struct __cc_csr_neighbours
+	{
+		unsigned long e;
+		unsigned long end;
+	};
+	#endif
+#endif
+
+/*
+	Thrifty Label Propagation Connected Components
+
+	https://blogs.qub.ac.uk/DIPSA/Thrifty-Label-Propagation-Fast-Connected-Components-for-Skewed-Degree-Graphs/
+
+	@INPROCEEDINGS{10.1109/Cluster48925.2021.00042,
+	  author={Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
+	  booktitle={2021 IEEE International Conference on Cluster Computing (CLUSTER)}, 
+	  title={Thrifty Label Propagation: Fast Connected Components for Skewed-Degree Graphs}, 
+	  year={2021},
+	  volume={},
+	  number={},
+	  pages={226-237},
+	  publisher={IEEE Computer Society},
+	  doi={10.1109/Cluster48925.2021.00042}
+	}
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: push max-degree
+		[9]: ID of vertex with max degree, i.e., with zero CC val.
+*/
+LL_T_VID* LL_T_CC_THRIFTY(struct par_env* pe, struct LL_T_GRAPH* g, unsigned int flags, unsigned long* exec_info, LL_T_VID* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31m%s\033[0;37m\n", __func__);
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+	
+	// Allocate memory
+		LL_T_VID* cc = numa_alloc_interleaved(sizeof(LL_T_VID) * g->vertices_count);
+		assert(cc != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		LL_T_VID* partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Zero Planting: Assigning the zero label to the vertex with max degree
+		unsigned long mt = - get_nano_time();
+		LL_T_VID max_degree_id = 0;
+		{
+			unsigned long max_vals[2] = {0,0};
+			unsigned long* threads_max_vals = calloc(sizeof(unsigned long), 2 * pe->threads_count);
+			assert(threads_max_vals != NULL);
+
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned long thread_max_vals[2] = {0,0};
+				unsigned int partition = -1U;
+				
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+
+					LL_T_CURSOR(g, c, partitions[partition]);
+					for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						cc[v] = v + 1;
+
+						LL_T_NEIGHBOURS it;
+						LL_T_CURSOR_NEXT(g, c, it, v);
+						unsigned long degree = LL_T_DEGREE(g, it, v);
+						if(degree > thread_max_vals[0])
+						{
+							thread_max_vals[0] = degree;
+							thread_max_vals[1] = v;
+						}
+					}
+				}
+
+				threads_max_vals[2 * tid] = thread_max_vals[0];
+				threads_max_vals[2 * tid + 1] = thread_max_vals[1];
+
+				ttimes[tid] += get_nano_time();
+			}
+			dynamic_partitioning_reset(dp);
+
+			// Update max_vals
+			for(unsigned int t = 0; t < pe->threads_count; t++)
+				if(threads_max_vals[2 * t] > max_vals[0])
+				{
+					max_vals[0] = threads_max_vals[2 * t];
+					max_vals[1] = threads_max_vals[2 * t + 1];
+				}
+			free(threads_max_vals);
+			threads_max_vals = NULL;
+
+			mt += get_nano_time();
+			if(flags & 1U)
+				PTIP("Zero Planting:");
+			printf("Max. degree: \t %'lu \t\t (ID: %'lu)\n", max_vals[0], max_vals[1]);
+			// Plant the zero label
+			cc[max_vals[1]] = 0;
+			max_degree_id = max_vals[1];
+			if(exec_info)
+				exec_info[9] = max_degree_id;
+		}
+
+	// Initial Push: Propagate the zero label to the neighbours of the max-degree vertex
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			// If the graph is being streamed, the neighbour-list of the max-degree vertex may not have been loaded yet
+			LL_T_STREAM_WAIT_VERTICES(g, max_degree_id, max_degree_id + 1);
+
+			LL_T_INITIAL_PUSH(g, cc, max_degree_id, tid);
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("Initial Push:");
+
+	// Pull iterations with Zero Convergence: 
+		// If a vertex has reached zero label, its label cannot be reduced => do not process it.
+		double frontier_density;
+		LL_T_VID next_vertices;
+		unsigned int cc_iter = 0;
+		do
+		{
+			unsigned long next_edges = 0;
+			next_vertices = 0;
+	
+			unsigned long mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				LL_T_VID thread_next_vertices = 0;
+				unsigned long thread_next_edges = 0;
+				unsigned int partition = -1U;		
+				
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+
+					// The first pull iteration consumes partitions of a streamed graph as soon as they are loaded
+					if(cc_iter == 0)
+					{
+						LL_T_STREAM_WAIT_VERTICES(g, partitions[partition], partitions[partition + 1]);
+					}
+
+					LL_T_CURSOR(g, c, partitions[partition]);
+					for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						LL_T_NEIGHBOURS it;
+						LL_T_CURSOR_NEXT(g, c, it, v);
+						unsigned long degree = LL_T_DEGREE(g, it, v);
+
+						LL_T_VID component = cc[v];
+						// Zero Convergence
+						if(!component)
+							continue;
+
+						LL_T_VID neighbour;
+						while(LL_T_NEXT_NEIGHBOUR(g, it, neighbour))
+						{
+							if(cc[neighbour] < component)
+							{
+								component = cc[neighbour];
+								// Zero Convergence
+								if(!component)
+									break;
+							}
+						}
+
+						if(component < cc[v])
+						{
+							cc[v] = component;
+							thread_next_vertices++;
+							thread_next_edges += degree;
+						}
+					}
+				}
+
+				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
+				__sync_fetch_and_add(&next_edges, thread_next_edges, __ATOMIC_SEQ_CST);
+				
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+
+			frontier_density = 1.0 * (next_vertices + next_edges) / g->edges_count;
+			if(flags & 1U)
+			{
+				char temp[255];
+				if(next_vertices < 100)
+					sprintf(temp, "Pull %'3u, |F|: %5lu, Dns: %'5.2f, time:", cc_iter, (unsigned long)next_vertices, frontier_density);
+				else
+					sprintf(temp, "Pull %'3u, |F|: %'4.1f%, Dns: %'5.2f, time:", cc_iter, 100.0 * next_vertices/g->vertices_count, frontier_density);
+				PTIP(temp);
+			}
+			cc_iter++;
+		}while(frontier_density >= 0.01);
+
+	// Allocating memory for the shared worklists
+		/*
+			We implement worklists as a shared SPF (Sequentially Partially Filled) array between threads. 
+			Since push iterations are sparse, we dedicate a chunk (with a size of cacheline, i.e., 16 uints) to each thread and after filling it we allocate another chunk. This way, we do not need to allocate per thread worklist. 
+			
+			The another point is about tiling. The initial implementation of thrifty used the 
+			edge-tiling [Galois, DOI:10.1145/2517349.2522739] in the push iterations to allow
+			concurrent processing of blocks of edges of vertices with large degrees. However, in the 
+			push direction, we do not expect to see very high degree vertices and we do not use edge-tiling in this implementation. 
+
+			Although, it is possible to add edge-tiling using the current data structure of worklist. To that target, we can perform edge-tiling before submitting vertices to the worklist: we can check degree of vertex and if it can be divided, we write multiple entries in the worklist, one for each tile. 
+			In that case, We will need 3 `unsigned long`s per each tile: (vertex_id, start_neighbour_offset, end_neighbour_offset). 
+			
+			The `df` and `next_df` are used as byte array frontiers to identify if a vertex has been 
+			previously stored in the worklist. We do not use atomics for accessing `df` as it is correct to process a 
+			vertex multiple times in a CC iteration. 
+		*/
+
+		unsigned int waspr = 16;  // worklist_allocation_size_per_request
+		LL_T_VID worklist_size = max(2 * next_vertices + waspr * pe->threads_count, 1024U * 1024);
+		
+		LL_T_VID* worklist = numa_alloc_interleaved(sizeof(LL_T_VID) * worklist_size);
+		LL_T_VID worklist_length = waspr * pe->threads_count;				 // initial allocation per thread
+		
+		LL_T_VID* next_worklist = numa_alloc_interleaved(sizeof(LL_T_VID) * worklist_size);
+		LL_T_VID next_worklist_length = waspr * pe->threads_count;    // initial allocation per thread
+
+		unsigned char* df = numa_alloc_interleaved(sizeof(unsigned char) * g->vertices_count);
+		unsigned char* next_df = numa_alloc_interleaved(sizeof(unsigned char) * g->vertices_count);
+		assert(worklist != NULL && next_worklist != NULL && df != NULL && next_df != NULL);
+
+	// Pull-Frontier: One more pull iteration to store active vertices into worklist
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+
+			LL_T_VID thread_worklist_index = tid * waspr;
+			LL_T_VID thread_worklist_end = (tid + 1) * waspr;
+			
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				LL_T_CURSOR(g, c, partitions[partition]);
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					LL_T_NEIGHBOURS it;
+					LL_T_CURSOR_NEXT(g, c, it, v);
+
+					LL_T_VID component = cc[v];
+					// Zero Convergence
+					if(!component)
+						continue;
+
+					LL_T_VID neighbour;
+					while(LL_T_NEXT_NEIGHBOUR(g, it, neighbour))
+					{
+						if(cc[neighbour] < component)
+						{
+							component = cc[neighbour];
+							// Zero Convergence
+							if(!component)
+								break;
+						}
+					}
+
+					// if new label has been found
+					if(component < cc[v])
+					{
+						cc[v] = component;
+
+						// set the frontier
+						if(df[v])
+							continue;
+
+						// add to worklist
+						df[v] = 1;
+						worklist[thread_worklist_index++] = v;
+						if(thread_worklist_index == thread_worklist_end)
+						{
+							// grab a new chunk
+							do
+							{
+								thread_worklist_index = worklist_length;
+								thread_worklist_end = thread_worklist_index + waspr;
+							}while(__sync_val_compare_and_swap(&worklist_length, thread_worklist_index, thread_worklist_end) != thread_worklist_index);
+							assert(worklist_length <= worklist_size);
+						}
+					}
+				}
+			}
+
+			// fill unused indecis with -1 to prevent from being processed in the next iteration
+			while(thread_worklist_index < thread_worklist_end)
+				worklist[thread_worklist_index++] = (LL_T_VID)-1;
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "Pull-Frontier, |F|: %'lu, time:", (unsigned long)worklist_length);
+			PTIP(temp);
+		}
+		cc_iter++;
+
+	// Push iterations
+		unsigned long push_max_degree = 0;
+		do
+		{
+			mt = - get_nano_time();
+			next_vertices = 0;
+
+			#pragma omp parallel  
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+			
+				LL_T_VID thread_next_worklist_index = tid * waspr;
+				LL_T_VID thread_next_worklist_end = (tid + 1) * waspr;
+				LL_T_VID thread_next_vertices = 0;
+
+				#pragma omp for nowait reduction(max:push_max_degree)
+				for(LL_T_VID index = 0; index < worklist_length; index++)
+				{
+					if(worklist[index] == (LL_T_VID)-1)
+						continue;
+
+					LL_T_VID v = worklist[index];
+					if(df[v] == 0)
+						continue;
+					df[v] = 0;
+
+					LL_T_NEIGHBOURS it;
+					LL_T_GET_NEIGHBOURS(g, it, v);
+					unsigned long degree = LL_T_DEGREE(g, it, v);
+					if(degree > push_max_degree)
+						push_max_degree = degree;
+
+					LL_T_VID neighbour;
+					while(LL_T_NEXT_NEIGHBOUR(g, it, neighbour))
+					{
+						unsigned int changed = 0;
+
+						while(1)
+						{
+							LL_T_VID cc_neighbour = cc[neighbour];
+							LL_T_VID cc_v = cc[v];
+							if(cc_neighbour <= cc_v)
+								break;
+
+							LL_T_VID prev_val = __sync_val_compare_and_swap(&cc[neighbour], cc_neighbour, cc_v);
+							if(prev_val == cc_neighbour)
+							{
+								changed = 1;
+								break;
+							}
+						}
+
+						if(!changed)
+							continue;
+
+						if(next_df[neighbour])
+							continue;
+
+						next_df[neighbour] = 1;
+						thread_next_vertices++;
+						next_worklist[thread_next_worklist_index++] = neighbour;
+						if(thread_next_worklist_index == thread_next_worklist_end)
+						{
+							// grab a new chunk
+							do
+							{
+								thread_next_worklist_index = next_worklist_length;
+								thread_next_worklist_end = thread_next_worklist_index + waspr;
+							}while(__sync_val_compare_and_swap(&next_worklist_length, thread_next_worklist_index, thread_next_worklist_end) != thread_next_worklist_index);
+							assert(next_worklist_length <= worklist_size);
+						}
+					}
+				}	
+
+				__sync_fetch_and_add(&next_vertices, thread_next_vertices, __ATOMIC_SEQ_CST);
+
+				// fill unused indecis with -1 to prevent from being processed in the next iteration
+				while(thread_next_worklist_index < thread_next_worklist_end)
+					next_worklist[thread_next_worklist_index++] = (LL_T_VID)-1;
+
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			if(flags & 1U)
+			{
+				char temp[255];
+				sprintf(temp, "Push, |F|: %5lu, time:", (unsigned long)next_vertices);
+				PTIP(temp);
+			}
+			cc_iter++;
+
+			// swapping
+				{
+					LL_T_VID* temp = worklist;
+					worklist = next_worklist;
+					next_worklist = temp;
+
+					worklist_length = next_worklist_length;
+					next_worklist_length = waspr * pe->threads_count;
+
+					unsigned char* temp2 = df;
+					df = next_df;
+					next_df = temp2;
+				}
+		}while(next_vertices);
+		if(flags & 1U)
+			printf("Max-degree in push iterations: \t\t%'lu\n", push_max_degree);
+		if(exec_info)
+			exec_info[8] = push_max_degree;
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			LL_T_VID ccs = 1;
+			#pragma omp parallel for reduction(+:ccs)
+			for(LL_T_VID v = 0; v < g->vertices_count; v++)
+				if(cc[v] == v + 1)
+					ccs++;
+			printf("|CCs|:            \t\t%'lu\n", (unsigned long)ccs);
+			*ccs_p = ccs;
+		}
+		
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+		numa_free(worklist, sizeof(LL_T_VID) * worklist_size);
+		worklist = NULL;
+		numa_free(next_worklist, sizeof(LL_T_VID) * worklist_size);
+		next_worklist = NULL;
+		numa_free(df, sizeof(unsigned char) * g->vertices_count);
+		df = NULL;
+		numa_free(next_df, sizeof(unsigned char) * g->vertices_count);
+		next_df = NULL;
+
+	return cc;
+}
+
+#ifdef LL_T_CC_RELEASE
+void LL_T_CC_RELEASE(struct LL_T_GRAPH* g, LL_T_VID* cc)
+{
+	assert(cc != NULL && g != NULL);
+	numa_free(cc, sizeof(LL_T_VID) * g->vertices_count);
+	return;
+}
+#endif
+
+#undef LL_T_GRAPH
+#undef LL_T_VID
+#undef LL_T_PARALLEL_EDGE_PARTITIONING
+#undef LL_T_STREAM_WAIT_VERTICES
+#undef LL_T_CC_THRIFTY
+#undef LL_T_CC_RELEASE
+#undef LL_T_NEIGHBOURS
+#undef LL_T_CURSOR
+#undef LL_T_CURSOR_NEXT
+#undef LL_T_GET_NEIGHBOURS
+#undef LL_T_DEGREE
+#undef LL_T_NEXT_NEIGHBOUR
+#undef LL_T_INITIAL_PUSH
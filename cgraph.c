@@ -0,0 +1,452 @@
+#ifndef __CGRAPH_C
+#define __CGRAPH_C
+
+// This file contains the compressed in-memory CSR graph (ll_c400), its encoder, decoder, and traversal functions
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <assert.h>
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+
+/*
+	Compressed CSR with 4 Bytes vertex IDs, without weights on edges or vertices.
+
+	The neighbour-lists should be sorted. The neighbour-list of vertex `v` is stored in `data` as:
+		varint(degree)
+		if degree > 0:
+			varint(number of bytes of the following neighbours)
+			zigzag-varint(first neighbour - v)
+			varint(gap to the previous neighbour) for the next (degree - 1) neighbours
+
+	Varints are byte-aligned (LEB128) with 7 bits of value per byte, so the gaps of the sorted neighbour-lists
+	of web graphs and relabelled graphs mostly take one byte.
+
+	Instead of the 8 Bytes per vertex offsets_list, only the offsets of one in every `LL_C400_SAMPLE` vertices are stored:
+		`vertex_samples[s]`: index of the first byte of the neighbour-list of vertex `s * LL_C400_SAMPLE` in `data`
+		`edge_samples[s]`: number of edges before vertex `s * LL_C400_SAMPLE`, i.e., its `offsets_list` in the CSR
+	Both arrays have `samples_count + 1` elements. The last element covers the end of the graph.
+
+	`data` is padded by `LL_C400_PADDING` zero bytes to allow the decoder to read 8 Bytes words at the end of the data.
+
+	Kernels decode neighbour-lists in batches of (at most) `LL_C400_BATCH` neighbours into a buffer on the stack.
+*/
+
+#define LL_C400_SAMPLE 64
+#define LL_C400_PADDING 16
+#define LL_C400_BATCH 256
+
+struct ll_c400_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long bytes_count;
+	unsigned long max_degree;
+	unsigned long samples_count;
+	unsigned long* vertex_samples;
+	unsigned long* edge_samples;
+	unsigned char* data;
+};
+
+/*
+	The cursor to traverse consecutive vertices.
+	`ll_c400_cursor_init()` moves the cursor to a vertex. If the vertex is not a sampled vertex, the neighbour-lists
+	of the previous vertices of the sample are skipped by reading their headers.
+	`ll_c400_cursor_next()` returns the degree of the next vertex, initializes `list` to decode its neighbours, and
+	moves the cursor to the next vertex.
+*/
+struct ll_c400_cursor
+{
+	unsigned char* p;
+	unsigned int vertex;
+};
+
+// The neighbours of a vertex that have not yet been decoded
+struct ll_c400_list
+{
+	unsigned char* p;
+	unsigned long remaining;
+	unsigned int last;
+	unsigned int first;
+};
+
+unsigned int __ll_c400_varint_size(unsigned long val)
+{
+	unsigned int size = 1;
+	while(val >= 128)
+	{
+		val >>= 7;
+		size++;
+	}
+
+	return size;
+}
+
+unsigned char* __ll_c400_write_varint(unsigned char* p, unsigned long val)
+{
+	while(val >= 128)
+	{
+		*p++ = (unsigned char)(val | 128);
+		val >>= 7;
+	}
+	*p++ = (unsigned char)val;
+
+	return p;
+}
+
+unsigned char* __ll_c400_read_varint(unsigned char* p, unsigned long* val_p)
+{
+	unsigned long val = *p++;
+	if(val < 128)
+	{
+		*val_p = val;
+		return p;
+	}
+
+	val &= 127;
+	unsigned int shift = 7;
+	while(1)
+	{
+		unsigned long b = *p++;
+		val |= (b & 127) << shift;
+		if(b < 128)
+			break;
+		shift += 7;
+	}
+	*val_p = val;
+
+	return p;
+}
+
+unsigned long __ll_c400_zigzag(long val)
+{
+	return (unsigned long)((val << 1) ^ (val >> 63));
+}
+
+long __ll_c400_unzigzag(unsigned long val)
+{
+	return (long)(val >> 1) ^ -(long)(val & 1);
+}
+
+// Returns the number of bytes of the encoded neighbour-list of `v` including its header
+unsigned long __ll_c400_list_size(struct ll_400_graph* g, unsigned int v)
+{
+	unsigned long degree = g->offsets_list[v + 1] - g->offsets_list[v];
+	if(degree == 0)
+		return 1;
+
+	unsigned long bytes = __ll_c400_varint_size(__ll_c400_zigzag((long)g->edges_list[g->offsets_list[v]] - v));
+	for(unsigned long e = g->offsets_list[v] + 1; e < g->offsets_list[v + 1]; e++)
+	{
+		assert(g->edges_list[e] >= g->edges_list[e - 1] && "Neighbour-lists should be sorted.");
+		bytes += __ll_c400_varint_size(g->edges_list[e] - g->edges_list[e - 1]);
+	}
+
+	return __ll_c400_varint_size(degree) + __ll_c400_varint_size(bytes) + bytes;
+}
+
+unsigned char* __ll_c400_write_list(struct ll_400_graph* g, unsigned int v, unsigned char* p)
+{
+	unsigned long degree = g->offsets_list[v + 1] - g->offsets_list[v];
+	p = __ll_c400_write_varint(p, degree);
+	if(degree == 0)
+		return p;
+
+	unsigned long bytes = __ll_c400_varint_size(__ll_c400_zigzag((long)g->edges_list[g->offsets_list[v]] - v));
+	for(unsigned long e = g->offsets_list[v] + 1; e < g->offsets_list[v + 1]; e++)
+		bytes += __ll_c400_varint_size(g->edges_list[e] - g->edges_list[e - 1]);
+	p = __ll_c400_write_varint(p, bytes);
+
+	p = __ll_c400_write_varint(p, __ll_c400_zigzag((long)g->edges_list[g->offsets_list[v]] - v));
+	for(unsigned long e = g->offsets_list[v] + 1; e < g->offsets_list[v + 1]; e++)
+		p = __ll_c400_write_varint(p, g->edges_list[e] - g->edges_list[e - 1]);
+
+	return p;
+}
+
+void ll_c400_cursor_init(struct ll_c400_graph* g, struct ll_c400_cursor* c, unsigned int v)
+{
+	assert(v <= g->vertices_count);
+
+	unsigned long s = v / LL_C400_SAMPLE;
+	unsigned char* p = g->data + g->vertex_samples[s];
+	for(unsigned int u = s * LL_C400_SAMPLE; u < v; u++)
+	{
+		unsigned long degree;
+		p = __ll_c400_read_varint(p, &degree);
+		if(degree)
+		{
+			unsigned long bytes;
+			p = __ll_c400_read_varint(p, &bytes);
+			p += bytes;
+		}
+	}
+
+	c->p = p;
+	c->vertex = v;
+
+	return;
+}
+
+unsigned long ll_c400_cursor_next(struct ll_c400_cursor* c, struct ll_c400_list* list)
+{
+	unsigned long degree;
+	c->p = __ll_c400_read_varint(c->p, &degree);
+
+	list->remaining = degree;
+	list->last = c->vertex;
+	list->first = 1;
+	if(degree)
+	{
+		unsigned long bytes;
+		c->p = __ll_c400_read_varint(c->p, &bytes);
+		list->p = c->p;
+		c->p += bytes;
+	}
+	else
+		list->p = c->p;
+	c->vertex++;
+
+	return degree;
+}
+
+// Returns the degree of `v` and initializes `list` to decode its neighbours
+unsigned long ll_c400_get_list(struct ll_c400_graph* g, unsigned int v, struct ll_c400_list* list)
+{
+	struct ll_c400_cursor c;
+	ll_c400_cursor_init(g, &c, v);
+
+	return ll_c400_cursor_next(&c, list);
+}
+
+/*
+	Decodes at most `max_count` of the remaining neighbours of `list` into `neighbours`
+	and returns the number of decoded neighbours.
+
+	When 8 consecutive gaps fit in one byte, i.e., the 8 Bytes word has no continuation bits,
+	they are decoded together without branching on each byte. For gap-encoded sorted lists this is the common case.
+*/
+unsigned long ll_c400_decode(struct ll_c400_list* list, unsigned int* neighbours, unsigned long max_count)
+{
+	unsigned long count = min(list->remaining, max_count);
+	unsigned char* p = list->p;
+	unsigned int last = list->last;
+	unsigned long i = 0;
+
+	if(count && list->first)
+	{
+		unsigned long val;
+		p = __ll_c400_read_varint(p, &val);
+		last = (unsigned int)((long)last + __ll_c400_unzigzag(val));
+		neighbours[i++] = last;
+		list->first = 0;
+	}
+
+	while(i < count)
+	{
+		if(i + 8 <= count)
+		{
+			unsigned long w;
+			memcpy(&w, p, 8);
+			if((w & 0x8080808080808080UL) == 0)
+			{
+				neighbours[i + 0] = last += (unsigned int)(w & 127);
+				neighbours[i + 1] = last += (unsigned int)((w >> 8) & 127);
+				neighbours[i + 2] = last += (unsigned int)((w >> 16) & 127);
+				neighbours[i + 3] = last += (unsigned int)((w >> 24) & 127);
+				neighbours[i + 4] = last += (unsigned int)((w >> 32) & 127);
+				neighbours[i + 5] = last += (unsigned int)((w >> 40) & 127);
+				neighbours[i + 6] = last += (unsigned int)((w >> 48) & 127);
+				neighbours[i + 7] = last += (unsigned int)((w >> 56) & 127);
+				p += 8;
+				i += 8;
+				continue;
+			}
+		}
+
+		unsigned long val;
+		p = __ll_c400_read_varint(p, &val);
+		last += (unsigned int)val;
+		neighbours[i++] = last;
+	}
+
+	list->p = p;
+	list->last = last;
+	list->remaining -= count;
+
+	return count;
+}
+
+/*
+	Compresses the graph `g` that should have sorted neighbour-lists.
+	`g` is not released.
+
+	flags:
+		bit 0: print stats
+		bit 1: validate the compressed graph by decoding it and comparing with `g`
+*/
+struct ll_c400_graph* compress_ll_400_graph(struct par_env* pe, struct ll_400_graph* g, unsigned int flags)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;36mcompress_ll_400_graph\033[0;37m\n");
+
+		struct ll_c400_graph* cg = calloc(sizeof(struct ll_c400_graph), 1);
+		assert(cg != NULL);
+		cg->vertices_count = g->vertices_count;
+		cg->edges_count = g->edges_count;
+		cg->samples_count = (g->vertices_count + LL_C400_SAMPLE - 1) / LL_C400_SAMPLE;
+
+		cg->vertex_samples = numa_alloc_interleaved(sizeof(unsigned long) * (cg->samples_count + 1));
+		cg->edge_samples = numa_alloc_interleaved(sizeof(unsigned long) * (cg->samples_count + 1));
+		assert(cg->vertex_samples != NULL && cg->edge_samples != NULL);
+
+	// (1) Calculating size of the samples
+		unsigned long max_degree = 0;
+		#pragma omp parallel for schedule(dynamic, 64) reduction(max: max_degree)
+		for(unsigned long s = 0; s < cg->samples_count; s++)
+		{
+			unsigned long bytes = 0;
+			unsigned int end = min(g->vertices_count, (s + 1) * LL_C400_SAMPLE);
+			for(unsigned int v = s * LL_C400_SAMPLE; v < end; v++)
+			{
+				bytes += __ll_c400_list_size(g, v);
+				if(g->offsets_list[v + 1] - g->offsets_list[v] > max_degree)
+					max_degree = g->offsets_list[v + 1] - g->offsets_list[v];
+			}
+			cg->vertex_samples[s + 1] = bytes;
+			cg->edge_samples[s] = g->offsets_list[s * LL_C400_SAMPLE];
+		}
+		cg->max_degree = max_degree;
+		cg->edge_samples[cg->samples_count] = g->edges_count;
+
+	// (2) Prefix sum
+		cg->vertex_samples[0] = 0;
+		for(unsigned long s = 1; s <= cg->samples_count; s++)
+			cg->vertex_samples[s] += cg->vertex_samples[s - 1];
+		cg->bytes_count = cg->vertex_samples[cg->samples_count];
+
+	// (3) Encoding
+		cg->data = numa_alloc_interleaved(cg->bytes_count + LL_C400_PADDING);
+		assert(cg->data != NULL);
+		memset(cg->data + cg->bytes_count, 0, LL_C400_PADDING);
+
+		#pragma omp parallel for schedule(dynamic, 64)
+		for(unsigned long s = 0; s < cg->samples_count; s++)
+		{
+			unsigned char* p = cg->data + cg->vertex_samples[s];
+			unsigned int end = min(g->vertices_count, (s + 1) * LL_C400_SAMPLE);
+			for(unsigned int v = s * LL_C400_SAMPLE; v < end; v++)
+				p = __ll_c400_write_list(g, v, p);
+			assert(p == cg->data + cg->vertex_samples[s + 1]);
+		}
+
+	// (4) Validating
+		if(flags & 2U)
+		{
+			#pragma omp parallel
+			{
+				unsigned int neighbours[LL_C400_BATCH];
+
+				#pragma omp for schedule(dynamic, 64)
+				for(unsigned long s = 0; s < cg->samples_count; s++)
+				{
+					struct ll_c400_cursor c;
+					ll_c400_cursor_init(cg, &c, s * LL_C400_SAMPLE);
+					unsigned int end = min(g->vertices_count, (s + 1) * LL_C400_SAMPLE);
+					for(unsigned int v = s * LL_C400_SAMPLE; v < end; v++)
+					{
+						struct ll_c400_list list;
+						unsigned long degree = ll_c400_cursor_next(&c, &list);
+						assert(degree == g->offsets_list[v + 1] - g->offsets_list[v]);
+
+						unsigned long e = g->offsets_list[v];
+						unsigned long count;
+						while((count = ll_c400_decode(&list, neighbours, LL_C400_BATCH)))
+							for(unsigned long i = 0; i < count; i++, e++)
+								assert(neighbours[i] == g->edges_list[e]);
+						assert(e == g->offsets_list[v + 1]);
+					}
+					assert(c.p == cg->data + cg->vertex_samples[s + 1]);
+				}
+			}
+			printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		if(flags & 1U)
+		{
+			unsigned long csr_bytes = sizeof(unsigned long) * (g->vertices_count + 1) + sizeof(unsigned int) * g->edges_count;
+			unsigned long c400_bytes = cg->bytes_count + 2 * sizeof(unsigned long) * (cg->samples_count + 1);
+			printf("CSR size:         \t\t %'.1f (MB)\n", csr_bytes / 1e6);
+			printf("Compressed size:  \t\t %'.1f (MB)\n", c400_bytes / 1e6);
+			printf("Compression ratio:\t\t %.2f\n", 1.0 * csr_bytes / c400_bytes);
+			printf("Bits per edge:    \t\t %.2f\n", 8.0 * cg->bytes_count / max(1, g->edges_count));
+		}
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n", t0/1e6);
+
+	return cg;
+}
+
+void release_ll_c400_graph(struct ll_c400_graph* g)
+{
+	assert(g != NULL);
+
+	numa_free(g->data, g->bytes_count + LL_C400_PADDING);
+	g->data = NULL;
+	numa_free(g->vertex_samples, sizeof(unsigned long) * (g->samples_count + 1));
+	g->vertex_samples = NULL;
+	numa_free(g->edge_samples, sizeof(unsigned long) * (g->samples_count + 1));
+	g->edge_samples = NULL;
+	free(g);
+	g = NULL;
+
+	return;
+}
+
+/*
+	Edge partitioning of the compressed graph.
+	The borders are aligned to the sampled vertices, so `ll_c400_cursor_init()` does not skip any neighbour-list
+	to reach the start of a partition.
+	`borders` has `partitions + 1` elements.
+*/
+int ll_c400_edge_partitioning(struct ll_c400_graph* g, unsigned int* borders, int partitions)
+{
+	assert(partitions > 0 && g->vertices_count > 0);
+
+	borders[0] = 0;
+	borders[partitions] = g->vertices_count;
+	unsigned long edges_per_partition = (g->edges_count + g->vertices_count) / partitions;
+
+	#pragma omp parallel for
+	for(unsigned int t = 1; t < partitions; t++)
+	{
+		// Finding the last sample with `edge_samples[s] + s * LL_C400_SAMPLE <= target`
+		unsigned long target = t * edges_per_partition;
+		unsigned long start = 0;
+		unsigned long end = g->samples_count;
+		while(start < end)
+		{
+			unsigned long m = (start + end + 1) / 2;
+			if(g->edge_samples[m] + m * LL_C400_SAMPLE <= target)
+				start = m;
+			else
+				end = m - 1;
+		}
+
+		borders[t] = min(g->vertices_count, start * LL_C400_SAMPLE);
+	}
+
+	for(unsigned int t = 1; t < partitions; t++)
+		if(borders[t] < borders[t - 1])
+			borders[t] = borders[t - 1];
+
+	return 0;
+}
+
+#endif
@@ -15,6 +15,8 @@
 #include <time.h>
 #include <pthread.h>
 #include <libgen.h>
+#include <sys/vfs.h>
+#include <linux/magic.h>
 
 #include "paragrapher.h"
 #include "omp.c"
@@ -50,6 +52,16 @@ struct ll_800_graph
 	unsigned long* edges_list;
 };
 
+// 4 Bytes ID per vertex and 4 Bytes offsets, without weights on edges or vertices
+// It is used for graphs with |E| < 2^32 to halve the size of the offsets_list, see `compact_ll_400_graph()`
+struct ll_400s_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned int* offsets_list;
+	unsigned int* edges_list;
+};
+
 void print_ll_400_graph(struct ll_400_graph* ret)
 {
 	printf("\n|V|: %'20lu\n|E|: %'20lu\n", ret->vertices_count, ret->edges_count);
@@ -81,7 +93,42 @@ void print_ll_400_graph(struct ll_400_graph* ret)
 	return;
 }
 
-char* get_shm_graph_name(char* file_name)
+void print_ll_800_graph(struct ll_800_graph* ret)
+{
+	printf("\n|V|: %'20lu\n|E|: %'20lu\n", ret->vertices_count, ret->edges_count);
+	printf("First offsets: ");
+	for(unsigned long v=0; v<min(ret->vertices_count + 1, 20); v++)
+		printf("%lu, ", ret->offsets_list[v]);
+	if(ret->vertices_count > 20)
+	{
+		printf("...\nLast offsets: ... ");
+		for(unsigned long v = ret->vertices_count - 20; v <= ret->vertices_count; v++)
+			printf(", %lu", ret->offsets_list[v]);
+	}
+
+	if(ret->edges_list)
+	{
+		printf("\nFirst edges: ");
+		for(unsigned long e=0; e<min(ret->edges_count, 20); e++)
+			printf("%lu, ", ret->edges_list[e]);
+		if(ret->edges_count > 20)
+		{
+			printf(" ...\nLast edges: ... ");
+			for(unsigned long e = ret->edges_count - 20; e < ret->edges_count; e++)
+				printf(", %lu", ret->edges_list[e]);
+		}
+	}
+
+	printf("\n\n");
+
+	return;
+}
+
+/*
+	Returns the absolute path of the file that stores the graph `file_name`. 
+	The returned string should be freed by the caller.
+*/
+char* get_graph_source_file(char* file_name)
 {
 	assert(file_name != NULL);
 
@@ -100,8 +147,13 @@ char* get_shm_graph_name(char* file_name)
 		{
 			// for weighted WebGraph graphs with .labels suffix
 			sprintf(cfn, "%s.labels", file_name);
-			int ra = access(cfn, F_OK);
-			assert(ra == 0);
+			if(access(cfn, F_OK) != 0)
+			{
+				// for CompBin graphs with _props.txt suffix
+				sprintf(cfn, "%s_props.txt", file_name);
+				int ra = access(cfn, F_OK);
+				assert(ra == 0);
+			}
 		}
 	}
 
@@ -112,6 +164,19 @@ char* get_shm_graph_name(char* file_name)
 		assert(ret != NULL && ret == abs_file_name);
 	}
 
+	if(cfn != file_name)
+	{
+		free(cfn);
+		cfn = NULL;
+	}
+
+	return abs_file_name;
+}
+
+char* get_shm_graph_name(char* file_name)
+{
+	char* abs_file_name = get_graph_source_file(file_name);
+
 	int len = strlen(abs_file_name);
 	char* ret = malloc(len + 16);
 	assert(ret != NULL);
@@ -124,17 +189,349 @@ char* get_shm_graph_name(char* file_name)
 	free(abs_file_name);
 	abs_file_name = NULL;
 
-	if(cfn != file_name)
+	return ret;
+}
+
+/*
+	Huge-page-backed shm graphs (`LL_SHM_HUGE_PAGES=1`)
+
+	If a hugetlbfs is mounted on `LL_SHM_HP_HUGETLBFS_PATH`, the graph is stored as a file in it. 
+	Otherwise, it is stored in /dev/shm and the mappings are advised (`MADV_HUGEPAGE`) to be backed 
+	by transparent huge pages which requires `/sys/kernel/mm/transparent_hugepage/shmem_enabled` to be 
+	`advise`, `within_size`, or `always`.
+
+	The object starts with a `struct ll_shm_hp_header` padded to `LL_SHM_HP_HEADER_SIZE` bytes, followed by
+	the offsets_list and the edges_list. The magic number is written last, after the data and the checksum,
+	so a partially written object is rejected. An object is also rejected (and unlinked) if its version, type,
+	|V|, |E|, the size or mtime of the source file of the graph, or its checksum do not match.
+
+	The name of the object is the name returned by `get_shm_graph_name()` with an `_hp` suffix.
+*/
+#define LL_SHM_HP_MAGIC            0x3130504852474c4cUL  // "LLGRHP01"
+#define LL_SHM_HP_VERSION          1U
+#define LL_SHM_HP_HEADER_SIZE      4096UL
+#define LL_SHM_HP_HUGETLBFS_PATH   "/dev/hugepages"
+#define LL_SHM_HP_THP_SIZE         (2UL << 20)
+
+struct ll_shm_hp_header
+{
+	unsigned long magic;
+	unsigned int version;
+	unsigned int graph_type;          // 400, 404, or 800
+	unsigned long source_size;
+	unsigned long source_mtime;       // in nanoseconds
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long graph_flags;        // bit 0: neighbour-lists are sorted, bit 1: graph is symmetric
+	unsigned long checksum;           // of the offsets_list and the edges_list
+	unsigned long mapping_size;
+	unsigned long page_size;
+	unsigned int hugetlbfs;
+};
+
+/*
+	Position-dependent checksum of `size` bytes of `mem` computed in parallel 
+	as the sum of the mixed 8-Byte words.
+*/
+unsigned long __ll_shm_hp_checksum(void* mem, unsigned long size)
+{
+	unsigned long* ul = (unsigned long*)mem;
+	unsigned long words = size / sizeof(unsigned long);
+	unsigned long cs = 0;
+
+	#pragma omp parallel for reduction(+:cs)
+	for(unsigned long i = 0; i <= words; i++)
 	{
-		free(cfn);
-		cfn = NULL;
+		unsigned long w = 0;
+		if(i < words)
+			w = ul[i];
+		else
+			memcpy(&w, ul + words, size % sizeof(unsigned long));
+
+		unsigned long x = w + (i + 1) * 0x9e3779b97f4a7c15UL;
+		x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9UL;
+		x = (x ^ (x >> 27)) * 0x94d049bb133111ebUL;
+		cs += x ^ (x >> 31);
 	}
 
-	return ret;
+	return cs;
+}
+
+/*
+	Opens the huge-page-backed object `hp_name` using `oflag` and sets `page_size` and `hugetlbfs`. 
+	Returns the file descriptor or -1.
+*/
+int __ll_shm_hp_open(char* hp_name, int oflag, unsigned long* page_size, unsigned int* hugetlbfs)
+{
+	struct statfs sfs;
+	if(statfs(LL_SHM_HP_HUGETLBFS_PATH, &sfs) == 0 && sfs.f_type == HUGETLBFS_MAGIC)
+	{
+		char path[PATH_MAX];
+		sprintf(path, "%s/%s", LL_SHM_HP_HUGETLBFS_PATH, hp_name);
+		*page_size = sfs.f_bsize;
+		*hugetlbfs = 1;
+
+		return open(path, oflag, 0644);
+	}
+
+	*page_size = LL_SHM_HP_THP_SIZE;
+	*hugetlbfs = 0;
+
+	return shm_open(hp_name, oflag, 0644);
+}
+
+int __ll_shm_hp_unlink(char* hp_name)
+{
+	struct statfs sfs;
+	if(statfs(LL_SHM_HP_HUGETLBFS_PATH, &sfs) == 0 && sfs.f_type == HUGETLBFS_MAGIC)
+	{
+		char path[PATH_MAX];
+		sprintf(path, "%s/%s", LL_SHM_HP_HUGETLBFS_PATH, hp_name);
+		return unlink(path);
+	}
+
+	return shm_unlink(hp_name);
+}
+
+char* __ll_shm_hp_name(char* file_name, unsigned int direct_name)
+{
+	char* shm_name = direct_name ? strdup(file_name) : get_shm_graph_name(file_name);
+	assert(shm_name != NULL);
+
+	char* hp_name = malloc(strlen(shm_name) + 8);
+	assert(hp_name != NULL);
+	sprintf(hp_name, "%s_hp", shm_name);
+
+	free(shm_name);
+	shm_name = NULL;
+
+	return hp_name;
+}
+
+void __ll_shm_hp_source_stat(char* file_name, unsigned long* size, unsigned long* mtime)
+{
+	char* source = get_graph_source_file(file_name);
+	struct stat st;
+	int ret = stat(source, &st);
+	assert(ret == 0);
+	*size = st.st_size;
+	*mtime = st.st_mtim.tv_sec * 1000UL * 1000 * 1000 + st.st_mtim.tv_nsec;
+
+	free(source);
+	source = NULL;
+
+	return;
+}
+
+/*
+	Maps the huge-page-backed object of `file_name` and validates its header.
+	Returns a pointer to the header or NULL if the object does not exist or is rejected.
+
+	`edges_bytes`: size of the edges_list in bytes
+*/
+struct ll_shm_hp_header* __ll_shm_hp_get_graph(char* file_name, unsigned int graph_type, unsigned long vertices_count, unsigned long edges_count, unsigned long edges_bytes)
+{
+	char* hp_name = __ll_shm_hp_name(file_name, 0);
+	printf("shm_name: %s\n", hp_name);
+
+	unsigned long page_size;
+	unsigned int hugetlbfs;
+	int fd = __ll_shm_hp_open(hp_name, O_RDONLY, &page_size, &hugetlbfs);
+	if(fd < 0)
+	{
+		free(hp_name);
+		hp_name = NULL;
+		return NULL;
+	}
+
+	struct stat st;
+	int ret = fstat(fd, &st);
+	assert(ret == 0);
+	
+	char* reason = NULL;
+	struct ll_shm_hp_header* hdr = NULL;
+	if(st.st_size < LL_SHM_HP_HEADER_SIZE)
+		reason = "truncated object";
+	else
+	{
+		hdr = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+		if(hdr == MAP_FAILED)
+		{
+			printf("Couldn't get graph -> mmap error : %d, %s\n", errno, strerror(errno) );
+			assert (hdr != MAP_FAILED);
+		}
+		if(!hugetlbfs)
+			madvise(hdr, st.st_size, MADV_HUGEPAGE);
+
+		unsigned long source_size, source_mtime;
+		__ll_shm_hp_source_stat(file_name, &source_size, &source_mtime);
+		unsigned long data_size = (vertices_count + 1) * sizeof(unsigned long) + edges_bytes;
+
+		if(__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != LL_SHM_HP_MAGIC)
+			reason = "incomplete object or wrong magic";
+		else if(hdr->version != LL_SHM_HP_VERSION || hdr->graph_type != graph_type)
+			reason = "different version or graph type";
+		else if(hdr->vertices_count != vertices_count || hdr->edges_count != edges_count || hdr->mapping_size != st.st_size)
+			reason = "different size";
+		else if(hdr->source_size != source_size || hdr->source_mtime != source_mtime)
+			reason = "source file has been modified";
+		else if(hdr->checksum != __ll_shm_hp_checksum((char*)hdr + LL_SHM_HP_HEADER_SIZE, data_size))
+			reason = "checksum mismatch";
+	}
+	close(fd);
+	fd = -1;
+
+	if(reason != NULL)
+	{
+		printf("\033[1;31mRejected shm graph\033[0;37m (%s), unlinking it.\n", reason);
+		if(hdr != NULL)
+			munmap(hdr, st.st_size);
+		hdr = NULL;
+		__ll_shm_hp_unlink(hp_name);
+	}
+	else
+		printf("Shared memory file exists (%s, page size: %'lu KB, sorted: %lu, symmetric: %lu).\n", 
+			hugetlbfs ? "hugetlbfs" : "THP", page_size / 1024, hdr->graph_flags & 1UL, (hdr->graph_flags >> 1) & 1UL);
+
+	free(hp_name);
+	hp_name = NULL;
+
+	return hdr;
+}
+
+/*
+	Stores a graph as a huge-page-backed object. 
+
+	`graph_type`: 400, 404, or 800
+	`flags`: flags of `store_shm_ll_400_graph()`
+*/
+int __ll_shm_hp_store_graph(char* file_name, unsigned int flags, unsigned int graph_type, unsigned long vertices_count, 
+	unsigned long edges_count, unsigned long* offsets_list, void* edges_list)
+{
+	assert(graph_type == 400 || graph_type == 404 || graph_type == 800);
+	char* hp_name = __ll_shm_hp_name(file_name, flags & 1U);
+	// number of `unsigned int`s per edge
+	unsigned int edges_stride = graph_type == 400 ? 1 : 2;
+	unsigned long edges_bytes = edges_count * edges_stride * sizeof(unsigned int);
+	unsigned long data_size = (vertices_count + 1) * sizeof(unsigned long) + edges_bytes;
+
+	unsigned long page_size;
+	unsigned int hugetlbfs;
+	int fd = __ll_shm_hp_open(hp_name, O_RDWR|O_CREAT|O_TRUNC, &page_size, &hugetlbfs);
+	if(fd < 0)
+	{
+		printf("__ll_shm_hp_store_graph(), error in opening %s: %d, %s .\n", hp_name, errno, strerror(errno));
+		free(hp_name);
+		hp_name = NULL;
+		return -1;
+	}
+
+	unsigned long mapping_size = (LL_SHM_HP_HEADER_SIZE + data_size + page_size - 1) / page_size * page_size;
+	int ret = ftruncate(fd, mapping_size);
+	void* mem = MAP_FAILED;
+	if(ret == 0)
+		mem = mmap(NULL, mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if(mem == MAP_FAILED)
+	{
+		printf("__ll_shm_hp_store_graph(), error in ftruncate()/mmap() %d, %s .\n", errno, strerror(errno));
+		close(fd);
+		fd = -1;
+		__ll_shm_hp_unlink(hp_name);
+		free(hp_name);
+		hp_name = NULL;
+		return -1;
+	}
+	if(!hugetlbfs)
+	{
+		int r0 = madvise(mem, mapping_size, MADV_HUGEPAGE);
+		if(r0 != 0)
+			printf("__ll_shm_hp_store_graph(), madvise(MADV_HUGEPAGE) failed %d, %s .\n", errno, strerror(errno));
+	}
+	numa_interleave_allocated_memory(mem, mapping_size);
+
+	// (1) Copying the graph and checking if the neighbour-lists are sorted
+		unsigned long* sg_offsets = (unsigned long*)((char*)mem + LL_SHM_HP_HEADER_SIZE);
+		unsigned int* sg_edges = (unsigned int*)(sg_offsets + vertices_count + 1);
+		unsigned int* ui_edges = (unsigned int*)edges_list;
+		unsigned long* ul_edges = (unsigned long*)edges_list;
+		unsigned long unsorted = 0;
+
+		#pragma omp parallel for reduction(+:unsorted)
+		for(unsigned long v = 0; v <= vertices_count; v++)
+		{
+			sg_offsets[v] = offsets_list[v];
+			if(v == vertices_count)
+				continue;
+			for(unsigned long e = offsets_list[v] + 1; e < offsets_list[v + 1]; e++)
+				if(graph_type == 800 ? ul_edges[e] < ul_edges[e - 1] : ui_edges[edges_stride * e] < ui_edges[edges_stride * (e - 1)])
+				{
+					unsorted++;
+					break;
+				}
+		}
+
+		#pragma omp parallel for 
+		for(unsigned long e = 0; e < edges_count * edges_stride; e++)
+			sg_edges[e] = ui_edges[e];
+
+	// (2) Writing the header and finally the magic
+		struct ll_shm_hp_header* hdr = (struct ll_shm_hp_header*)mem;
+		hdr->version = LL_SHM_HP_VERSION;
+		hdr->graph_type = graph_type;
+		if(flags & 1U)
+		{
+			hdr->source_size = 0;
+			hdr->source_mtime = 0;
+		}
+		else
+			__ll_shm_hp_source_stat(file_name, &hdr->source_size, &hdr->source_mtime);
+		hdr->vertices_count = vertices_count;
+		hdr->edges_count = edges_count;
+		hdr->graph_flags = (unsorted == 0 ? 1UL : 0UL) | (flags & 2U ? 2UL : 0UL);
+		hdr->checksum = __ll_shm_hp_checksum(sg_offsets, data_size);
+		hdr->mapping_size = mapping_size;
+		hdr->page_size = page_size;
+		hdr->hugetlbfs = hugetlbfs;
+		__atomic_store_n(&hdr->magic, LL_SHM_HP_MAGIC, __ATOMIC_RELEASE);
+
+		ret = msync(mem, mapping_size, MS_SYNC);
+		assert(ret == 0);
+
+		munmap(mem, mapping_size);
+		mem = NULL;
+
+		ret = fchmod(fd, S_IRUSR|S_IRGRP|S_IROTH);
+		assert(ret == 0);
+		close(fd);
+		fd = -1;
+
+	printf("Stored shm graph %s (%s, page size: %'lu KB, sorted: %u).\n", hp_name, hugetlbfs ? "hugetlbfs" : "THP", 
+		page_size / 1024, unsorted == 0);
+
+	free(hp_name);
+	hp_name = NULL;
+
+	return 0;
 }
 
 struct ll_400_graph* get_shm_ll_400_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
 {
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = __ll_shm_hp_get_graph(file_name, 400, vertices_count, edges_count, edges_count * sizeof(unsigned int));
+		if(hdr == NULL)
+			return NULL;
+
+		struct ll_400_graph* g = malloc(sizeof(struct ll_400_graph));
+		assert(g != NULL);
+		g->vertices_count = hdr->vertices_count;
+		g->edges_count = hdr->edges_count;
+		g->offsets_list = (unsigned long*)((char*)hdr + LL_SHM_HP_HEADER_SIZE);
+		g->edges_list = (unsigned int*)(g->offsets_list + g->vertices_count + 1);
+
+		return g;
+	}
+
 	char* shm_name = get_shm_graph_name(file_name);
 	printf("shm_name: %s\n", shm_name);
 	unsigned long graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + edges_count * sizeof(unsigned int);
@@ -168,6 +565,109 @@ struct ll_400_graph* get_shm_ll_400_graph(char* file_name, unsigned long vertice
 	return g;
 }
 
+/*
+	Parses the space-separated numbers in the [`start`, `end`) range of `mem` in parallel.
+	The range is divided into chunks whose borders are moved forward to the first separator, 
+	so each number belongs to the chunk it starts in. In the first pass, the numbers in each chunk 
+	are counted and after a prefix sum, the numbers are written in the second pass 
+	to `out_ul` (if not NULL) or to `out_ui` (if not NULL).
+
+	Returns the number of numbers in the range.
+*/
+unsigned long __ll_txt_parallel_parse(char* mem, unsigned long start, unsigned long end, unsigned long* out_ul, unsigned int* out_ui)
+{
+	if(end <= start)
+		return 0;
+
+	unsigned int chunks_count = 64 * omp_get_max_threads();
+	if((end - start) / chunks_count < 4096)
+		chunks_count = 1 + (end - start) / 4096;
+
+	unsigned long* borders = calloc(sizeof(unsigned long), chunks_count + 1);
+	assert(borders != NULL);
+	unsigned long* counts = calloc(sizeof(unsigned long), chunks_count + 1);
+	assert(counts != NULL);
+
+	// (1) Identifying borders of the chunks
+		borders[0] = start;
+		borders[chunks_count] = end;
+		#pragma omp parallel for
+		for(unsigned int c = 1; c < chunks_count; c++)
+		{
+			unsigned long b = start + (end - start) / chunks_count * c;
+			while(b < end && mem[b - 1] >= '0' && mem[b - 1] <= '9')
+				b++;
+			borders[c] = b;
+		}
+
+	// (2) Counting numbers in each chunk
+		#pragma omp parallel for schedule(dynamic)
+		for(unsigned int c = 0; c < chunks_count; c++)
+		{
+			unsigned long count = 0;
+			unsigned int prev_is_digit = 0;
+			for(unsigned long i = borders[c]; i < borders[c + 1]; i++)
+			{
+				unsigned int is_digit = mem[i] >= '0' && mem[i] <= '9';
+				if(is_digit && !prev_is_digit)
+					count++;
+				prev_is_digit = is_digit;
+			}
+			counts[c] = count;
+		}
+
+	// (3) Prefix sum
+		unsigned long total_count = 0;
+		for(unsigned int c = 0; c < chunks_count; c++)
+		{
+			unsigned long temp = counts[c];
+			counts[c] = total_count;
+			total_count += temp;
+		}
+		counts[chunks_count] = total_count;
+
+	// (4) Writing the numbers
+		if(out_ul != NULL || out_ui != NULL)
+		{
+			#pragma omp parallel for schedule(dynamic)
+			for(unsigned int c = 0; c < chunks_count; c++)
+			{
+				unsigned long index = counts[c];
+				unsigned long val = 0;
+				unsigned int val_length = 0;
+				for(unsigned long i = borders[c]; i <= borders[c + 1]; i++)
+				{
+					if(i < borders[c + 1] && mem[i] >= '0' && mem[i] <= '9')
+					{
+						val = val * 10 + (mem[i] - '0');
+						val_length++;
+					}
+					else if(val_length)
+					{
+						if(out_ul != NULL)
+							out_ul[index++] = val;
+						else
+						{
+							assert(val < (1UL<<32));
+							out_ui[index++] = val;
+						}
+						val = 0;
+						val_length = 0;
+					}
+				}
+				assert(index == counts[c + 1]);
+			}
+		}
+
+	// Releasing mem
+		free(borders);
+		borders = NULL;
+		free(counts);
+		counts = NULL;
+
+	return total_count;
+}
+
 /*
 	`flags`:
 		bit 0: 
@@ -189,23 +689,49 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 			return NULL;
 		}
 
-	// Reading vertices and edges count and graph size
+	// Mapping the file
+		unsigned long file_size = get_file_size(file_name);
+		char* mem = NULL;
+		{
+			int fd = open(file_name, O_RDONLY);
+			if(fd < 0)
+			{
+				printf("Can't open the file: %d - %s\n",errno,strerror(errno));
+				return NULL;
+			}
+
+			mem = mmap(NULL, file_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(mem == MAP_FAILED)
+			{
+				printf("Couldn't mmap the file: %d, %s\n", errno, strerror(errno));
+				assert(mem != MAP_FAILED);
+			}
+			close(fd);
+			fd = -1;
+		}
+
+	// Reading vertices and edges count from the first two lines
 		unsigned long vertices_count = 0;
-		unsigned long edges_count = 0;	
+		unsigned long edges_count = 0;
+		unsigned long offsets_start = 0;
 		{
-			char temp[512];
-			sprintf(temp, "head -n1 %s", file_name);
-			FILE *fp = popen(temp, "r");
-			int ret = fscanf(fp, "%lu", &vertices_count);
-			assert(ret == 1);
-			pclose(fp);
-			printf("Vertices: %'lu\n",vertices_count);
+			unsigned long i = 0;
+			unsigned long* vals[] = {&vertices_count, &edges_count};
+			for(unsigned int l = 0; l < 2; l++)
+			{
+				unsigned int val_length = 0;
+				for(; i < file_size && mem[i] != '\n'; i++)
+					if(mem[i] >= '0' && mem[i] <= '9')
+					{
+						*vals[l] = *vals[l] * 10 + (mem[i] - '0');
+						val_length++;
+					}
+				assert(val_length > 0 && i < file_size);
+				i++;
+			}
+			offsets_start = i;
 
-			sprintf(temp, "head -n2 %s | tail -n1", file_name);
-			fp = popen(temp, "r");
-			ret = fscanf(fp, "%lu", &edges_count);
-			assert(ret == 1);
-			pclose(fp);
+			printf("Vertices: %'lu\n",vertices_count);
 			printf("Edges: %'lu\n",edges_count);
 		}
 
@@ -218,6 +744,9 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 				assert(vertices_count == g->vertices_count);
 				assert(edges_count == g->edges_count);
 
+				munmap(mem, file_size);
+				mem = NULL;
+
 				print_ll_400_graph(g);
 				*flags |= 1U<<31;
 				return g;
@@ -234,99 +763,47 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
 		assert(g->edges_list != NULL);
 		
-	// Reading graph from disk
+	// Parsing the graph in parallel
 	{
-		int fd=open(file_name, O_RDONLY | O_DIRECT);
-		if(fd<0)
-		{
-			printf("Can't open the file: %d - %s\n",errno,strerror(errno));
-			return NULL;
-		}
-
-		unsigned long buf_size=4096UL * 1024 * 24;
-		char* buf=malloc(sizeof(char)*buf_size);
-		assert(buf != NULL);
-		char* main_buff_address = buf;
-		
-		// 4096 alignment of buf for O_DIRECT
-		if((unsigned long)buf % 4096)
-		{
-			unsigned long excess = 4096 - (unsigned long)buf % 4096 ;
-			buf = (char*)((unsigned long)buf + excess);
-			buf_size -= 4096;
- 		}
-
-		long count=-1;
-
-		unsigned long val=0;
-		unsigned int val_length=0;
-		unsigned int status=0;
-
 		unsigned long t1=get_nano_time();
-		unsigned long vl_count=0;
-		unsigned long el_count=0;
-		unsigned long total_read_bytes = 0;
 
-		while((count=read(fd, buf, buf_size)) > 0)
+		// Identifying the end of offsets line (the first '\n' after `offsets_start`) 
+		unsigned long offsets_end = file_size;
 		{
-			total_read_bytes += count;
-			int i=0;
+			unsigned int chunks_count = 64 * omp_get_max_threads();
+			unsigned long chunk_size = (file_size - offsets_start) / chunks_count + 1;
 
-			while(i<count)
+			#pragma omp parallel for schedule(dynamic) reduction(min:offsets_end)
+			for(unsigned int c = 0; c < chunks_count; c++)
 			{
-				//if(i<50) printf("status: %d, v: %c\n",status,buf[i]);
-				if(buf[i]!='\n' && buf[i]!=' ')
-				{
-					val = val * 10 + (buf[i]-'0');
-					val_length++;
-				}
-				else if(val_length)
-				{
-					switch(status)
+				unsigned long s = offsets_start + chunk_size * c;
+				unsigned long e = min(s + chunk_size, file_size);
+				for(unsigned long i = s; i < e && i < offsets_end; i++)
+					if(mem[i] == '\n')
 					{
-						case 0:
-							assert(vertices_count == val);
-							break;
-
-						case 1:
-							assert(edges_count == val);
-							break;
-
-						case 2:
-							g->offsets_list[vl_count++]=val;
-							break;
-
-						case 3:
-							assert(val < (1UL<<32));
-							g->edges_list[el_count++]=val;
-							break;
+						offsets_end = i;
+						break;
 					}
-					val=0;
-					val_length=0;
-				}
-				
-				if(buf[i] == '\n')
-					status++;
-
-				i++;
-			}	
+			}
 		}
 
-		assert(count >= 0);
-		assert(el_count == edges_count);
+		unsigned long vl_count = __ll_txt_parallel_parse(mem, offsets_start, offsets_end, g->offsets_list, NULL);
 		assert(vl_count == vertices_count);
 
-		free(main_buff_address);
-		main_buff_address = NULL;
-		buf = NULL;
-		close(fd);
-		fd = -1;
+		unsigned long el_count = 0;
+		if(offsets_end < file_size)
+			el_count = __ll_txt_parallel_parse(mem, offsets_end + 1, file_size, NULL, g->edges_list);
+		assert(el_count == edges_count);
 
 		g->offsets_list[g->vertices_count]=g->edges_count;
 
-		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", total_read_bytes/1e6, (get_nano_time() - t1)/1e9); 
+		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", file_size/1e6, (get_nano_time() - t1)/1e9); 
 	}
 
+	// Releasing the mapped file
+		munmap(mem, file_size);
+		mem = NULL;
+
 	// Printing the first vals in the read graph
 		print_ll_400_graph(g);
 
@@ -338,24 +815,452 @@ struct ll_400_graph* get_ll_400_txt_graph(char* file_name, unsigned int* flags)
 	return g;	
 }
 
-void __ll_400_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
-{
-	void** args = (void**) in_args;
-	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
-	unsigned int* graph_edges = (unsigned int*)args[1];
+/*
+	Reads a graph stored in the CompBin format (e.g., by `alg11_compbin.c`).
+	`file_name` is the path to the graph without the `_props.txt` suffix.
+	The offsets and edges files are read by `par_read_file()` directly into
+	NUMA-interleaved memory.
 
-	unsigned long* offsets = (unsigned long*)in_offsets;
-	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
-	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
-	unsigned long* ul_in_edges = (unsigned long*)in_edges;
+	`flags`:
+		bit 0:
+			Read from storage. Do not use the copy in /dev/shm (if it exists).
 
-	// No need to parallelize this loop as multiple instances of this callback are concurrently called by the ParaGrapher 
-	for(unsigned long e = 0; e < ec; e++, dest_off++)
+		bit 31:
+			Will be set by the function if the graph has been mapped from a copy in /dev/shm.
+			This flag should be used for releasing the graph. If it is set, `release_shm_ll_400_graph()` should be called.
+			Otherwise, `release_numa_interleaved_ll_400_graph()` should be called.
+*/
+struct ll_400_graph* get_ll_400_compbin_graph(char* file_name, unsigned int* flags)
+{
+	// Checks
+		assert(flags != NULL && file_name != NULL);
+
+		char* props_file = malloc(PATH_MAX);
+		assert(props_file != NULL);
+		sprintf(props_file, "%s_props.txt", file_name);
+		if(access(props_file, F_OK) != 0)
+		{
+			printf("Error: file \"%s\" does not exist\n", props_file);
+			free(props_file);
+			props_file = NULL;
+
+			return NULL;
+		}
+
+	// Reading the props file
+		unsigned long vertices_count = -1UL;
+		unsigned long edges_count = -1UL;
+		unsigned int bytes_per_id = 0;
+		char* offsets_file = calloc(PATH_MAX, 1);
+		char* edges_file = calloc(PATH_MAX, 1);
+		assert(offsets_file != NULL && edges_file != NULL);
+		{
+			// The offsets and edges files are relative to the folder of the props file
+			char* temp = strdup(props_file);
+			assert(temp != NULL);
+			char* folder = dirname(temp);
+
+			FILE* f = fopen(props_file, "r");
+			assert(f != NULL);
+
+			char line[PATH_MAX];
+			while(fgets(line, PATH_MAX, f) != NULL)
+			{
+				line[strcspn(line, "\r\n")] = 0;
+				char* val = strchr(line, ':');
+				if(val == NULL)
+					continue;
+				*val = 0;
+				val++;
+
+				if(!strcmp(line, "vertices-count"))
+					vertices_count = strtoul(val, NULL, 10);
+				else if(!strcmp(line, "edges-count"))
+					edges_count = strtoul(val, NULL, 10);
+				else if(!strcmp(line, "bytes-per-vertex-ID-in-edges-file"))
+					bytes_per_id = atoi(val);
+				else if(!strcmp(line, "offsets-file"))
+					snprintf(offsets_file, PATH_MAX, "%s/%s", folder, val);
+				else if(!strcmp(line, "edges-file"))
+					snprintf(edges_file, PATH_MAX, "%s/%s", folder, val);
+			}
+
+			fclose(f);
+			f = NULL;
+			free(temp);
+			temp = NULL;
+			folder = NULL;
+		}
+
+		printf("Vertices: %'lu\n",vertices_count);
+		printf("Edges: %'lu\n",edges_count);
+		printf("Offsets file: %s\n", offsets_file);
+		printf("Edges file: %s\n", edges_file);
+
+		assert(vertices_count != -1UL && edges_count != -1UL);
+		assert(vertices_count < (1UL << 32));
+		if(bytes_per_id != 4)
+		{
+			assert(0 && "get_ll_400_compbin_graph() supports CompBin graphs with 4 Bytes ID per vertex.\n");
+			return NULL;
+		}
+		assert(get_file_size(offsets_file) == sizeof(unsigned long) * (1 + vertices_count));
+		assert(get_file_size(edges_file) == sizeof(unsigned int) * edges_count);
+
+	// Check if the graph exists in /dev/shm
+		if((*flags & 1U<<0) == 0)
+		{
+			struct ll_400_graph* g = get_shm_ll_400_graph(file_name, vertices_count, edges_count);
+			if(g != NULL)
+			{
+				assert(vertices_count == g->vertices_count);
+				assert(edges_count == g->edges_count);
+
+				free(props_file);
+				free(offsets_file);
+				free(edges_file);
+				props_file = NULL;
+				offsets_file = NULL;
+				edges_file = NULL;
+
+				print_ll_400_graph(g);
+				*flags |= 1U<<31;
+				return g;
+			}
+		}
+
+	// Allocate memory
+		struct ll_400_graph* g =calloc(sizeof(struct ll_400_graph),1);
+		assert(g != NULL);
+		g->vertices_count = vertices_count;
+		g->edges_count = edges_count;
+		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(g->offsets_list != NULL);
+		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+		assert(g->edges_list != NULL);
+
+	// Reading graph from storage
+	{
+		unsigned long t1 = get_nano_time();
+
+		/*
+			As the files are read from offset 0 and `numa_alloc_interleaved()` returns page-aligned memory,
+			`par_read_file()` fills the arrays in-place and does not require the extra 2 * 4096 Bytes.
+		*/
+		char* mem = par_read_file(offsets_file, 0, sizeof(unsigned long) * (1 + vertices_count), (char*)g->offsets_list);
+		assert(mem == (char*)g->offsets_list);
+
+		mem = par_read_file(edges_file, 0, sizeof(unsigned int) * edges_count, (char*)g->edges_list);
+		assert(mem == (char*)g->edges_list);
+		mem = NULL;
+
+		assert(g->offsets_list[0] == 0);
+		assert(g->offsets_list[vertices_count] == edges_count);
+
+		unsigned long total_read_bytes = sizeof(unsigned long) * (1 + vertices_count) + sizeof(unsigned int) * edges_count;
+		printf("Reading %'.1f (MB) completed in %'.3f (seconds)\n", total_read_bytes/1e6, (get_nano_time() - t1)/1e9);
+	}
+
+	// Releasing mem
+		free(props_file);
+		free(offsets_file);
+		free(edges_file);
+		props_file = NULL;
+		offsets_file = NULL;
+		edges_file = NULL;
+
+	// Printing the first vals in the read graph
+		print_ll_400_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	*flags &= ~(1U<<31);
+
+	return g;
+}
+
+/*
+	Shared between a webgraph loader and its callbacks. The callbacks report the progress and 
+	the callback that completes the last edge block raises `finished` and wakes the loader through futex.
+*/
+struct __ll_webgraph_read_status
+{
+	unsigned long edges_count;
+	unsigned long completed_edges;
+	unsigned long completed_callbacks_count;
+	unsigned long next_edge_limit_print;
+	unsigned int finished;
+};
+
+void __ll_webgraph_block_completed(struct __ll_webgraph_read_status* rs, unsigned long ec)
+{
+	unsigned long cc = __atomic_add_fetch(&rs->completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+	unsigned long ce = __atomic_add_fetch(&rs->completed_edges, ec, __ATOMIC_ACQ_REL);
+
+	// Reporting the progress by the callback that passes the limit
+	unsigned long limit = rs->next_edge_limit_print;
+	if(ce >= limit && ce < rs->edges_count)
+		if(__sync_bool_compare_and_swap(&rs->next_edge_limit_print, limit, ce + 0.05 * rs->edges_count))
+		{
+			time_t t = time(NULL);
+			struct tm tm;
+			localtime_r(&t, &tm);
+			char timebuf[32];
+			strftime(timebuf, sizeof(timebuf), "%y/%m/%d %H:%M:%S", &tm);
+
+			printf("  [%s] Reading ..., read_edges: %'15lu (%.1f%%), completed callbacks: %'lu .\n", 
+				timebuf, ce, 100.0 * ce / rs->edges_count, cc);
+		}
+
+	// Signaling the loader
+	if(ce == rs->edges_count)
+	{
+		__atomic_store_n(&rs->finished, 1U, __ATOMIC_RELEASE);
+		futex_wake_all(&rs->finished);
+	}
+
+	return;
+}
+
+/*
+	Waits until all edge blocks requested by `req` have been processed by the callbacks. 
+	The futex wait is timed to check if ParaGrapher has failed reading the graph.
+*/
+void __ll_webgraph_wait_for_blocks(paragrapher_graph* graph, paragrapher_read_request* req, struct __ll_webgraph_read_status* rs)
+{
+	long status = 0;
+	void* op0_args []= {req, &status};
+
+	while(rs->edges_count != 0 && __atomic_load_n(&rs->finished, __ATOMIC_ACQUIRE) == 0)
+	{
+		struct timespec ts = {1, 0};
+		if(futex_wait(&rs->finished, 0, &ts) == 0)
+			continue;
+
+		int ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
+		assert (ret == 0);
+		if(status < 0)
+		{
+			printf("Error: reading graph failed, status: %'ld, completed callbacks: %'lu .\n", status, rs->completed_callbacks_count);
+			assert(status >= 0);
+		}
+	}
+
+	unsigned long callbacks_count = 0;
+	void* op2_args []= {req, &callbacks_count};
+	int ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_TOTAL_CALLBACKS, op2_args, 2);
+	assert (ret == 0);
+
+	printf("  Reading finished, read_edges: %'15lu, completed callbacks: %'lu/%'lu .\n", 
+		rs->completed_edges, rs->completed_callbacks_count, callbacks_count);
+
+	return;
+}
+
+/*
+	Returns |V| of the webgraph `file_name` by reading its `.properties` file, 
+	or -1UL if it cannot be found. It is used to select between the 4 and 8 Bytes vertex ID loaders. 
+*/
+unsigned long get_webgraph_vertices_count(char* file_name)
+{
+	assert(file_name != NULL);
+
+	char* props_file = malloc(PATH_MAX);
+	assert(props_file != NULL);
+	sprintf(props_file, "%s.properties", file_name);
+
+	unsigned long vertices_count = -1UL;
+	FILE* f = fopen(props_file, "r");
+	if(f != NULL)
+	{
+		char line[PATH_MAX];
+		while(fgets(line, PATH_MAX, f) != NULL)
+		{
+			char* val = strchr(line, '=');
+			if(val == NULL)
+				continue;
+			*val = 0;
+			val++;
+
+			char* key = line + strspn(line, " \t");
+			key[strcspn(key, " \t")] = 0;
+			if(!strcmp(key, "nodes"))
+			{
+				vertices_count = strtoul(val, NULL, 10);
+				break;
+			}
+		}
+
+		fclose(f);
+		f = NULL;
+	}
+
+	free(props_file);
+	props_file = NULL;
+
+	return vertices_count;
+}
+
+/*
+	Streaming load of a webgraph (bit 2 of `flags` of `get_ll_400_webgraph()`): 
+	The loader returns after writing the offsets_list, while ParaGrapher continues decompressing the edges. 
+	Vertices are divided into blocks of (1 << `block_bits`) vertices and each callback decrements the 
+	number of remaining edges of the blocks it covers. When a block is completed, its bit is set in 
+	`ready_bitmap` and the threads waiting in `ll_400_stream_wait_vertices()` are woken up via futex on `ready_blocks`.
+
+	As only one graph is loaded at a time, the stream is accessible through `ll_400_active_stream`, so kernels 
+	do not need to change their interface. They call `ll_400_stream_wait_vertices()` before accessing the 
+	neighbour-lists of a partition in their first pass over the edges. It returns immediately 
+	if `g` is not being streamed.
+*/
+struct ll_400_stream
+{
+	struct ll_400_graph* graph;
+	paragrapher_graph* pg_graph;
+	paragrapher_read_request* req;
+	struct __ll_webgraph_read_status rs;
+	void* callback_args[3];
+	unsigned long t1;
+
+	unsigned int block_bits;
+	unsigned long blocks_count;
+	unsigned long* blocks_remaining_edges;
+	unsigned long* ready_bitmap;
+	unsigned int ready_blocks;
+};
+
+struct ll_400_stream* ll_400_active_stream = NULL;
+
+void __ll_400_stream_edges_completed(struct ll_400_stream* st, unsigned long start_vertex, unsigned long end_vertex, unsigned long start_edge, unsigned long end_edge)
+{
+	unsigned long* offsets = st->graph->offsets_list;
+	for(unsigned long b = start_vertex >> st->block_bits; b <= (end_vertex >> st->block_bits) && b < st->blocks_count; b++)
+	{
+		unsigned long bs = offsets[b << st->block_bits];
+		unsigned long be = offsets[min((b + 1) << st->block_bits, st->graph->vertices_count)];
+		unsigned long s = max(bs, start_edge);
+		unsigned long e = min(be, end_edge);
+		if(e <= s)
+			continue;
+
+		if(__atomic_sub_fetch(&st->blocks_remaining_edges[b], e - s, __ATOMIC_ACQ_REL) == 0)
+		{
+			__atomic_or_fetch(&st->ready_bitmap[b / 64], 1UL << (b % 64), __ATOMIC_RELEASE);
+			__atomic_add_fetch(&st->ready_blocks, 1U, __ATOMIC_RELEASE);
+			futex_wake_all(&st->ready_blocks);
+		}
+	}
+
+	return;
+}
+
+/*
+	Blocks the calling thread until neighbour-lists of vertices in [`start_vertex`, `end_vertex`) of `g` are loaded.
+*/
+void ll_400_stream_wait_vertices(struct ll_400_graph* g, unsigned long start_vertex, unsigned long end_vertex)
+{
+	struct ll_400_stream* st = ll_400_active_stream;
+	if(st == NULL || st->graph != g || end_vertex <= start_vertex)
+		return;
+
+	for(unsigned long b = start_vertex >> st->block_bits; b <= ((end_vertex - 1) >> st->block_bits); b++)
+		while(1)
+		{
+			unsigned int rb = __atomic_load_n(&st->ready_blocks, __ATOMIC_ACQUIRE);
+			if(__atomic_load_n(&st->ready_bitmap[b / 64], __ATOMIC_ACQUIRE) & (1UL << (b % 64)))
+				break;
+
+			struct timespec ts = {1, 0};
+			if(futex_wait(&st->ready_blocks, rb, &ts) != 0)
+			{
+				// Checking if ParaGrapher has failed 
+				long status = 0;
+				void* op0_args []= {st->req, &status};
+				int ret = paragrapher_get_set_options(st->pg_graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
+				assert (ret == 0);
+				assert(status >= 0 && "Reading graph failed.");
+			}
+		}
+
+	return;
+}
+
+/*
+	Waits until all edges of `g` are loaded and releases the stream. 
+	It is a no-op if `g` is not being streamed, so it can be called for any graph.
+*/
+void ll_400_stream_finish(struct ll_400_graph* g)
+{
+	struct ll_400_stream* st = ll_400_active_stream;
+	if(st == NULL || st->graph != g)
+		return;
+
+	// Waiting for all buffers to be processed
+		__ll_webgraph_wait_for_blocks(st->pg_graph, st->req, &st->rs);
+		assert(st->ready_blocks == st->blocks_count);
+
+	// Releasing the req and the paragrapher graph
+		paragrapher_csx_release_read_request(st->req);
+		st->req = NULL;
+
+		int ret = paragrapher_release_graph(st->pg_graph, NULL, 0);
+		assert(ret == 0);
+		st->pg_graph = NULL;
+
+	printf("Streaming graph completed in %'.3f (seconds)\n", (get_nano_time() - st->t1)/1e9); 
+
+	// Printing the first vals in the read graph
+		print_ll_400_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	// Releasing mem
+		ll_400_active_stream = NULL;
+		free(st->blocks_remaining_edges);
+		st->blocks_remaining_edges = NULL;
+		free(st->ready_bitmap);
+		st->ready_bitmap = NULL;
+		free(st);
+		st = NULL;
+
+	return;
+}
+
+// Returns 1 if the edges of `g` are being streamed
+unsigned int ll_400_stream_is_active(struct ll_400_graph* g)
+{
+	struct ll_400_stream* st = ll_400_active_stream;
+	if(st == NULL || st->graph != g)
+		return 0;
+
+	return 1;
+}
+
+void __ll_400_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+{
+	void** args = (void**) in_args;
+	struct __ll_webgraph_read_status* rs = (struct __ll_webgraph_read_status*)args[0];
+	unsigned int* graph_edges = (unsigned int*)args[1];
+
+	unsigned long* offsets = (unsigned long*)in_offsets;
+	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
+	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
+	unsigned long* ul_in_edges = (unsigned long*)in_edges;
+
+	// No need to parallelize this loop as multiple instances of this callback are concurrently called by the ParaGrapher 
+	for(unsigned long e = 0; e < ec; e++, dest_off++)
 		graph_edges[dest_off] = (unsigned int)ul_in_edges[e];
 
+	// Marking the completed blocks of the stream, if streaming (before releasing `eb`)
+	struct ll_400_stream* st = (struct ll_400_stream*)args[2];
+	if(st != NULL)
+		__ll_400_stream_edges_completed(st, eb->start_vertex, eb->end_vertex, dest_off - ec, dest_off);
+
 	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
 
-	__atomic_add_fetch(completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+	__ll_webgraph_block_completed(rs, ec);
 
 	return;
 }
@@ -367,6 +1272,11 @@ void __ll_400_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_
 
 		bit 1:
 			Do not use PG-FUSE
+
+		bit 2:
+			Streaming: return after writing the offsets_list while the edges are loaded in the background. 
+			Only kernels that call `ll_400_stream_wait_vertices()` may access the edges before 
+			`ll_400_stream_finish()` is called. This flag is ignored if the graph is mapped from /dev/shm.
 		
 		bit 31: 
 			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
@@ -392,22 +1302,274 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 			pgt = PARAGRAPHER_CSX_WG_800_AP;
 		else
 		{
-			assert(0 && "get_ll_400_webgraph does not work for this type of graph.");
+			assert(0 && "get_ll_400_webgraph does not work for this type of graph.");
+			return NULL;
+		}
+
+		void** open_args = calloc(10, sizeof(void*));
+		assert(open_args != NULL);
+		int open_argc = 0;
+		if(flags == NULL || ((*flags & 2U) == 0) )
+			open_args[open_argc++] = "USE_PG_FUSE";
+	
+		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, open_args, open_argc);
+		assert(graph != NULL);
+
+		free(open_args);
+		open_args = NULL;
+
+		unsigned long vertices_count = 0;
+		unsigned long edges_count = 0;	
+		{
+			void* op_args []= {&vertices_count, &edges_count};
+
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_VERTICES_COUNT, op_args, 1);
+			assert (ret == 0);
+			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_GET_EDGES_COUNT, op_args + 1, 1);
+			assert (ret == 0);
+			printf("Vertices: %'lu\n",vertices_count);
+			printf("Edges: %'lu\n",edges_count);
+
+			if(vertices_count >= (1UL << 32))
+			{
+				assert(0 && "get_ll_400_webgraph() supports reading webgraphs with 4 Bytes ID per vertex.\n");
+				return NULL;
+			}
+
+			// val = 1UL << (unsigned int)(log(edges_count)/log(2) - 3);
+			// op_args[0] = &val;
+			// ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_SET_BUFFER_SIZE, op_args, 1);
+			// assert (ret == 0);
+		}
+
+	// Check if the graph exists in /dev/shm
+		if((*flags & 1U<<0) == 0)
+		{
+			struct ll_400_graph* g = get_shm_ll_400_graph(file_name, vertices_count, edges_count);
+			if(g != NULL)
+			{
+				assert(vertices_count == g->vertices_count);
+				assert(edges_count == g->edges_count);
+
+				print_ll_400_graph(g);
+				*flags |= 1U<<31;
+				return g;
+			}
+		}
+	
+	// Allocating memory
+		struct ll_400_graph* g =calloc(sizeof(struct ll_400_graph),1);
+		assert(g != NULL);
+		g->vertices_count = vertices_count;
+		g->edges_count = edges_count;
+		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(g->offsets_list != NULL);
+		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+		assert(g->edges_list != NULL);
+		
+	// Writing offsets
+	{
+		unsigned long* offsets = (unsigned long*)paragrapher_csx_get_offsets(graph, NULL, 0, -1UL, NULL, 0);
+		assert(offsets != NULL);
+
+		for(unsigned long v = 0; v <= vertices_count; v++)
+			g->offsets_list[v] = offsets[v];
+
+		paragrapher_csx_release_offsets_weights_arrays(graph, offsets);
+		offsets = NULL;
+	}
+
+	// Streaming the edges
+	if(*flags & 4U)
+	{
+		assert(ll_400_active_stream == NULL);
+		struct ll_400_stream* st = calloc(sizeof(struct ll_400_stream), 1);
+		assert(st != NULL);
+		st->graph = g;
+		st->pg_graph = graph;
+		st->t1 = t1;
+		st->rs.edges_count = edges_count;
+
+		st->block_bits = 0;
+		while((vertices_count >> st->block_bits) > (1UL << 16))
+			st->block_bits++;
+		st->blocks_count = (vertices_count + (1UL << st->block_bits) - 1) >> st->block_bits;
+		st->blocks_remaining_edges = calloc(sizeof(unsigned long), st->blocks_count);
+		st->ready_bitmap = calloc(sizeof(unsigned long), 1 + st->blocks_count / 64);
+		assert(st->blocks_remaining_edges != NULL && st->ready_bitmap != NULL);
+		for(unsigned long b = 0; b < st->blocks_count; b++)
+		{
+			st->blocks_remaining_edges[b] = g->offsets_list[min((b + 1) << st->block_bits, vertices_count)] - g->offsets_list[b << st->block_bits];
+			if(st->blocks_remaining_edges[b] == 0)
+			{
+				st->ready_bitmap[b / 64] |= 1UL << (b % 64);
+				st->ready_blocks++;
+			}
+		}
+		printf("Streaming edges in %'lu blocks of %'lu vertices.\n", st->blocks_count, 1UL << st->block_bits);
+
+		st->callback_args[0] = (void*)&st->rs;
+		st->callback_args[1] = (void*)g->edges_list;
+		st->callback_args[2] = (void*)st;
+		ll_400_active_stream = st;
+
+		paragrapher_edge_block eb;
+		eb.start_vertex = 0;
+		eb.start_edge=0;
+		eb.end_vertex = -1UL;
+		eb.end_edge= -1UL;
+
+		st->req = paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_400_webgraph_callback, (void*)st->callback_args, NULL, 0);
+		assert(st->req != NULL);
+
+		*flags &= ~(1U<<31);
+
+		return g;
+	}
+
+	// Reading edges
+	{
+		struct __ll_webgraph_read_status rs = {0};
+		rs.edges_count = edges_count;
+		void* callback_args[] = {(void*)&rs, (void*)g->edges_list, NULL};
+		paragrapher_edge_block eb;
+		eb.start_vertex = 0;
+		eb.start_edge=0;
+		eb.end_vertex = -1UL;
+		eb.end_edge= -1UL;
+
+		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_400_webgraph_callback, (void*)callback_args, NULL, 0);
+		assert(req != NULL);
+
+		// Waiting for all buffers to be processed
+		__ll_webgraph_wait_for_blocks(graph, req, &rs);
+
+		// Releasing the req
+		paragrapher_csx_release_read_request(req);
+		req = NULL;
+	}
+
+	// Releasing the paragrapher graph
+		ret = paragrapher_release_graph(graph, NULL, 0);
+		assert(ret == 0);
+		graph = NULL;
+		
+	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
+
+	// Printing the first vals in the read graph
+		print_ll_400_graph(g);
+
+	// Flush the OS cache
+		flush_os_cache();
+
+	*flags &= ~(1U<<31);
+
+	return g;	
+}
+
+struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
+{
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = __ll_shm_hp_get_graph(file_name, 404, vertices_count, edges_count, 2UL * edges_count * sizeof(unsigned int));
+		if(hdr == NULL)
+			return NULL;
+
+		struct ll_404_graph* g = malloc(sizeof(struct ll_404_graph));
+		assert(g != NULL);
+		g->vertices_count = hdr->vertices_count;
+		g->edges_count = hdr->edges_count;
+		g->offsets_list = (unsigned long*)((char*)hdr + LL_SHM_HP_HEADER_SIZE);
+		g->edges_list = (unsigned int*)(g->offsets_list + g->vertices_count + 1);
+
+		return g;
+	}
+
+	char* shm_name = get_shm_graph_name(file_name);
+	printf("shm_name: %s\n", shm_name);
+	unsigned long graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + 2UL * edges_count * sizeof(unsigned int);
+
+	struct ll_404_graph* g = NULL;
+	int shm_fd = shm_open(shm_name, O_RDONLY, 0);
+	if(shm_fd > 0)
+	{
+		printf("Shared memory file exists.\n");
+		unsigned long* ul_graph = (unsigned long*)mmap(NULL, graph_size, PROT_READ, MAP_PRIVATE, shm_fd, 0);
+		if(ul_graph == MAP_FAILED)
+		{
+			printf("Couldn't get graph -> mmap error : %d, %s\n", errno, strerror(errno) );
+			assert (ul_graph != MAP_FAILED);
+		}
+		close(shm_fd);
+		shm_fd = -1;
+		
+		g = malloc(sizeof(struct ll_404_graph));
+		assert(g != NULL);
+		g->vertices_count = ul_graph[0];
+		g->edges_count = ul_graph[1];
+		g->offsets_list = &ul_graph[2];
+		g->edges_list = (unsigned int*)(&ul_graph[ 2 + ul_graph[0] + 1 ]);
+	}
+
+	// Release mem
+		free(shm_name);
+		shm_name = NULL;
+
+	return g;
+}
+
+void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+{
+	void** args = (void**) in_args;
+	struct __ll_webgraph_read_status* rs = (struct __ll_webgraph_read_status*)args[0];
+	// Each edge has 4-Bytes for vertex ID and 4-Bytes for edge weight, we copy the 8-Bytes together
+	unsigned long* graph_edges = (unsigned long*)args[1];
+
+	unsigned long* offsets = (unsigned long*)in_offsets;
+	unsigned long ec = offsets[eb->end_vertex] + eb->end_edge - offsets[eb->start_vertex] - eb->start_edge;
+	unsigned long dest_off = offsets[eb->start_vertex] + eb->start_edge;
+	unsigned long* ul_in_edges = (unsigned long*)in_edges;
+
+	// No need to parallelize this loop as multiple instances of this callback are concurrently called by the ParaGrapher 
+	for(unsigned long e = 0; e < ec; e++, dest_off++)
+		graph_edges[dest_off] = ul_in_edges[e];
+
+	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
+
+	__ll_webgraph_block_completed(rs, ec);
+
+	return;
+}
+
+/*
+	`flags`:
+		bit 0: 
+			Read from storage. Do not use the copy in /dev/shm (if it exists).
+		
+		bit 31: 
+			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
+			This flag should be used for releasing the graph. If it is set, `release_shm_ll_404_graph()` should be called.
+			Otherwise, `release_numa_interleaved_ll_404_graph()` should be called.
+*/
+struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned int* flags)
+{	
+	// Opening graph
+		unsigned long t1=get_nano_time();
+			
+		int ret = paragrapher_init();
+		assert(ret == 0);
+
+		paragrapher_graph_type pgt;
+		if(!strcmp(type, "PARAGRAPHER_CSX_WG_404_AP"))
+			pgt = PARAGRAPHER_CSX_WG_404_AP;
+		else
+		{
+			assert(0 && "get_ll_404_webgraph does not work for this type of graph.");
 			return NULL;
 		}
-
-		void** open_args = calloc(10, sizeof(void*));
-		assert(open_args != NULL);
-		int open_argc = 0;
-		if(flags == NULL || ((*flags & 2U) == 0) )
-			open_args[open_argc++] = "USE_PG_FUSE";
-	
-		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, open_args, open_argc);
+		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, NULL, 0);
 		assert(graph != NULL);
 
-		free(open_args);
-		open_args = NULL;
-
 		unsigned long vertices_count = 0;
 		unsigned long edges_count = 0;	
 		{
@@ -420,12 +1582,6 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 			printf("Vertices: %'lu\n",vertices_count);
 			printf("Edges: %'lu\n",edges_count);
 
-			if(vertices_count >= (1UL << 32))
-			{
-				assert(0 && "get_ll_400_webgraph() supports reading webgraphs with 4 Bytes ID per vertex.\n");
-				return NULL;
-			}
-
 			// val = 1UL << (unsigned int)(log(edges_count)/log(2) - 3);
 			// op_args[0] = &val;
 			// ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_SET_BUFFER_SIZE, op_args, 1);
@@ -435,26 +1591,26 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 	// Check if the graph exists in /dev/shm
 		if((*flags & 1U<<0) == 0)
 		{
-			struct ll_400_graph* g = get_shm_ll_400_graph(file_name, vertices_count, edges_count);
+			struct ll_404_graph* g = get_shm_ll_404_graph(file_name, vertices_count, edges_count);
 			if(g != NULL)
 			{
 				assert(vertices_count == g->vertices_count);
 				assert(edges_count == g->edges_count);
 
-				print_ll_400_graph(g);
+				print_ll_400_graph((struct ll_400_graph*)g);
 				*flags |= 1U<<31;
 				return g;
 			}
 		}
-	
+
 	// Allocating memory
-		struct ll_400_graph* g =calloc(sizeof(struct ll_400_graph),1);
+		struct ll_404_graph* g =calloc(sizeof(struct ll_404_graph),1);
 		assert(g != NULL);
 		g->vertices_count = vertices_count;
 		g->edges_count = edges_count;
 		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
 		assert(g->offsets_list != NULL);
-		g->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+		g->edges_list = numa_alloc_interleaved(2UL * sizeof(unsigned int) * g->edges_count);
 		assert(g->edges_list != NULL);
 		
 	// Writing offsets
@@ -471,63 +1627,21 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 
 	// Reading edges
 	{
-		unsigned long completed_callbacks_count = 0;
-		void* callback_args[] = {(void*)&completed_callbacks_count, (void*)g->edges_list};
+		struct __ll_webgraph_read_status rs = {0};
+		rs.edges_count = edges_count;
+		void* callback_args[] = {(void*)&rs, (void*)g->edges_list};
 		paragrapher_edge_block eb;
 		eb.start_vertex = 0;
 		eb.start_edge=0;
 		eb.end_vertex = -1UL;
 		eb.end_edge= -1UL;
 
-		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_400_webgraph_callback, (void*)callback_args, NULL, 0);
+		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_404_webgraph_callback, (void*)callback_args, NULL, 0);
 		assert(req != NULL);
 
-		struct timespec ts = {0, 200 * 1000 * 1000};
-		long status = 0;
-		unsigned long read_edges = 0;
-		unsigned long callbacks_count = 0;
-		void* op0_args []= {req, &status};
-		void* op1_args []= {req, &read_edges};
-		void* op2_args []= {req, &callbacks_count};
-		unsigned long next_edge_limit_print = 0;
-		do
-		{
-			nanosleep(&ts, NULL);
-			
-			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
-			assert (ret == 0);
-			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_EDGES, op1_args, 2);
-			assert (ret == 0);
-			if(callbacks_count == 0)
-			{
-				ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_TOTAL_CALLBACKS, op2_args, 2);
-				assert (ret == 0);
-			}
-
-			if(read_edges >= next_edge_limit_print)
-			{
-				time_t t = time(NULL);
-				struct tm tm;
-				localtime_r(&t, &tm);
-				char timebuf[32];
-				strftime(timebuf, sizeof(timebuf), "%y/%m/%d %H:%M:%S", &tm);
-
-				printf("  [%s] Reading ..., status: %'ld, read_edges: %'15lu (%.1f%%), completed callbacks: %'lu/%'lu .\n", 
-					timebuf, status, read_edges, 100.0 *read_edges/edges_count, completed_callbacks_count, callbacks_count);
-
-				next_edge_limit_print = read_edges + 0.05 * edges_count;
-			}
-		}
-		while(status == 0);
-
-		// printf("  Reading graph finished, status: %'ld, read_edges: %'lu, completed callbacks: %'u/%'u .\n", status, read_edges, completed_callbacks_count, callbacks_count);
-
 		// Waiting for all buffers to be processed
-		while(completed_callbacks_count < callbacks_count)
-		{
-			nanosleep(&ts, NULL);
-			// printf("  Waiting for callbacks ..., completed callbacks: %'u/%'u .\n", completed_callbacks_count, callbacks_count);
-		}
+		__ll_webgraph_wait_for_blocks(graph, req, &rs);
+
 		// Releasing the req
 		paragrapher_csx_release_read_request(req);
 		req = NULL;
@@ -541,7 +1655,7 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
 
 	// Printing the first vals in the read graph
-		print_ll_400_graph(g);
+		print_ll_400_graph((struct ll_400_graph*)g);
 
 	// Flush the OS cache
 		flush_os_cache();
@@ -551,13 +1665,29 @@ struct ll_400_graph* get_ll_400_webgraph(char* file_name, char* type, unsigned i
 	return g;	
 }
 
-struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
+struct ll_800_graph* get_shm_ll_800_graph(char* file_name, unsigned long vertices_count, unsigned long edges_count)
 {
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = __ll_shm_hp_get_graph(file_name, 800, vertices_count, edges_count, edges_count * sizeof(unsigned long));
+		if(hdr == NULL)
+			return NULL;
+
+		struct ll_800_graph* g = malloc(sizeof(struct ll_800_graph));
+		assert(g != NULL);
+		g->vertices_count = hdr->vertices_count;
+		g->edges_count = hdr->edges_count;
+		g->offsets_list = (unsigned long*)((char*)hdr + LL_SHM_HP_HEADER_SIZE);
+		g->edges_list = g->offsets_list + g->vertices_count + 1;
+
+		return g;
+	}
+
 	char* shm_name = get_shm_graph_name(file_name);
 	printf("shm_name: %s\n", shm_name);
-	unsigned long graph_size = (2 + vertices_count + 1) * sizeof(unsigned long) + 2UL * edges_count * sizeof(unsigned int);
+	unsigned long graph_size = (2 + vertices_count + 1 + edges_count) * sizeof(unsigned long);
 
-	struct ll_404_graph* g = NULL;
+	struct ll_800_graph* g = NULL;
 	int shm_fd = shm_open(shm_name, O_RDONLY, 0);
 	if(shm_fd > 0)
 	{
@@ -571,12 +1701,12 @@ struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertice
 		close(shm_fd);
 		shm_fd = -1;
 		
-		g = malloc(sizeof(struct ll_404_graph));
+		g = malloc(sizeof(struct ll_800_graph));
 		assert(g != NULL);
 		g->vertices_count = ul_graph[0];
 		g->edges_count = ul_graph[1];
 		g->offsets_list = &ul_graph[2];
-		g->edges_list = (unsigned int*)(&ul_graph[ 2 + ul_graph[0] + 1 ]);
+		g->edges_list = &ul_graph[ 2 + ul_graph[0] + 1 ];
 	}
 
 	// Release mem
@@ -586,11 +1716,10 @@ struct ll_404_graph* get_shm_ll_404_graph(char* file_name, unsigned long vertice
 	return g;
 }
 
-void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
+void __ll_800_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_block* eb, void* in_offsets, void* in_edges, void* buffer_id, void* in_args)
 {
 	void** args = (void**) in_args;
-	unsigned long* completed_callbacks_count = (unsigned long*)args[0];
-	// Each edge has 4-Bytes for vertex ID and 4-Bytes for edge weight, we copy the 8-Bytes together
+	struct __ll_webgraph_read_status* rs = (struct __ll_webgraph_read_status*)args[0];
 	unsigned long* graph_edges = (unsigned long*)args[1];
 
 	unsigned long* offsets = (unsigned long*)in_offsets;
@@ -604,40 +1733,55 @@ void __ll_404_webgraph_callback(paragrapher_read_request* req, paragrapher_edge_
 
 	paragrapher_csx_release_read_buffers(req, eb, buffer_id);
 
-	__atomic_add_fetch(completed_callbacks_count, 1UL, __ATOMIC_RELAXED);
+	__ll_webgraph_block_completed(rs, ec);
 
 	return;
 }
 
 /*
+	Reads webgraphs with 8 Bytes vertex IDs, i.e., |V| may be larger than 2^32.
+
 	`flags`:
 		bit 0: 
 			Read from storage. Do not use the copy in /dev/shm (if it exists).
+
+		bit 1:
+			Do not use PG-FUSE
 		
 		bit 31: 
 			Will be set by the function if the graph has been mapped from a copy in /dev/shm. 
-			This flag should be used for releasing the graph. If it is set, `release_shm_ll_404_graph()` should be called.
-			Otherwise, `release_numa_interleaved_ll_404_graph()` should be called.
+			This flag should be used for releasing the graph. If it is set, `release_shm_ll_800_graph()` should be called.
+			Otherwise, `release_numa_interleaved_ll_800_graph()` should be called.
 */
-struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned int* flags)
+struct ll_800_graph* get_ll_800_webgraph(char* file_name, char* type, unsigned int* flags)
 {	
-	// Opening graph
+	// Opening the graph
 		unsigned long t1=get_nano_time();
 			
 		int ret = paragrapher_init();
 		assert(ret == 0);
 
 		paragrapher_graph_type pgt;
-		if(!strcmp(type, "PARAGRAPHER_CSX_WG_404_AP"))
-			pgt = PARAGRAPHER_CSX_WG_404_AP;
+		if(!strcmp(type, "PARAGRAPHER_CSX_WG_400_AP") || !strcmp(type, "PARAGRAPHER_CSX_WG_800_AP"))
+			pgt = PARAGRAPHER_CSX_WG_800_AP;
 		else
 		{
-			assert(0 && "get_ll_404_webgraph does not work for this type of graph.");
+			assert(0 && "get_ll_800_webgraph does not work for this type of graph.");
 			return NULL;
 		}
-		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, NULL, 0);
+
+		void** open_args = calloc(10, sizeof(void*));
+		assert(open_args != NULL);
+		int open_argc = 0;
+		if(flags == NULL || ((*flags & 2U) == 0) )
+			open_args[open_argc++] = "USE_PG_FUSE";
+	
+		paragrapher_graph* graph = paragrapher_open_graph(file_name, pgt, open_args, open_argc);
 		assert(graph != NULL);
 
+		free(open_args);
+		open_args = NULL;
+
 		unsigned long vertices_count = 0;
 		unsigned long edges_count = 0;	
 		{
@@ -649,36 +1793,31 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 			assert (ret == 0);
 			printf("Vertices: %'lu\n",vertices_count);
 			printf("Edges: %'lu\n",edges_count);
-
-			// val = 1UL << (unsigned int)(log(edges_count)/log(2) - 3);
-			// op_args[0] = &val;
-			// ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_SET_BUFFER_SIZE, op_args, 1);
-			// assert (ret == 0);
 		}
 
 	// Check if the graph exists in /dev/shm
 		if((*flags & 1U<<0) == 0)
 		{
-			struct ll_404_graph* g = get_shm_ll_404_graph(file_name, vertices_count, edges_count);
+			struct ll_800_graph* g = get_shm_ll_800_graph(file_name, vertices_count, edges_count);
 			if(g != NULL)
 			{
 				assert(vertices_count == g->vertices_count);
 				assert(edges_count == g->edges_count);
 
-				print_ll_400_graph((struct ll_400_graph*)g);
+				print_ll_800_graph(g);
 				*flags |= 1U<<31;
 				return g;
 			}
 		}
-
+	
 	// Allocating memory
-		struct ll_404_graph* g =calloc(sizeof(struct ll_404_graph),1);
+		struct ll_800_graph* g =calloc(sizeof(struct ll_800_graph),1);
 		assert(g != NULL);
 		g->vertices_count = vertices_count;
 		g->edges_count = edges_count;
 		g->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
 		assert(g->offsets_list != NULL);
-		g->edges_list = numa_alloc_interleaved(2UL * sizeof(unsigned int) * g->edges_count);
+		g->edges_list = numa_alloc_interleaved(sizeof(unsigned long) * g->edges_count);
 		assert(g->edges_list != NULL);
 		
 	// Writing offsets
@@ -695,63 +1834,21 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 
 	// Reading edges
 	{
-		unsigned long completed_callbacks_count = 0;
-		void* callback_args[] = {(void*)&completed_callbacks_count, (void*)g->edges_list};
+		struct __ll_webgraph_read_status rs = {0};
+		rs.edges_count = edges_count;
+		void* callback_args[] = {(void*)&rs, (void*)g->edges_list};
 		paragrapher_edge_block eb;
 		eb.start_vertex = 0;
 		eb.start_edge=0;
 		eb.end_vertex = -1UL;
 		eb.end_edge= -1UL;
 
-		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_404_webgraph_callback, (void*)callback_args, NULL, 0);
+		paragrapher_read_request* req= paragrapher_csx_get_subgraph(graph, &eb, NULL, NULL, __ll_800_webgraph_callback, (void*)callback_args, NULL, 0);
 		assert(req != NULL);
 
-		struct timespec ts = {0, 200 * 1000 * 1000};
-		long status = 0;
-		unsigned long read_edges = 0;
-		unsigned long callbacks_count = 0;
-		void* op0_args []= {req, &status};
-		void* op1_args []= {req, &read_edges};
-		void* op2_args []= {req, &callbacks_count};
-		unsigned long next_edge_limit_print = 0;
-		do
-		{
-			nanosleep(&ts, NULL);
-			
-			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_STATUS, op0_args, 2);
-			assert (ret == 0);
-			ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_EDGES, op1_args, 2);
-			assert (ret == 0);
-			if(callbacks_count == 0)
-			{
-				ret = paragrapher_get_set_options(graph, PARAGRAPHER_REQUEST_READ_TOTAL_CALLBACKS, op2_args, 2);
-				assert (ret == 0);
-			}
-
-			if(read_edges >= next_edge_limit_print)
-			{
-				time_t t = time(NULL);
-				struct tm tm;
-				localtime_r(&t, &tm);
-				char timebuf[32];
-				strftime(timebuf, sizeof(timebuf), "%y/%m/%d %H:%M:%S", &tm);
-
-				printf("  [%s] Reading ..., status: %'ld, read_edges: %'15lu (%.1f%%), completed callbacks: %'lu/%'lu .\n", 
-					timebuf, status, read_edges, 100.0 *read_edges/edges_count, completed_callbacks_count, callbacks_count);
-
-				next_edge_limit_print = read_edges + 0.05 * edges_count;
-			}
-		}
-		while(status == 0);
-
-		// printf("  Reading graph finished, status: %'ld, read_edges: %'lu, completed callbacks: %'u/%'u .\n", status, read_edges, completed_callbacks_count, callbacks_count);
-
 		// Waiting for all buffers to be processed
-		while(completed_callbacks_count < callbacks_count)
-		{
-			nanosleep(&ts, NULL);
-			// printf("  Waiting for callbacks ..., completed callbacks: %'u/%'u .\n", completed_callbacks_count, callbacks_count);
-		}
+		__ll_webgraph_wait_for_blocks(graph, req, &rs);
+
 		// Releasing the req
 		paragrapher_csx_release_read_request(req);
 		req = NULL;
@@ -765,7 +1862,7 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 	printf("Reading completed in %'.3f (seconds)\n", (get_nano_time() - t1)/1e9); 
 
 	// Printing the first vals in the read graph
-		print_ll_400_graph((struct ll_400_graph*)g);
+		print_ll_800_graph(g);
 
 	// Flush the OS cache
 		flush_os_cache();
@@ -778,10 +1875,15 @@ struct ll_404_graph* get_ll_404_webgraph(char* file_name, char* type, unsigned i
 /*
 	flags:
 		bit 0: Directly use `file_name` without calling `get_shm_graph_name()`.
+		bit 1: The graph is symmetric. It is stored in the header of huge-page-backed graphs (`LL_SHM_HUGE_PAGES=1`).
 */
 int store_shm_ll_400_graph(struct par_env* pe, char* file_name, struct ll_400_graph* g, unsigned int flags)
 {
 	assert(file_name != NULL && g != NULL);
+	ll_400_stream_finish(g);
+
+	if(LL_SHM_HUGE_PAGES)
+		return __ll_shm_hp_store_graph(file_name, flags, 400, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list);
 
 	int ret = -1;
 	char* shm_name;
@@ -839,6 +1941,9 @@ int store_shm_ll_404_graph(struct par_env* pe, char* file_name, struct ll_404_gr
 {
 	assert(file_name != NULL && g != NULL);
 
+	if(LL_SHM_HUGE_PAGES)
+		return __ll_shm_hp_store_graph(file_name, flags, 404, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list);
+
 	int ret = -1;
 	char* shm_name;
 	if(flags & 1U)
@@ -891,10 +1996,81 @@ int store_shm_ll_404_graph(struct par_env* pe, char* file_name, struct ll_404_gr
 	return ret;
 }
 
+int store_shm_ll_800_graph(struct par_env* pe, char* file_name, struct ll_800_graph* g, unsigned int flags)
+{
+	assert(file_name != NULL && g != NULL);
+
+	if(LL_SHM_HUGE_PAGES)
+		return __ll_shm_hp_store_graph(file_name, flags, 800, g->vertices_count, g->edges_count, g->offsets_list, g->edges_list);
+
+	int ret = -1;
+	char* shm_name;
+	if(flags & 1U)
+		shm_name = file_name;
+	else
+		shm_name = get_shm_graph_name(file_name);
+	unsigned long graph_size = (2 + g->vertices_count + 1 + g->edges_count) * sizeof(unsigned long);
+	
+	unsigned long* sg = create_shm(shm_name, graph_size);
+	if(sg != NULL)
+	{
+		numa_interleave_allocated_memory(sg, graph_size);
+
+		sg[0] = g->vertices_count;
+		sg[1] = g->edges_count;
+
+		#pragma omp parallel for 
+		for(unsigned long v=0; v <= g->vertices_count; v++)
+			sg[2 + v] = g->offsets_list[v];
+
+		unsigned long* sg_edges = sg + 2 + g->vertices_count + 1;
+		#pragma omp parallel for 
+		for(unsigned long e=0; e < g->edges_count; e++)
+			sg_edges[e] = g->edges_list[e];
+
+		int ret = msync(sg, graph_size, MS_SYNC);
+		assert(ret == 0);
+
+		munmap(sg, graph_size);
+		sg = NULL;
+
+		{
+			int shm_fd = shm_open(shm_name, O_RDONLY, 0);
+			int r0 = fchmod(shm_fd, S_IRUSR|S_IRGRP|S_IROTH);
+			assert(r0 == 0);
+		
+			close(shm_fd);
+			shm_fd = -1;
+		}
+
+		ret = 0;
+	}
+
+	if(shm_name != file_name)
+	{
+		free(shm_name);
+		shm_name = NULL;
+	}
+
+	return ret;
+}
+
 void delete_shm_graph_from(char* file_name)
 {
 	assert(file_name != NULL);
 
+	if(LL_SHM_HUGE_PAGES)
+	{
+		char* hp_name = __ll_shm_hp_name(file_name, 0);
+		int ret = __ll_shm_hp_unlink(hp_name);
+		assert(ret == 0);
+
+		free(hp_name);
+		hp_name = NULL;
+
+		return;
+	}
+
 	char* shm_name = get_shm_graph_name(file_name);
 	int ret = shm_unlink(shm_name);
 	assert(ret == 0);
@@ -908,6 +2084,7 @@ void delete_shm_graph_from(char* file_name)
 void release_numa_interleaved_ll_400_graph(struct ll_400_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
+	ll_400_stream_finish(g);
 
 	numa_free(g->offsets_list, sizeof(unsigned long)*(1 + g->vertices_count));
 	g->offsets_list = NULL;
@@ -927,6 +2104,21 @@ void release_numa_interleaved_ll_400_graph(struct ll_400_graph* g)
 void release_shm_ll_400_graph(struct ll_400_graph* g)
 {
 	assert(g != NULL);
+
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = (struct ll_shm_hp_header*)((char*)g->offsets_list - LL_SHM_HP_HEADER_SIZE);
+		assert(hdr->magic == LL_SHM_HP_MAGIC && hdr->graph_type == 400);
+		munmap(hdr, hdr->mapping_size);
+		hdr = NULL;
+
+		g->offsets_list = NULL;
+		g->edges_list = NULL;
+		free(g);
+		g = NULL;
+
+		return;
+	}
 	assert( (void*)(g->offsets_list - 2) == (void*)(g->edges_list - 2 * (2 + g->vertices_count + 1)) );
 
 	unsigned long graph_size = (2 + g->vertices_count + 1) * sizeof(unsigned long) + g->edges_count * sizeof(unsigned int);
@@ -941,6 +2133,73 @@ void release_shm_ll_400_graph(struct ll_400_graph* g)
 	return;
 }
 
+/*
+	Converts `g` with |E| < 2^32 to an ll_400s_graph with 4 Bytes offsets.
+
+	flags:
+		bit 0: `g` has been mapped from shm (bit 31 of the `flags` of the loaders). The edges are copied and 
+			`g` is not released. 
+			Otherwise, the edges_list is moved to the new graph and `g` (including its offsets_list) is released.
+*/
+struct ll_400s_graph* compact_ll_400_graph(struct ll_400_graph* g, unsigned int flags)
+{
+	assert(g != NULL && g->edges_count < (1UL << 32));
+	ll_400_stream_finish(g);
+	unsigned long t0 = - get_nano_time();
+
+	struct ll_400s_graph* ret = calloc(sizeof(struct ll_400s_graph), 1);
+	assert(ret != NULL);
+	ret->vertices_count = g->vertices_count;
+	ret->edges_count = g->edges_count;
+	
+	ret->offsets_list = numa_alloc_interleaved(sizeof(unsigned int) * (1 + g->vertices_count));
+	assert(ret->offsets_list != NULL);
+	#pragma omp parallel for
+	for(unsigned long v = 0; v <= g->vertices_count; v++)
+		ret->offsets_list[v] = g->offsets_list[v];
+
+	if(flags & 1U)
+	{
+		ret->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * g->edges_count);
+		assert(ret->edges_list != NULL);
+		#pragma omp parallel for
+		for(unsigned long e = 0; e < g->edges_count; e++)
+			ret->edges_list[e] = g->edges_list[e];
+	}
+	else
+	{
+		ret->edges_list = g->edges_list;
+		g->edges_list = NULL;
+		release_numa_interleaved_ll_400_graph(g);
+		g = NULL;
+	}
+
+	t0 += get_nano_time();
+	printf("Compacted offsets to 4 Bytes, saved: %'.1f (MB), time: %'.1f (ms)\n", 
+		sizeof(unsigned int) * (1 + ret->vertices_count) / 1e6, t0 / 1e6);
+
+	return ret;
+}
+
+void release_numa_interleaved_ll_400s_graph(struct ll_400s_graph* g)
+{
+	assert(g!= NULL && g->offsets_list != NULL);
+
+	numa_free(g->offsets_list, sizeof(unsigned int)*(1 + g->vertices_count));
+	g->offsets_list = NULL;
+
+	if(g->edges_list)
+	{
+		numa_free(g->edges_list, sizeof(unsigned int) * g->edges_count);
+		g->edges_list = NULL;
+	}
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
 void release_numa_interleaved_ll_800_graph(struct ll_800_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
@@ -960,6 +2219,39 @@ void release_numa_interleaved_ll_800_graph(struct ll_800_graph* g)
 	return;
 }
 
+void release_shm_ll_800_graph(struct ll_800_graph* g)
+{
+	assert(g != NULL);
+
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = (struct ll_shm_hp_header*)((char*)g->offsets_list - LL_SHM_HP_HEADER_SIZE);
+		assert(hdr->magic == LL_SHM_HP_MAGIC && hdr->graph_type == 800);
+		munmap(hdr, hdr->mapping_size);
+		hdr = NULL;
+
+		g->offsets_list = NULL;
+		g->edges_list = NULL;
+		free(g);
+		g = NULL;
+
+		return;
+	}
+
+	assert(g->offsets_list + g->vertices_count + 1 == g->edges_list);
+
+	unsigned long graph_size = (2 + g->vertices_count + 1 + g->edges_count) * sizeof(unsigned long);
+	munmap(g->offsets_list - 2, graph_size);
+
+	g->offsets_list = NULL;
+	g->edges_list = NULL;
+
+	free(g);
+	g = NULL;
+
+	return;
+}
+
 void release_numa_interleaved_ll_404_graph(struct ll_404_graph* g)
 {
 	assert(g!= NULL && g->offsets_list != NULL);
@@ -982,6 +2274,21 @@ void release_numa_interleaved_ll_404_graph(struct ll_404_graph* g)
 void release_shm_ll_404_graph(struct ll_404_graph* g)
 {
 	assert(g != NULL);
+
+	if(LL_SHM_HUGE_PAGES)
+	{
+		struct ll_shm_hp_header* hdr = (struct ll_shm_hp_header*)((char*)g->offsets_list - LL_SHM_HP_HEADER_SIZE);
+		assert(hdr->magic == LL_SHM_HP_MAGIC && hdr->graph_type == 404);
+		munmap(hdr, hdr->mapping_size);
+		hdr = NULL;
+
+		g->offsets_list = NULL;
+		g->edges_list = NULL;
+		free(g);
+		g = NULL;
+
+		return;
+	}
 	assert( (void*)(g->offsets_list - 2) == (void*)(g->edges_list - 2 * (2 + g->vertices_count + 1)) );
 
 	unsigned long graph_size = (2 + g->vertices_count + 1) * sizeof(unsigned long) + 2 * g->edges_count * sizeof(unsigned int);
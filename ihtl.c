@@ -0,0 +1,711 @@
+#ifndef __IHTL_C
+#define __IHTL_C
+
+// This file contains the implementation of the iHTL SpMV traversal
+
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+#include "pagerank.c"
+
+/*
+	In-Hub Temporal Locality (iHTL)
+
+	https://doi.org/10.1145/3472456.3472462
+
+	@INPROCEEDINGS{ihtl,
+	  author = {Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
+	  title = {Exploiting In-Hub Temporal Locality In SpMV-Based Graph Processing},
+	  year = {2021},
+	  isbn = {9781450390682},
+	  publisher = {Association for Computing Machinery},
+	  address = {New York, NY, USA},
+	  url = {https://doi.org/10.1145/3472456.3472462},
+	  doi = {10.1145/3472456.3472462},
+	  booktitle = {50th International Conference on Parallel Processing},
+	  numpages = {10},
+	  location = {Lemont, IL, USA},
+	  series = {ICPP 2021}
+	}
+
+	iHTL divides the edges of the graph into:
+		(i) flipped blocks: the edges to in-hubs (vertices with the highest in-degrees). Each flipped block has
+			the edges to `block_hubs` consecutive hubs and it is processed in push direction. Each thread accumulates
+			the values of the hubs of the block in its own buffer that fits in the L2 cache, and at the end
+			of the block, the buffers of threads are reduced.
+		(ii) sparse block: the edges to non-hubs that are processed in pull direction.
+
+	The in-hubs are identified by `sapco_sort_degree_ordering()`. A block of hubs is flipped if its in-edges
+	are at least `LL_IHTL_MIN_HUB_EDGES_PER_THREAD * threads_count` times the number of its hubs,
+	i.e., the temporal locality of the hubs in the push direction pays off the reduction of the buffers of threads.
+	The first block that does not satisfy this condition and the remaining vertices are processed in the sparse block.
+	This is a simplified version of the identification of the flipped blocks in the paper that investigates connections
+	between the hubs.
+*/
+
+#define LL_IHTL_MIN_HUB_EDGES_PER_THREAD 2
+#define LL_IHTL_MAX_FLIPPED_BLOCKS 256
+
+struct ihtl_block
+{
+	unsigned int hubs_start;       // index of the first hub of the block in `hubs`
+	unsigned int hubs_count;
+	unsigned int* sources;         // vertices with edges to hubs of the block
+	struct ll_400_graph* graph;    // neighbour-list of sources[i] is the list of its hubs (relative to hubs_start)
+	unsigned int* partitions;
+};
+
+struct ihtl_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long flipped_edges_count;
+
+	unsigned int block_hubs;
+	unsigned int flipped_blocks_count;
+	unsigned int hubs_count;
+	unsigned int* hubs;            // IDs of hubs in descending in-degree order
+
+	struct ihtl_block* blocks;
+	struct ll_400_graph* sparse;   // the CSC of the sparse block, hubs have no in-edges
+	unsigned int* sparse_partitions;
+
+	unsigned int partitions_count;
+	struct dynamic_partitioning* dp;
+	double* threads_buffers;       // `block_hubs` elements per thread
+};
+
+/*
+	Builds the iHTL blocks of a graph from its CSC, i.e., in-neighbours of vertices.
+
+	flags:
+		bit 0: print stats
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+*/
+struct ihtl_graph* ihtl_build(struct par_env* pe, struct ll_400_graph* csc, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && csc != NULL && csc->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mihtl_build\033[0;37m\n");
+
+		struct ihtl_graph* ig = calloc(sizeof(struct ihtl_graph), 1);
+		assert(ig != NULL);
+		ig->vertices_count = csc->vertices_count;
+		ig->edges_count = csc->edges_count;
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+		// The buffer of hubs of each thread occupies half of the L2 cache
+		unsigned long l2_size = pe->L2_cache_size;
+		if(l2_size == 0)
+			l2_size = 1024 * 1024;
+		ig->block_hubs = max(1024UL, l2_size / (2 * sizeof(double)));
+		ig->partitions_count = pe->threads_count * 64;
+
+	// (1) Identifying in-hubs
+		unsigned long mt = - get_nano_time();
+		unsigned int* RA_n2o = sapco_sort_degree_ordering(pe, csc, NULL, 0);
+		mt += get_nano_time();
+		if(flags & 1U)
+			PT("(1) Degree ordering:");
+
+	// (2) Identifying flipped blocks
+		mt = - get_nano_time();
+		{
+			unsigned int b = 0;
+			for(b = 0; b < LL_IHTL_MAX_FLIPPED_BLOCKS; b++)
+			{
+				unsigned long start = 1UL * b * ig->block_hubs;
+				unsigned long end = min(ig->vertices_count, (b + 1UL) * ig->block_hubs);
+				if(start >= end)
+					break;
+
+				unsigned long block_edges = 0;
+				#pragma omp parallel for reduction(+:block_edges)
+				for(unsigned long h = start; h < end; h++)
+					block_edges += csc->offsets_list[RA_n2o[h] + 1] - csc->offsets_list[RA_n2o[h]];
+
+				if(block_edges < 1UL * LL_IHTL_MIN_HUB_EDGES_PER_THREAD * pe->threads_count * (end - start))
+					break;
+
+				ig->flipped_edges_count += block_edges;
+				ig->hubs_count = end;
+			}
+			ig->flipped_blocks_count = b;
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+		{
+			PT("(2) Identifying flipped blocks:");
+			printf("  Block hubs: %'u, Flipped blocks: %'u, Hubs: %'u, Flipped edges: %'lu (%.1f%%)\n",
+				ig->block_hubs, ig->flipped_blocks_count, ig->hubs_count, ig->flipped_edges_count,
+				100.0 * ig->flipped_edges_count / max(1, ig->edges_count));
+		}
+
+		ig->hubs = numa_alloc_interleaved(sizeof(unsigned int) * max(1, ig->hubs_count));
+		assert(ig->hubs != NULL);
+		#pragma omp parallel for
+		for(unsigned int h = 0; h < ig->hubs_count; h++)
+			ig->hubs[h] = RA_n2o[h];
+		numa_free(RA_n2o, sizeof(unsigned int) * ig->vertices_count);
+		RA_n2o = NULL;
+
+		unsigned int* hub_index = numa_alloc_interleaved(sizeof(unsigned int) * ig->vertices_count);
+		assert(hub_index != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < ig->vertices_count; v++)
+			hub_index[v] = -1U;
+		#pragma omp parallel for
+		for(unsigned int h = 0; h < ig->hubs_count; h++)
+			hub_index[ig->hubs[h]] = h;
+
+		unsigned int partitions_count = ig->partitions_count;
+		unsigned long* partitions_vals = calloc(sizeof(unsigned long), 2 * partitions_count);
+		assert(partitions_vals != NULL);
+
+	// (3) Creating the sparse block
+		mt = - get_nano_time();
+		{
+			struct ll_400_graph* sg = calloc(sizeof(struct ll_400_graph), 1);
+			assert(sg != NULL);
+			sg->vertices_count = ig->vertices_count;
+			sg->edges_count = ig->edges_count - ig->flipped_edges_count;
+			sg->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + sg->vertices_count));
+			sg->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * max(1, sg->edges_count));
+			assert(sg->offsets_list != NULL && sg->edges_list != NULL);
+
+			// Prefix sum
+			#pragma omp parallel for
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned int start_vertex = (sg->vertices_count / partitions_count) * p;
+				unsigned int end_vertex = (sg->vertices_count / partitions_count) * (p + 1);
+				if(p + 1 == partitions_count)
+					end_vertex = sg->vertices_count;
+
+				unsigned long sum = 0;
+				for(unsigned int v = start_vertex; v < end_vertex; v++)
+					if(hub_index[v] == -1U)
+						sum += csc->offsets_list[v + 1] - csc->offsets_list[v];
+				partitions_vals[p] = sum;
+			}
+
+			unsigned long ec = 0;
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long temp = partitions_vals[p];
+				partitions_vals[p] = ec;
+				ec += temp;
+			}
+			assert(ec == sg->edges_count);
+
+			#pragma omp parallel for
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned int start_vertex = (sg->vertices_count / partitions_count) * p;
+				unsigned int end_vertex = (sg->vertices_count / partitions_count) * (p + 1);
+				if(p + 1 == partitions_count)
+					end_vertex = sg->vertices_count;
+
+				unsigned long offset = partitions_vals[p];
+				for(unsigned int v = start_vertex; v < end_vertex; v++)
+				{
+					sg->offsets_list[v] = offset;
+					if(hub_index[v] != -1U)
+						continue;
+
+					for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+						sg->edges_list[offset++] = csc->edges_list[e];
+				}
+			}
+			sg->offsets_list[sg->vertices_count] = sg->edges_count;
+
+			ig->sparse = sg;
+			ig->sparse_partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+			assert(ig->sparse_partitions != NULL);
+			parallel_edge_partitioning(sg, ig->sparse_partitions, partitions_count);
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PT("(3) Creating the sparse block:");
+
+	// (4) Creating the flipped blocks
+		mt = - get_nano_time();
+		ig->blocks = calloc(sizeof(struct ihtl_block), max(1, ig->flipped_blocks_count));
+		assert(ig->blocks != NULL);
+		{
+			// `counts[u]` is the number of edges from `u` to the hubs of the current block,
+			// after identifying the sources, it is the index of `u` in the sources of the block.
+			unsigned int* counts = numa_alloc_interleaved(sizeof(unsigned int) * ig->vertices_count);
+			assert(counts != NULL);
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < ig->vertices_count; v++)
+				counts[v] = 0;
+
+			for(unsigned int b = 0; b < ig->flipped_blocks_count; b++)
+			{
+				struct ihtl_block* block = &ig->blocks[b];
+				block->hubs_start = b * ig->block_hubs;
+				block->hubs_count = min(ig->hubs_count - block->hubs_start, ig->block_hubs);
+
+				// Counting edges of sources
+				#pragma omp parallel for schedule(dynamic, 64)
+				for(unsigned int h = block->hubs_start; h < block->hubs_start + block->hubs_count; h++)
+				{
+					unsigned int hub = ig->hubs[h];
+					for(unsigned long e = csc->offsets_list[hub]; e < csc->offsets_list[hub + 1]; e++)
+						__atomic_add_fetch(&counts[csc->edges_list[e]], 1U, __ATOMIC_RELAXED);
+				}
+
+				// Prefix sum of sources and edges
+				#pragma omp parallel for
+				for(unsigned int p = 0; p < partitions_count; p++)
+				{
+					unsigned int start_vertex = (ig->vertices_count / partitions_count) * p;
+					unsigned int end_vertex = (ig->vertices_count / partitions_count) * (p + 1);
+					if(p + 1 == partitions_count)
+						end_vertex = ig->vertices_count;
+
+					unsigned long sources = 0;
+					unsigned long edges = 0;
+					for(unsigned int v = start_vertex; v < end_vertex; v++)
+						if(counts[v])
+						{
+							sources++;
+							edges += counts[v];
+						}
+					partitions_vals[2 * p] = sources;
+					partitions_vals[2 * p + 1] = edges;
+				}
+
+				unsigned long sc = 0;
+				unsigned long ec = 0;
+				for(unsigned int p = 0; p < partitions_count; p++)
+				{
+					unsigned long temp = partitions_vals[2 * p];
+					partitions_vals[2 * p] = sc;
+					sc += temp;
+
+					temp = partitions_vals[2 * p + 1];
+					partitions_vals[2 * p + 1] = ec;
+					ec += temp;
+				}
+				assert(sc > 0 && sc < (1UL << 32));
+
+				struct ll_400_graph* bg = calloc(sizeof(struct ll_400_graph), 1);
+				assert(bg != NULL);
+				bg->vertices_count = sc;
+				bg->edges_count = ec;
+				bg->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + sc));
+				bg->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * ec);
+				block->sources = numa_alloc_interleaved(sizeof(unsigned int) * sc);
+				unsigned long* fill = numa_alloc_interleaved(sizeof(unsigned long) * sc);
+				assert(bg->offsets_list != NULL && bg->edges_list != NULL && block->sources != NULL && fill != NULL);
+
+				// Writing sources and offsets
+				#pragma omp parallel for
+				for(unsigned int p = 0; p < partitions_count; p++)
+				{
+					unsigned int start_vertex = (ig->vertices_count / partitions_count) * p;
+					unsigned int end_vertex = (ig->vertices_count / partitions_count) * (p + 1);
+					if(p + 1 == partitions_count)
+						end_vertex = ig->vertices_count;
+
+					unsigned long s = partitions_vals[2 * p];
+					unsigned long offset = partitions_vals[2 * p + 1];
+					for(unsigned int v = start_vertex; v < end_vertex; v++)
+						if(counts[v])
+						{
+							block->sources[s] = v;
+							bg->offsets_list[s] = offset;
+							fill[s] = offset;
+							offset += counts[v];
+							counts[v] = s;
+							s++;
+						}
+				}
+				bg->offsets_list[sc] = ec;
+
+				// Writing edges
+				#pragma omp parallel for schedule(dynamic, 64)
+				for(unsigned int h = block->hubs_start; h < block->hubs_start + block->hubs_count; h++)
+				{
+					unsigned int hub = ig->hubs[h];
+					for(unsigned long e = csc->offsets_list[hub]; e < csc->offsets_list[hub + 1]; e++)
+					{
+						unsigned long pos = __atomic_fetch_add(&fill[counts[csc->edges_list[e]]], 1UL, __ATOMIC_RELAXED);
+						bg->edges_list[pos] = h - block->hubs_start;
+					}
+				}
+
+				// Resetting counts
+				#pragma omp parallel for
+				for(unsigned int s = 0; s < sc; s++)
+					counts[block->sources[s]] = 0;
+
+				numa_free(fill, sizeof(unsigned long) * sc);
+				fill = NULL;
+
+				block->graph = bg;
+				block->partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+				assert(block->partitions != NULL);
+				parallel_edge_partitioning(bg, block->partitions, partitions_count);
+			}
+
+			numa_free(counts, sizeof(unsigned int) * ig->vertices_count);
+			counts = NULL;
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PT("(4) Creating the flipped blocks:");
+
+	// Allocating memory for SpMV
+		ig->dp = dynamic_partitioning_initialize(pe, partitions_count);
+		ig->threads_buffers = numa_alloc_interleaved(sizeof(double) * ig->block_hubs * pe->threads_count);
+		assert(ig->threads_buffers != NULL);
+		#pragma omp parallel for
+		for(unsigned long i = 0; i < 1UL * ig->block_hubs * pe->threads_count; i++)
+			ig->threads_buffers[i] = 0;
+
+	// Finalizing
+		numa_free(hub_index, sizeof(unsigned int) * ig->vertices_count);
+		hub_index = NULL;
+		free(partitions_vals);
+		partitions_vals = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	return ig;
+}
+
+void ihtl_release(struct ihtl_graph* ig)
+{
+	assert(ig != NULL);
+
+	for(unsigned int b = 0; b < ig->flipped_blocks_count; b++)
+	{
+		numa_free(ig->blocks[b].sources, sizeof(unsigned int) * ig->blocks[b].graph->vertices_count);
+		ig->blocks[b].sources = NULL;
+		release_numa_interleaved_ll_400_graph(ig->blocks[b].graph);
+		ig->blocks[b].graph = NULL;
+		free(ig->blocks[b].partitions);
+		ig->blocks[b].partitions = NULL;
+	}
+	free(ig->blocks);
+	ig->blocks = NULL;
+
+	release_numa_interleaved_ll_400_graph(ig->sparse);
+	ig->sparse = NULL;
+	free(ig->sparse_partitions);
+	ig->sparse_partitions = NULL;
+
+	numa_free(ig->hubs, sizeof(unsigned int) * max(1, ig->hubs_count));
+	ig->hubs = NULL;
+	numa_free(ig->threads_buffers, sizeof(double) * ig->block_hubs * ig->dp->threads_count);
+	ig->threads_buffers = NULL;
+	dynamic_partitioning_release(ig->dp);
+	ig->dp = NULL;
+
+	free(ig);
+	ig = NULL;
+
+	return;
+}
+
+/*
+	One SpMV iteration using iHTL: y[v] = sum of x[u] for all in-neighbours u of v
+
+	flags:
+		bit 0: print stats
+*/
+void ihtl_spmv(struct par_env* pe, struct ihtl_graph* ig, double* x, double* y, unsigned int flags)
+{
+	assert(pe != NULL && ig != NULL && x != NULL && y != NULL);
+	unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+	assert(ttimes != NULL);
+	struct dynamic_partitioning* dp = ig->dp;
+
+	// (1) Sparse block in pull direction, this also writes zero for hubs
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+			struct ll_400_graph* sg = ig->sparse;
+
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break;
+
+				for(unsigned int v = ig->sparse_partitions[partition]; v < ig->sparse_partitions[partition + 1]; v++)
+				{
+					double sum = 0;
+					for(unsigned long e = sg->offsets_list[v]; e < sg->offsets_list[v + 1]; e++)
+						sum += x[sg->edges_list[e]];
+					y[v] = sum;
+				}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+			PTIP("  (1) Sparse block:");
+
+	// (2) Flipped blocks in push direction
+		for(unsigned int b = 0; b < ig->flipped_blocks_count; b++)
+		{
+			struct ihtl_block* block = &ig->blocks[b];
+			struct ll_400_graph* bg = block->graph;
+
+			mt = - get_nano_time();
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				double* buffer = ig->threads_buffers + 1UL * tid * ig->block_hubs;
+
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break;
+
+					for(unsigned int s = block->partitions[partition]; s < block->partitions[partition + 1]; s++)
+					{
+						double val = x[block->sources[s]];
+						for(unsigned long e = bg->offsets_list[s]; e < bg->offsets_list[s + 1]; e++)
+							buffer[bg->edges_list[e]] += val;
+					}
+				}
+
+				#pragma omp barrier
+
+				// Reducing the buffers of threads
+				#pragma omp for nowait
+				for(unsigned int h = 0; h < block->hubs_count; h++)
+				{
+					double sum = 0;
+					for(unsigned int t = 0; t < pe->threads_count; t++)
+					{
+						sum += ig->threads_buffers[1UL * t * ig->block_hubs + h];
+						ig->threads_buffers[1UL * t * ig->block_hubs + h] = 0;
+					}
+					y[ig->hubs[block->hubs_start + h]] = sum;
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			if(flags & 1U)
+			{
+				char temp[255];
+				sprintf(temp, "  (2) Flipped block %u:", b);
+				PTIP(temp);
+			}
+		}
+
+	free(ttimes);
+	ttimes = NULL;
+
+	return;
+}
+
+/*
+	One SpMV iteration in pull direction: y[v] = sum of x[u] for all in-neighbours u of v.
+	It is used as the baseline and for validation of iHTL.
+
+	`partitions` has `partitions_count + 1` elements created by `parallel_edge_partitioning(csc, ...)`
+	and `dp` has `partitions_count` partitions.
+*/
+void spmv_pull(struct par_env* pe, struct ll_400_graph* csc, unsigned int* partitions, struct dynamic_partitioning* dp, double* x, double* y)
+{
+	assert(pe != NULL && csc != NULL && partitions != NULL && dp != NULL && x != NULL && y != NULL);
+
+	#pragma omp parallel
+	{
+		unsigned tid = omp_get_thread_num();
+		unsigned int partition = -1U;
+
+		while(1)
+		{
+			partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+			if(partition == -1U)
+				break;
+
+			for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+			{
+				double sum = 0;
+				for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+					sum += x[csc->edges_list[e]];
+				y[v] = sum;
+			}
+		}
+	}
+	dynamic_partitioning_reset(dp);
+
+	return;
+}
+
+/*
+	PageRank using SpMV iterations, with the same definition as `pagerank()` (see `LL_PR_DAMPING` in pagerank.c),
+	i.e., the rank of dangling vertices is evenly distributed among all vertices.
+
+	csr: the graph, for out-degrees
+	csc: the transposed graph, used in the pull direction if `ig` is NULL
+	ig: if not NULL, iHTL is used
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+*/
+double* spmv_pagerank(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, struct ihtl_graph* ig, unsigned int iterations, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && csr != NULL && (csc != NULL || ig != NULL));
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mspmv_pagerank\033[0;37m, %s\n", ig != NULL ? "iHTL" : "pull");
+		const double damping = LL_PR_DAMPING;
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+		double* rank = numa_alloc_interleaved(sizeof(double) * csr->vertices_count);
+		double* x = numa_alloc_interleaved(sizeof(double) * csr->vertices_count);
+		double* y = numa_alloc_interleaved(sizeof(double) * csr->vertices_count);
+		assert(rank != NULL && x != NULL && y != NULL);
+
+		unsigned int* partitions = NULL;
+		struct dynamic_partitioning* dp = NULL;
+		if(ig == NULL)
+		{
+			unsigned int partitions_count = pe->threads_count * 64;
+			partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+			assert(partitions != NULL);
+			parallel_edge_partitioning(csc, partitions, partitions_count);
+			dp = dynamic_partitioning_initialize(pe, partitions_count);
+		}
+
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < csr->vertices_count; v++)
+			rank[v] = 1.0 / csr->vertices_count;
+
+	// Iterations
+		for(unsigned int iter = 0; iter < iterations; iter++)
+		{
+			unsigned long mt = - get_nano_time();
+			double dangling_sum = 0;
+			#pragma omp parallel reduction(+:dangling_sum)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+
+				#pragma omp for nowait
+				for(unsigned int v = 0; v < csr->vertices_count; v++)
+				{
+					unsigned long degree = csr->offsets_list[v + 1] - csr->offsets_list[v];
+					if(degree)
+						x[v] = rank[v] / degree;
+					else
+					{
+						x[v] = 0;
+						dangling_sum += rank[v];
+					}
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+
+			if(ig != NULL)
+				ihtl_spmv(pe, ig, x, y, 0);
+			else
+				spmv_pull(pe, csc, partitions, dp, x, y);
+
+			const double base = (1 - damping) / csr->vertices_count + damping * dangling_sum / csr->vertices_count;
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] -= get_nano_time();
+
+				#pragma omp for
+				for(unsigned int v = 0; v < csr->vertices_count; v++)
+					rank[v] = base + damping * y[v];
+
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+
+			if(flags & 1U)
+			{
+				char temp[255];
+				sprintf(temp, "Iteration %'3u:", iter);
+				PT(temp);
+			}
+		}
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+			exec_info[0] = t0;
+
+	// Releasing memory
+		if(ig == NULL)
+		{
+			free(partitions);
+			partitions = NULL;
+			dynamic_partitioning_release(dp);
+			dp = NULL;
+		}
+		free(ttimes);
+		ttimes = NULL;
+		numa_free(x, sizeof(double) * csr->vertices_count);
+		x = NULL;
+		numa_free(y, sizeof(double) * csr->vertices_count);
+		y = NULL;
+
+	return rank;
+}
+
+#endif
@@ -0,0 +1,439 @@
+#ifndef __KCORE_C
+#define __KCORE_C
+
+// This file contains the implementation of the k-core decomposition
+
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+
+/*
+	Parallel k-core Decomposition by Bucketed Peeling
+
+	The coreness of vertices is identified by peeling the vertices in ascending order of their degrees
+	[ParK, DOI:10.1109/BigData.2014.7004366; Julienne, DOI:10.1145/3087556.3087580]:
+		(1) `sapco_sort_degree_ordering()` sorts the vertices in descending order of degrees. For each k, the
+		    vertices with initial degrees greater than or equal to k are a prefix of the sorted array.
+		(2) For each k, the frontier is initialized by scanning the prefix of the vertices with initial degrees
+		    greater than or equal to k for the vertices whose current degrees are k. Other vertices have
+		    been peeled in previous iterations, so the total size of the scanned prefixes is |V| + |E|.
+		    In each round, threads peel the frontier vertices and atomically decrement the degrees of their
+		    neighbours with degrees greater than k. A neighbour whose degree reaches k is added to the next
+		    frontier of the same k. This repeats until the frontier is empty.
+
+	As the degrees are never decremented below k, after processing all k values `degrees` contains the coreness
+	of the vertices.
+
+	The frontiers are shared SPF arrays between threads, as in Thrifty, and are processed using dynamic partitioning.
+
+	g:
+		Should be symmetric and without self-edges.
+
+	flags:
+		bit 0: print stats and the timing of rounds, grouped by k in ranges of powers of two
+		bit 1: do not reset papi
+		bit 2: print the timing of each k
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: max core
+		[9]: number of k values with peeled vertices
+		[10]: number of rounds
+		[11]: sorting time
+
+	Returns the array of coreness values
+*/
+unsigned int* kcore_peeling(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && g->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mkcore_peeling\033[0;37m using \033[3;31m%d\033[0;37m threads.\n", pe->threads_count);
+		unsigned long vc = g->vertices_count;
+
+	// (1) Initial bucketing using SAPCo Sort
+		unsigned long mt = - get_nano_time();
+		unsigned int* RA_n2o = sapco_sort_degree_ordering(pe, g, NULL, 2U);
+		unsigned int max_degree = g->offsets_list[RA_n2o[0] + 1] - g->offsets_list[RA_n2o[0]];
+
+		unsigned int* degrees = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		unsigned int* prefix_lengths = numa_alloc_interleaved(sizeof(unsigned int) * (max_degree + 2));
+		assert(degrees != NULL && prefix_lengths != NULL);
+
+		// prefix_lengths[d]: number of vertices with degrees greater than or equal to d
+		#pragma omp parallel for
+		for(unsigned int d = 0; d <= max_degree + 1; d++)
+			prefix_lengths[d] = -1U;
+
+		#pragma omp parallel for
+		for(unsigned int i = 0; i < vc; i++)
+		{
+			unsigned int v = RA_n2o[i];
+			unsigned int d = g->offsets_list[v + 1] - g->offsets_list[v];
+			degrees[v] = d;
+			if(i + 1 == vc || d != g->offsets_list[RA_n2o[i + 1] + 1] - g->offsets_list[RA_n2o[i + 1]])
+				prefix_lengths[d] = i + 1;
+		}
+
+		prefix_lengths[max_degree + 1] = 0;
+		for(unsigned int d = max_degree; d != -1U; d--)
+			if(prefix_lengths[d] == -1U)
+				prefix_lengths[d] = prefix_lengths[d + 1];
+		mt += get_nano_time();
+		if(exec_info)
+			exec_info[11] = mt;
+		if(flags & 1U)
+			PT("(1) Initial bucketing:");
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocating memory for the frontiers
+		unsigned int waspr = 16;  // worklist_allocation_size_per_request
+		unsigned long worklist_size = vc + 3 * waspr * pe->threads_count;
+		unsigned int* worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+		unsigned int* next_worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+		assert(worklist != NULL && next_worklist != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+		unsigned int partitions_count = pe->threads_count * 64;
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (2) Peeling
+		unsigned long peeled = 0;
+		unsigned int max_core = 0;
+		unsigned long levels = 0;
+		unsigned long rounds = 0;
+
+		// Grouping the timing of k values in ranges of powers of two
+		unsigned long group_time = 0;
+		unsigned long group_peeled = 0;
+		unsigned long group_rounds = 0;
+		unsigned int group_start = 0;
+
+		for(unsigned int k = 0; k <= max_degree && peeled < vc; k++)
+		{
+			unsigned long k_peeled = 0;
+			unsigned long k_rounds = 0;
+			unsigned long k_time = - get_nano_time();
+
+			// Scanning the vertices with initial degrees >= k to create the first frontier
+			unsigned int* frontier = NULL;
+			unsigned long frontier_length = 0;
+			{
+				unsigned int next_worklist_length = waspr * pe->threads_count;
+				unsigned long scan_length = prefix_lengths[k];
+				unsigned long added = 0;
+
+				#pragma omp parallel reduction(+:added)
+				{
+					unsigned tid = omp_get_thread_num();
+					unsigned int index = tid * waspr;
+					unsigned int end = (tid + 1) * waspr;
+					unsigned int partition = -1U;
+
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+
+						unsigned long start = (scan_length * partition) / partitions_count;
+						unsigned long stop = (scan_length * (partition + 1)) / partitions_count;
+						for(unsigned long i = start; i < stop; i++)
+						{
+							unsigned int v = RA_n2o[i];
+							if(degrees[v] != k)
+								continue;
+
+							// add to frontier
+							added++;
+							next_worklist[index++] = v;
+							if(index == end)
+							{
+								// grab a new chunk
+								do
+								{
+									index = next_worklist_length;
+									end = index + waspr;
+								}while(__sync_val_compare_and_swap(&next_worklist_length, index, end) != index);
+								assert(next_worklist_length <= worklist_size);
+							}
+						}
+					}
+
+					// fill unused indecis with -1 to prevent from being processed
+					while(index < end)
+						next_worklist[index++] = -1U;
+				}
+				dynamic_partitioning_reset(dp);
+
+				// swapping
+				unsigned int* temp = worklist;
+				worklist = next_worklist;
+				next_worklist = temp;
+				frontier = worklist;
+				frontier_length = next_worklist_length;
+				if(added == 0)
+					frontier_length = 0;
+			}
+
+			while(frontier_length)
+			{
+				unsigned int next_worklist_length = waspr * pe->threads_count;
+				unsigned long round_peeled = 0;
+				unsigned long round_added = 0;
+
+				#pragma omp parallel reduction(+:round_peeled, round_added)
+				{
+					unsigned tid = omp_get_thread_num();
+					ttimes[tid] = - get_nano_time();
+					unsigned int index = tid * waspr;
+					unsigned int end = (tid + 1) * waspr;
+					unsigned int partition = -1U;
+
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+
+						unsigned long start = (frontier_length * partition) / partitions_count;
+						unsigned long stop = (frontier_length * (partition + 1)) / partitions_count;
+						for(unsigned long i = start; i < stop; i++)
+						{
+							unsigned int v = frontier[i];
+							if(v == -1U)
+								continue;
+
+							round_peeled++;
+							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							{
+								unsigned int u = g->edges_list[e];
+								unsigned int du = degrees[u];
+								while(du > k)
+								{
+									if(__atomic_compare_exchange_n(&degrees[u], &du, du - 1, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+									{
+										if(du - 1 == k)
+										{
+											// add to next frontier
+											round_added++;
+											next_worklist[index++] = u;
+											if(index == end)
+											{
+												// grab a new chunk
+												do
+												{
+													index = next_worklist_length;
+													end = index + waspr;
+												}while(__sync_val_compare_and_swap(&next_worklist_length, index, end) != index);
+												assert(next_worklist_length <= worklist_size);
+											}
+										}
+										break;
+									}
+								}
+							}
+						}
+					}
+
+					// fill unused indecis with -1 to prevent from being processed in the next round
+					while(index < end)
+						next_worklist[index++] = -1U;
+
+					ttimes[tid] += get_nano_time();
+				}
+				dynamic_partitioning_reset(dp);
+				k_rounds++;
+				k_peeled += round_peeled;
+
+				// swapping
+				{
+					unsigned int* temp = worklist;
+					worklist = next_worklist;
+					next_worklist = temp;
+					frontier = worklist;
+					frontier_length = next_worklist_length;
+					if(round_added == 0)
+						frontier_length = 0;
+				}
+			}
+			k_time += get_nano_time();
+
+			if(k_peeled)
+			{
+				max_core = k;
+				levels++;
+			}
+			peeled += k_peeled;
+			rounds += k_rounds;
+
+			if((flags & 4U) && k_peeled)
+				printf("  k: %'8u, peeled: %'12lu, rounds: %'6lu, time: %'10.2f (ms)\n", k, k_peeled, k_rounds, k_time / 1e6);
+
+			group_time += k_time;
+			group_peeled += k_peeled;
+			group_rounds += k_rounds;
+			if((k & (k + 1)) == 0 || k == max_degree || peeled == vc)
+			{
+				if((flags & 1U) && group_peeled)
+					printf("  k: %'8u - %'8u, peeled: %'12lu, rounds: %'6lu, time: %'10.2f (ms)\n", group_start, k,
+						group_peeled, group_rounds, group_time / 1e6);
+				group_start = k + 1;
+				group_time = 0;
+				group_peeled = 0;
+				group_rounds = 0;
+			}
+		}
+		assert(peeled == vc);
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Max core:         \t\t%'u\n", max_core);
+		if(flags & 1U)
+			printf("Non-empty k values: %'lu, Rounds: %'lu\n", levels, rounds);
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = max_core;
+			exec_info[9] = levels;
+			exec_info[10] = rounds;
+		}
+
+	// Releasing memory
+		numa_free(RA_n2o, sizeof(unsigned int) * vc);
+		RA_n2o = NULL;
+		numa_free(prefix_lengths, sizeof(unsigned int) * (max_degree + 2));
+		prefix_lengths = NULL;
+		numa_free(worklist, sizeof(unsigned int) * worklist_size);
+		worklist = NULL;
+		numa_free(next_worklist, sizeof(unsigned int) * worklist_size);
+		next_worklist = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return degrees;
+}
+
+/*
+	Serial k-core decomposition [Batagelj and Zaversnik, arXiv:cs/0310049]. We use this for validation of results.
+*/
+unsigned int* kcore_serial(struct ll_400_graph* g)
+{
+	// Initial checks
+		assert(g != NULL);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;33mkcore_serial\033[0;37m\n");
+		unsigned long vc = g->vertices_count;
+
+	// Memory allocation
+		unsigned int max_degree = 0;
+		for(unsigned int v = 0; v < vc; v++)
+			max_degree = max(max_degree, g->offsets_list[v + 1] - g->offsets_list[v]);
+
+		unsigned int* degrees = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		unsigned int* positions = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		unsigned int* vertices = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		unsigned int* bins = calloc(sizeof(unsigned int), max_degree + 2);
+		assert(degrees != NULL && positions != NULL && vertices != NULL && bins != NULL);
+
+	// Sorting vertices by degree
+		for(unsigned int v = 0; v < vc; v++)
+		{
+			degrees[v] = g->offsets_list[v + 1] - g->offsets_list[v];
+			bins[degrees[v]]++;
+		}
+		unsigned int start = 0;
+		for(unsigned int d = 0; d <= max_degree; d++)
+		{
+			unsigned int temp = bins[d];
+			bins[d] = start;
+			start += temp;
+		}
+		for(unsigned int v = 0; v < vc; v++)
+		{
+			positions[v] = bins[degrees[v]]++;
+			vertices[positions[v]] = v;
+		}
+		for(unsigned int d = max_degree; d >= 1; d--)
+			bins[d] = bins[d - 1];
+		bins[0] = 0;
+
+	// Peeling
+		for(unsigned int i = 0; i < vc; i++)
+		{
+			unsigned int v = vertices[i];
+			for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+			{
+				unsigned int u = g->edges_list[e];
+				if(degrees[u] <= degrees[v])
+					continue;
+
+				// Moving u to the start of its bin and decrementing its degree
+				unsigned int du = degrees[u];
+				unsigned int pu = positions[u];
+				unsigned int pw = bins[du];
+				unsigned int w = vertices[pw];
+				if(u != w)
+				{
+					positions[u] = pw;
+					vertices[pu] = w;
+					positions[w] = pu;
+					vertices[pw] = u;
+				}
+				bins[du]++;
+				degrees[u]--;
+			}
+		}
+
+	// Releasing memory
+		numa_free(positions, sizeof(unsigned int) * vc);
+		positions = NULL;
+		numa_free(vertices, sizeof(unsigned int) * vc);
+		vertices = NULL;
+		free(bins);
+		bins = NULL;
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Exec. time: \t\t %'.1f (ms) \n", t0 / 1e6);
+
+	return degrees;
+}
+
+void kcore_release(struct ll_400_graph* g, unsigned int* cores)
+{
+	assert(g != NULL && cores != NULL);
+
+	numa_free(cores, sizeof(unsigned int) * g->vertices_count);
+	cores = NULL;
+
+	return;
+}
+
+#endif
@@ -31,7 +31,7 @@ function ul2s()
 # Print help
 	echo -e "\n\033[1;35mLaganLighter Launcher Script\033[0;37m\n"
 	echo "Arguments to be passed to this script:"
-	echo "  alg=algorithm-filename (with or without .c)"
+	echo "  alg=algorithm-filename (with or without .c), available: "`ls alg*.c | sort -V | sed 's/\.c$//' | xargs | sed 's/ /, /g'`
 	echo "  df=path/to/datasets/folder (default ./data)"
 	echo "  make-flags=\"flags (e.g. \`threads\`, \`hyperthreading\`, \`energy\`,\`debug\`, and/or \`wait_passive\`) to be passed to the make, separated by space, and double quoted\" (default empty)"
 	echo "  program-args=\"arguemnts to be passed to the \`program\` by \`make\`, separated by space, and double quoted\" (default empty)"
@@ -41,6 +41,7 @@ function ul2s()
 	echo "  -iw (include weighted graphs, default: false)"
 	echo "  -shm-store (store graphs in shm, default: 0)"
 	echo "  -shm-delete (delete shm graphs at the end, default: 0)"
+	echo "  -shm-huge (use huge pages for shm graphs, default: 0)"
 	echo "  report-title=\"A double quoted string that will be printed on top of the report file\" (default empty)"
 
 	echo
@@ -69,6 +70,7 @@ function ul2s()
 	LD=0
 	SHM_STORE=0
 	SHM_DELETE=0
+	SHM_HUGE=0
 	REPORT_TITLE=""
 
 	for i in `seq 1 $#`; do
@@ -108,6 +110,10 @@ function ul2s()
 			SHM_DELETE=1
 		fi
 
+		if [ "${!i}" == "-shm-huge" ]; then
+			SHM_HUGE=1
+		fi
+
 		if [[ "${!i}" == *"report-title"* ]]; then 
 			REPORT_TITLE=`echo "${!i}" | cut -f2- -d=`
 		fi
@@ -130,6 +136,7 @@ function ul2s()
 	echo "  Include weighted graphs (-iw): $IW"
 	echo "  Store graph in shm (-shm-store): $SHM_STORE"
 	echo "  Delete shm graphs at end (-shm-delete): $SHM_DELETE"
+	echo "  Use huge pages for shm graphs (-shm-huge): $SHM_HUGE"
 	echo "  Report title (report-title): $REPORT_TITLE"
 	echo 
 
@@ -153,8 +160,13 @@ function ul2s()
 		vertices_count=0
 		
 		if [ $suffix == "txt" ]; then
-			edges_count=`head "$DF/$ds" -n2 | tail -n1`
-			vertices_count=`head "$DF/$ds" -n1`
+			if [[ $ds == *"_props.txt" ]]; then
+				edges_count=`cat "$DF/$ds" | grep -P "^edges-count:" | cut -f2 -d: | xargs`
+				vertices_count=`cat "$DF/$ds" | grep -P "^vertices-count:" | cut -f2 -d: | xargs`
+			else
+				edges_count=`head "$DF/$ds" -n2 | tail -n1`
+				vertices_count=`head "$DF/$ds" -n1`
+			fi
 		fi
 
 		if [ $suffix == "graph" ]; then
@@ -289,6 +301,10 @@ function ul2s()
 		if [ $suffix == "txt" ]; then
 			input_graph="$DF/$ds"
 			input_type="text"
+			if [[ $ds == *"_props.txt" ]]; then
+				input_graph="$DF/"`echo $ds | sed 's/\(.*\)_props\.txt/\1/'`
+				input_type="COMPBIN"
+			fi
 		fi
 		if [ $suffix == "graph" ]; then
 			input_graph="$DF/"`echo $ds | sed 's/\(.*\)\.graph/\1/'`
@@ -311,7 +327,7 @@ function ul2s()
 
 		cmd="LL_INPUT_GRAPH_PATH=$input_graph LL_INPUT_GRAPH_TYPE=$input_type"
 		cmd="$cmd LL_INPUT_GRAPH_BATCH_ORDER=$c LL_INPUT_GRAPH_IS_SYMMETRIC=$is_sym"
-		cmd="$cmd LL_STORE_INPUT_GRAPH_IN_SHM=$SHM_STORE LL_OUTPUT_REPORT_PATH=$home_folder"/"$report_path"
+		cmd="$cmd LL_STORE_INPUT_GRAPH_IN_SHM=$SHM_STORE LL_SHM_HUGE_PAGES=$SHM_HUGE LL_OUTPUT_REPORT_PATH=$home_folder"/"$report_path"
 		cmd="$cmd LL_GRAPH_RA_BIN_FOLDER=$DF/RA_bin_arrays"
 		
 		echo "  $c, $input_graph:"
@@ -0,0 +1,609 @@
+#ifndef __LOTUS_C
+#define __LOTUS_C
+
+// This file contains the implementation of the LOTUS Triangle Counting
+
+#include "aux.c"
+#include "graph.c"
+#include "trans.c"
+#include "relabel.c"
+
+/*
+	LOTUS: Locality Optimizing Triangle Counting
+
+	https://doi.org/10.1145/3503221.3508402
+
+	@INPROCEEDINGS{lotus,
+	  author = {Koohi Esfahani, Mohsen and Kilpatrick, Peter and Vandierendonck, Hans},
+	  booktitle = {27th ACM SIGPLAN Annual Symposium on Principles and Practice of Parallel Programming (PPoPP 2022)},
+	  title = {LOTUS: Locality Optimizing Triangle Counting},
+	  year = {2022},
+	  numpages = {15},
+	  pages={219–233},
+	  publisher = {Association for Computing Machinery},
+	  address = {New York, NY, USA},
+	  doi = {10.1145/3503221.3508402}
+	}
+
+	The graph is relabelled in descending degree order, so the `hubs_count` vertices with the greatest degrees
+	have IDs [0, hubs_count). Each triangle (a, b, c) with a < b < c is counted once from c as:
+		- HHH and HHN: if b is a hub, then a is also a hub. The pairs of the hub neighbours of c are searched in
+		  the bit array of the hub-hub edges (`HE`). `hubs_count` is selected such that `HE` fits in half of the L3 cache.
+		- HNN and NNN: if b is a non-hub, then c is also a non-hub. For each non-hub neighbour b of c, the hub-lists
+		  and non-hub lists of b and c are intersected.
+
+	The compact data structures:
+		`HE`: a bit array with `hubs_count * (hubs_count - 1) / 2` bits, bit `b * (b - 1) / 2 + a` specifies if there is
+			an edge between hubs a < b.
+		`H_offsets` and `H_edges`: for each vertex v, its hub neighbours with IDs smaller than v, as 2 Bytes IDs.
+		`N_graph`: for each non-hub vertex v, its non-hub neighbours with IDs smaller than v.
+
+	Squared Edge Tiling: in counting HHH and HHN, the work of the j-th hub neighbour of a vertex is j. The hub-list of
+	vertices with more work than a tile are divided into tiles [|L| * sqrt(k / T), |L| * sqrt((k + 1) / T)) that
+	have almost the same work.
+
+	g:
+		Should be symmetric, with sorted neighbour-lists and without self-edges.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events of the counting phases
+		[8]: HHH triangles
+		[9]: HHN triangles
+		[10]: HNN triangles
+		[11]: NNN triangles
+		[12]: relabelling time
+		[13]: creating data structures time
+		[14]: HHH & HHN counting time
+		[15]: HNN & NNN counting time
+		[16]: hubs count
+*/
+
+#define LL_LOTUS_MAX_HUBS 65536
+#define LL_LOTUS_MAX_TILES 4096
+
+// Converts `counts` (with `count + 1` elements) to offsets using a parallel prefix sum
+void __lotus_prefix_sum(unsigned long* counts, unsigned long count, unsigned int partitions_count)
+{
+	unsigned long* partitions_sums = calloc(sizeof(unsigned long), partitions_count);
+	assert(partitions_sums != NULL);
+
+	#pragma omp parallel for
+	for(unsigned int p = 0; p < partitions_count; p++)
+	{
+		unsigned long start = (count / partitions_count) * p;
+		unsigned long end = (count / partitions_count) * (p + 1);
+		if(p + 1 == partitions_count)
+			end = count;
+
+		unsigned long sum = 0;
+		for(unsigned long v = start; v < end; v++)
+			sum += counts[v];
+		partitions_sums[p] = sum;
+	}
+
+	unsigned long total = 0;
+	for(unsigned int p = 0; p < partitions_count; p++)
+	{
+		unsigned long temp = partitions_sums[p];
+		partitions_sums[p] = total;
+		total += temp;
+	}
+
+	#pragma omp parallel for
+	for(unsigned int p = 0; p < partitions_count; p++)
+	{
+		unsigned long start = (count / partitions_count) * p;
+		unsigned long end = (count / partitions_count) * (p + 1);
+		if(p + 1 == partitions_count)
+			end = count;
+
+		unsigned long offset = partitions_sums[p];
+		for(unsigned long v = start; v < end; v++)
+		{
+			unsigned long temp = counts[v];
+			counts[v] = offset;
+			offset += temp;
+		}
+	}
+	counts[count] = total;
+
+	free(partitions_sums);
+	partitions_sums = NULL;
+
+	return;
+}
+
+// Returns the number of common elements of two sorted lists
+unsigned long __lotus_intersect_uint(unsigned int* a, unsigned long a_len, unsigned int* b, unsigned long b_len)
+{
+	unsigned long count = 0;
+	unsigned long i = 0, j = 0;
+	while(i < a_len && j < b_len)
+	{
+		if(a[i] < b[j])
+			i++;
+		else if(a[i] > b[j])
+			j++;
+		else
+		{
+			count++;
+			i++;
+			j++;
+		}
+	}
+
+	return count;
+}
+
+unsigned long __lotus_intersect_ushort(unsigned short* a, unsigned long a_len, unsigned short* b, unsigned long b_len)
+{
+	unsigned long count = 0;
+	unsigned long i = 0, j = 0;
+	while(i < a_len && j < b_len)
+	{
+		if(a[i] < b[j])
+			i++;
+		else if(a[i] > b[j])
+			j++;
+		else
+		{
+			count++;
+			i++;
+			j++;
+		}
+	}
+
+	return count;
+}
+
+unsigned long lotus(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && g->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mlotus\033[0;37m using \033[3;31m%d\033[0;37m threads.\n", pe->threads_count);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (1) Relabelling in descending degree order
+		unsigned long mt = - get_nano_time();
+		struct ll_400_graph* rg = NULL;
+		{
+			unsigned int* RA_n2o = sapco_sort_degree_ordering(pe, g, NULL, 0);
+			unsigned int* RA_o2n = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+			assert(RA_o2n != NULL);
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				RA_o2n[RA_n2o[v]] = v;
+
+			rg = relabel_graph(pe, g, RA_o2n, 2U); // 2U: sort neighbour-lists
+
+			numa_free(RA_n2o, sizeof(unsigned int) * g->vertices_count);
+			RA_n2o = NULL;
+			numa_free(RA_o2n, sizeof(unsigned int) * g->vertices_count);
+			RA_o2n = NULL;
+		}
+		mt += get_nano_time();
+		if(exec_info)
+			exec_info[12] = mt;
+		if(flags & 1U)
+			PT("(1) Relabelling:");
+
+	// (2) Creating data structures
+		mt = - get_nano_time();
+		unsigned long l3_size = pe->L3_cache_size;
+		if(l3_size == 0)
+			l3_size = 8UL * 1024 * 1024;
+		unsigned int hubs_count = min(min(g->vertices_count, LL_LOTUS_MAX_HUBS), (unsigned long)sqrt(2.0 * 8 * l3_size / 2));
+		unsigned long he_bits = 1UL * hubs_count * (hubs_count - 1) / 2;
+		unsigned long he_words = (he_bits + 63) / 64;
+		unsigned long* HE = numa_alloc_interleaved(sizeof(unsigned long) * max(1, he_words));
+		unsigned long* H_offsets = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		struct ll_400_graph* N_graph = calloc(sizeof(struct ll_400_graph), 1);
+		assert(HE != NULL && H_offsets != NULL && N_graph != NULL);
+		N_graph->vertices_count = g->vertices_count;
+		N_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(N_graph->offsets_list != NULL);
+
+		#pragma omp parallel for
+		for(unsigned long w = 0; w < he_words; w++)
+			HE[w] = 0;
+
+		// HE
+		#pragma omp parallel for schedule(dynamic, 64)
+		for(unsigned int b = 1; b < hubs_count; b++)
+		{
+			unsigned long base = 1UL * b * (b - 1) / 2;
+			for(unsigned long e = rg->offsets_list[b]; e < rg->offsets_list[b + 1]; e++)
+			{
+				unsigned int a = rg->edges_list[e];
+				if(a >= b)
+					break;
+				unsigned long bit = base + a;
+				__atomic_fetch_or(&HE[bit >> 6], 1UL << (bit & 63), __ATOMIC_RELAXED);
+			}
+		}
+
+		// Degrees in H_offsets and N_graph
+		#pragma omp parallel for schedule(dynamic, 1024)
+		for(unsigned int v = 0; v < rg->vertices_count; v++)
+		{
+			unsigned long h_degree = 0;
+			unsigned long n_degree = 0;
+			unsigned int h_limit = min(v, hubs_count);
+			for(unsigned long e = rg->offsets_list[v]; e < rg->offsets_list[v + 1]; e++)
+			{
+				unsigned int u = rg->edges_list[e];
+				if(u >= v)
+					break;
+				if(e > rg->offsets_list[v] && u == rg->edges_list[e - 1])
+					continue;
+				if(u < h_limit)
+					h_degree++;
+				else if(v >= hubs_count)
+					n_degree++;
+			}
+			H_offsets[v] = h_degree;
+			N_graph->offsets_list[v] = n_degree;
+		}
+		__lotus_prefix_sum(H_offsets, g->vertices_count, partitions_count);
+		__lotus_prefix_sum(N_graph->offsets_list, g->vertices_count, partitions_count);
+		N_graph->edges_count = N_graph->offsets_list[g->vertices_count];
+
+		unsigned long H_edges_count = H_offsets[g->vertices_count];
+		unsigned short* H_edges = numa_alloc_interleaved(sizeof(unsigned short) * max(1, H_edges_count));
+		N_graph->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * max(1, N_graph->edges_count));
+		assert(H_edges != NULL && N_graph->edges_list != NULL);
+
+		#pragma omp parallel for schedule(dynamic, 1024)
+		for(unsigned int v = 0; v < rg->vertices_count; v++)
+		{
+			unsigned long h_offset = H_offsets[v];
+			unsigned long n_offset = N_graph->offsets_list[v];
+			unsigned int h_limit = min(v, hubs_count);
+			for(unsigned long e = rg->offsets_list[v]; e < rg->offsets_list[v + 1]; e++)
+			{
+				unsigned int u = rg->edges_list[e];
+				if(u >= v)
+					break;
+				if(e > rg->offsets_list[v] && u == rg->edges_list[e - 1])
+					continue;
+				if(u < h_limit)
+					H_edges[h_offset++] = u;
+				else if(v >= hubs_count)
+					N_graph->edges_list[n_offset++] = u;
+			}
+			assert(h_offset == H_offsets[v + 1] && n_offset == N_graph->offsets_list[v + 1]);
+		}
+
+		release_numa_interleaved_ll_400_graph(rg);
+		rg = NULL;
+
+		mt += get_nano_time();
+		if(exec_info)
+		{
+			exec_info[13] = mt;
+			exec_info[16] = hubs_count;
+		}
+		if(flags & 1U)
+		{
+			PT("(2) Creating data structures:");
+			printf("  Hubs: %'u, HE: %'.1f (KB), H-edges: %'lu, N-edges: %'lu\n",
+				hubs_count, he_words * 8 / 1024.0, H_edges_count, N_graph->edges_count);
+		}
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// (3) Counting HHH and HHN triangles
+		mt = - get_nano_time();
+		unsigned long hhh = 0;
+		unsigned long hhn = 0;
+		{
+			// Total work and the tile size
+			unsigned long total_work = 0;
+			#pragma omp parallel for reduction(+:total_work)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+			{
+				unsigned long len = H_offsets[v + 1] - H_offsets[v];
+				total_work += len * len / 2;
+			}
+			unsigned long tile_work = max(1024UL, total_work / partitions_count);
+
+			// Identifying vertices that require tiling
+			unsigned int tiled_count = 0;
+			unsigned int* tiled_vertices = calloc(sizeof(unsigned int), partitions_count + 1);
+			assert(tiled_vertices != NULL);
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+			{
+				unsigned long len = H_offsets[v + 1] - H_offsets[v];
+				if(len * len / 2 > tile_work)
+				{
+					unsigned int index = __atomic_fetch_add(&tiled_count, 1U, __ATOMIC_RELAXED);
+					assert(index <= partitions_count);
+					tiled_vertices[index] = v;
+				}
+			}
+
+			// Creating the tiles: (vertex, start index, end index)
+			unsigned long tiles_count = 0;
+			for(unsigned int t = 0; t < tiled_count; t++)
+			{
+				unsigned int v = tiled_vertices[t];
+				unsigned long len = H_offsets[v + 1] - H_offsets[v];
+				tiles_count += min(LL_LOTUS_MAX_TILES, (len * len / 2 + tile_work - 1) / tile_work);
+			}
+			unsigned long* tiles = calloc(sizeof(unsigned long), 3 * max(1, tiles_count));
+			assert(tiles != NULL);
+			{
+				unsigned long i = 0;
+				for(unsigned int t = 0; t < tiled_count; t++)
+				{
+					unsigned int v = tiled_vertices[t];
+					unsigned long len = H_offsets[v + 1] - H_offsets[v];
+					unsigned long T = min(LL_LOTUS_MAX_TILES, (len * len / 2 + tile_work - 1) / tile_work);
+					unsigned long start = 0;
+					for(unsigned long k = 0; k < T; k++)
+					{
+						unsigned long end = len * sqrt(1.0 * (k + 1) / T);
+						if(k + 1 == T)
+							end = len;
+						tiles[3 * i] = v;
+						tiles[3 * i + 1] = start;
+						tiles[3 * i + 2] = end;
+						start = end;
+						i++;
+					}
+				}
+				assert(i == tiles_count);
+			}
+
+			struct ll_400_graph h_graph = {g->vertices_count, H_edges_count, H_offsets, NULL};
+			parallel_edge_partitioning(&h_graph, partitions, partitions_count);
+
+			#pragma omp parallel reduction(+:hhh, hhn)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+
+				// Tiles
+				#pragma omp for schedule(dynamic, 1) nowait
+				for(unsigned long i = 0; i < tiles_count; i++)
+				{
+					unsigned int c = tiles[3 * i];
+					unsigned short* L = H_edges + H_offsets[c];
+					unsigned long count = 0;
+					for(unsigned long j = tiles[3 * i + 1]; j < tiles[3 * i + 2]; j++)
+					{
+						unsigned long base = 1UL * L[j] * (L[j] - 1) / 2;
+						for(unsigned long k = 0; k < j; k++)
+						{
+							unsigned long bit = base + L[k];
+							count += (HE[bit >> 6] >> (bit & 63)) & 1UL;
+						}
+					}
+					if(c < hubs_count)
+						hhh += count;
+					else
+						hhn += count;
+				}
+
+				// Other vertices
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break;
+
+					for(unsigned int c = partitions[partition]; c < partitions[partition + 1]; c++)
+					{
+						unsigned long len = H_offsets[c + 1] - H_offsets[c];
+						if(len < 2 || len * len / 2 > tile_work)
+							continue;
+
+						unsigned short* L = H_edges + H_offsets[c];
+						unsigned long count = 0;
+						for(unsigned long j = 1; j < len; j++)
+						{
+							unsigned long base = 1UL * L[j] * (L[j] - 1) / 2;
+							for(unsigned long k = 0; k < j; k++)
+							{
+								unsigned long bit = base + L[k];
+								count += (HE[bit >> 6] >> (bit & 63)) & 1UL;
+							}
+						}
+						if(c < hubs_count)
+							hhh += count;
+						else
+							hhn += count;
+					}
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+			dynamic_partitioning_reset(dp);
+
+			if(flags & 1U)
+				printf("  Tiled vertices: %'u, Tiles: %'lu, Tile work: %'lu\n", tiled_count, tiles_count, tile_work);
+
+			free(tiles);
+			tiles = NULL;
+			free(tiled_vertices);
+			tiled_vertices = NULL;
+		}
+		mt += get_nano_time();
+		if(exec_info)
+			exec_info[14] = mt;
+		if(flags & 1U)
+			PTIP("(3) Counting HHH and HHN:");
+
+	// (4) Counting HNN and NNN triangles
+		mt = - get_nano_time();
+		unsigned long hnn = 0;
+		unsigned long nnn = 0;
+		{
+			parallel_edge_partitioning(N_graph, partitions, partitions_count);
+
+			#pragma omp parallel reduction(+:hnn, nnn)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break;
+
+					for(unsigned int c = partitions[partition]; c < partitions[partition + 1]; c++)
+					{
+						unsigned long c_h_len = H_offsets[c + 1] - H_offsets[c];
+						unsigned long c_n_len = N_graph->offsets_list[c + 1] - N_graph->offsets_list[c];
+						unsigned short* c_h = H_edges + H_offsets[c];
+						unsigned int* c_n = N_graph->edges_list + N_graph->offsets_list[c];
+
+						for(unsigned long e = 0; e < c_n_len; e++)
+						{
+							unsigned int b = c_n[e];
+							hnn += __lotus_intersect_ushort(c_h, c_h_len, H_edges + H_offsets[b], H_offsets[b + 1] - H_offsets[b]);
+							// The non-hub neighbours of b are smaller than b, so only c_n[0..e) are searched
+							nnn += __lotus_intersect_uint(c_n, e, N_graph->edges_list + N_graph->offsets_list[b],
+								N_graph->offsets_list[b + 1] - N_graph->offsets_list[b]);
+						}
+					}
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+			dynamic_partitioning_reset(dp);
+		}
+		mt += get_nano_time();
+		if(exec_info)
+			exec_info[15] = mt;
+		if(flags & 1U)
+			PTIP("(4) Counting HNN and NNN:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		unsigned long triangles = hhh + hhn + hnn + nnn;
+		printf("Triangles:        \t\t%'lu\n", triangles);
+		if(flags & 1U)
+			printf("  HHH: %'lu, HHN: %'lu, HNN: %'lu, NNN: %'lu\n", hhh, hhn, hnn, nnn);
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = hhh;
+			exec_info[9] = hhn;
+			exec_info[10] = hnn;
+			exec_info[11] = nnn;
+		}
+
+	// Releasing memory
+		numa_free(HE, sizeof(unsigned long) * max(1, he_words));
+		HE = NULL;
+		numa_free(H_offsets, sizeof(unsigned long) * (1 + g->vertices_count));
+		H_offsets = NULL;
+		numa_free(H_edges, sizeof(unsigned short) * max(1, H_edges_count));
+		H_edges = NULL;
+		numa_free(N_graph->edges_list, sizeof(unsigned int) * max(1, N_graph->edges_count));
+		N_graph->edges_list = NULL;
+		N_graph->edges_count = 0;
+		release_numa_interleaved_ll_400_graph(N_graph);
+		N_graph = NULL;
+
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return triangles;
+}
+
+/*
+	Triangle counting by merging the sorted lists of neighbours with smaller IDs.
+	It is used for validation of LOTUS.
+
+	g:
+		Should be symmetric, with sorted neighbour-lists and without self-edges.
+*/
+unsigned long tc_merge(struct par_env* pe, struct ll_400_graph* g)
+{
+	assert(pe != NULL && g != NULL);
+	unsigned long t0 = - get_nano_time();
+	printf("\n\033[3;31mtc_merge\033[0;37m\n");
+
+	unsigned int partitions_count = pe->threads_count * 64;
+	unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+	assert(partitions != NULL);
+	parallel_edge_partitioning(g, partitions, partitions_count);
+
+	unsigned long triangles = 0;
+	#pragma omp parallel for schedule(dynamic, 1) reduction(+:triangles)
+	for(unsigned int p = 0; p < partitions_count; p++)
+		for(unsigned int c = partitions[p]; c < partitions[p + 1]; c++)
+		{
+			unsigned int* c_n = g->edges_list + g->offsets_list[c];
+			unsigned long c_len = 0;
+			while(g->offsets_list[c] + c_len < g->offsets_list[c + 1] && c_n[c_len] < c)
+				c_len++;
+
+			for(unsigned long e = 0; e < c_len; e++)
+			{
+				unsigned int b = c_n[e];
+				if(e > 0 && b == c_n[e - 1])
+					continue;
+
+				unsigned int* b_n = g->edges_list + g->offsets_list[b];
+				unsigned long b_len = 0;
+				while(g->offsets_list[b] + b_len < g->offsets_list[b + 1] && b_n[b_len] < b)
+					b_len++;
+
+				triangles += __lotus_intersect_uint(c_n, e, b_n, b_len);
+			}
+		}
+
+	free(partitions);
+	partitions = NULL;
+
+	t0 += get_nano_time();
+	printf("Triangles:        \t\t%'lu\n", triangles);
+	printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+
+	return triangles;
+}
+
+#endif
@@ -0,0 +1,302 @@
+#ifndef __MATCHING_C
+#define __MATCHING_C
+
+// This file contains the implementation of the Skipper maximal matching
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+
+/*
+	Skipper: Single-Pass Asynchronous Maximal Matching
+
+	Each vertex has a state in `mates`:
+		`LL_MATCHING_AVAILABLE`: the vertex is not matched,
+		`LL_MATCHING_RESERVED`: a thread is matching the vertex,
+		otherwise: the ID of the vertex that is matched to this vertex.
+
+	The edges are processed in a single pass. For each edge (v, u), the vertex with the smaller ID is reserved
+	first and then the other one, using CAS. If both are reserved, they are matched. If the second vertex has
+	already been matched, the first one is released. A thread that finds a reserved vertex waits for it
+	to be matched or released, i.e., there is no deadlock as each thread holding a reservation waits only for
+	a vertex with a greater ID. As the states of the matched vertices do not change, each edge that is not
+	matched when it is processed has at least one matched endpoint, i.e., the matching is maximal.
+
+	The graph is not required to be symmetric, as each edge is processed from one of its endpoints.
+	Self-edges are skipped.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of matched edges
+		[9]: number of conflicts, i.e., reading a reserved vertex
+		[10]: number of processed edges
+
+	Returns the array of mates
+*/
+
+#define LL_MATCHING_AVAILABLE (-1U)
+#define LL_MATCHING_RESERVED (-2U)
+
+unsigned int* skipper_matching(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned long* matched_edges)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && g->vertices_count > 0);
+		assert(g->vertices_count < LL_MATCHING_RESERVED);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mskipper_matching\033[0;37m using \033[3;31m%d\033[0;37m threads.\n", pe->threads_count);
+
+	// Allocate memory
+		unsigned int* mates = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(mates != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			mates[v] = LL_MATCHING_AVAILABLE;
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Matching
+		unsigned long mt = - get_nano_time();
+		unsigned long matched = 0;
+		unsigned long conflicts = 0;
+		unsigned long processed_edges = 0;
+		#pragma omp parallel reduction(+:matched, conflicts, processed_edges)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break;
+
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = g->edges_list[e];
+						if(u == v)
+							continue;
+
+						// Skipping edges with a matched endpoint
+						unsigned int sv = __atomic_load_n(&mates[v], __ATOMIC_RELAXED);
+						if(sv != LL_MATCHING_AVAILABLE && sv != LL_MATCHING_RESERVED)
+							break;
+						unsigned int su = __atomic_load_n(&mates[u], __ATOMIC_RELAXED);
+						if(su != LL_MATCHING_AVAILABLE && su != LL_MATCHING_RESERVED)
+							continue;
+
+						processed_edges++;
+						unsigned int a = min(u, v);
+						unsigned int b = max(u, v);
+
+						// Reserving a
+						unsigned int a_reserved = 0;
+						while(1)
+						{
+							unsigned int sa = __atomic_load_n(&mates[a], __ATOMIC_RELAXED);
+							if(sa == LL_MATCHING_AVAILABLE)
+							{
+								if(__atomic_compare_exchange_n(&mates[a], &sa, LL_MATCHING_RESERVED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+								{
+									a_reserved = 1;
+									break;
+								}
+								continue;
+							}
+							if(sa != LL_MATCHING_RESERVED)
+								break;
+							conflicts++;
+							_mm_pause();
+						}
+						if(!a_reserved)
+						{
+							// a has been matched
+							if(a == v)
+								break;
+							continue;
+						}
+
+						// Reserving b
+						unsigned int sb;
+						while(1)
+						{
+							sb = __atomic_load_n(&mates[b], __ATOMIC_RELAXED);
+							if(sb == LL_MATCHING_AVAILABLE)
+							{
+								if(__atomic_compare_exchange_n(&mates[b], &sb, LL_MATCHING_RESERVED, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+									break;
+								continue;
+							}
+							if(sb != LL_MATCHING_RESERVED)
+								break;
+							conflicts++;
+							_mm_pause();
+						}
+
+						if(sb == LL_MATCHING_AVAILABLE)
+						{
+							// Both are reserved by this thread
+							__atomic_store_n(&mates[a], b, __ATOMIC_RELEASE);
+							__atomic_store_n(&mates[b], a, __ATOMIC_RELEASE);
+							matched++;
+							break;
+						}
+
+						// b has been matched, so a is released
+						__atomic_store_n(&mates[a], LL_MATCHING_AVAILABLE, __ATOMIC_RELEASE);
+						if(b == v)
+							break;
+					}
+				}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("Matching:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Matched edges:    \t\t%'lu\n", matched);
+		if(flags & 1U)
+			printf("Conflicts:        \t\t%'lu\nProcessed edges:  \t\t%'lu\n", conflicts, processed_edges);
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = matched;
+			exec_info[9] = conflicts;
+			exec_info[10] = processed_edges;
+		}
+		if(matched_edges)
+			*matched_edges = matched;
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return mates;
+}
+
+/*
+	Validates a maximal matching:
+		(1) mates are mutual and each matched pair is connected by an edge,
+		(2) each edge (other than self-edges) has at least one matched endpoint.
+
+	Returns 1 if the matching is valid.
+*/
+int matching_validate(struct par_env* pe, struct ll_400_graph* g, unsigned int* mates, unsigned long matched_edges)
+{
+	assert(pe != NULL && g != NULL && mates != NULL);
+
+	unsigned long matched_vertices = 0;
+	unsigned long errors = 0;
+	#pragma omp parallel for schedule(dynamic, 1024) reduction(+:matched_vertices, errors)
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+	{
+		unsigned int mv = mates[v];
+		if(mv == LL_MATCHING_RESERVED)
+		{
+			errors++;
+			continue;
+		}
+
+		if(mv != LL_MATCHING_AVAILABLE)
+		{
+			matched_vertices++;
+			if(mv >= g->vertices_count || mates[mv] != v)
+			{
+				errors++;
+				continue;
+			}
+
+			// The edge (v, mv) is in the list of v or mv
+			unsigned int found = 0;
+			for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1] && !found; e++)
+				if(g->edges_list[e] == mv)
+					found = 1;
+			for(unsigned long e = g->offsets_list[mv]; e < g->offsets_list[mv + 1] && !found; e++)
+				if(g->edges_list[e] == v)
+					found = 1;
+			if(!found)
+				errors++;
+
+			continue;
+		}
+
+		// Maximality
+		for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+		{
+			unsigned int u = g->edges_list[e];
+			if(u != v && mates[u] == LL_MATCHING_AVAILABLE)
+			{
+				errors++;
+				break;
+			}
+		}
+	}
+
+	if(matched_vertices != 2 * matched_edges)
+		errors++;
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors\n", errors);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	return errors == 0;
+}
+
+void matching_release(struct ll_400_graph* g, unsigned int* mates)
+{
+	assert(g != NULL && mates != NULL);
+
+	numa_free(mates, sizeof(unsigned int) * g->vertices_count);
+	mates = NULL;
+
+	return;
+}
+
+#endif
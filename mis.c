@@ -0,0 +1,310 @@
+#ifndef __MIS_C
+#define __MIS_C
+
+// This file contains the implementation of the Orca maximal independent set
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+
+/*
+	Orca: Single-Pass Asynchronous Maximal Independent Set
+
+	Each vertex has a priority, (hash(v), v), and the result is the greedy MIS in the order of the priorities,
+	i.e., a vertex is in the MIS iff none of its neighbours with higher priorities is in the MIS.
+	The hash breaks the long dependency chains of the ID order.
+
+	Each vertex has a state in `states`, that changes once from `LL_MIS_UNDECIDED` to `LL_MIS_IN` or
+	`LL_MIS_OUT`. Vertices are processed in a single pass. To decide a vertex, its neighbours with higher
+	priorities are scanned:
+		- if one of them is in the MIS, the vertex is out,
+		- if one of them is undecided, it is pushed to the thread's stack and is decided first,
+		  then the scan is resumed from the same neighbour,
+		- otherwise, the vertex is in the MIS.
+
+	As the state of each vertex is uniquely specified by the priorities, two threads that decide a vertex
+	concurrently write the same state, and no thread waits for another thread.
+
+	g:
+		Should be symmetric.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of vertices in the MIS
+		[9]: number of vertices pushed to the stacks, i.e., decided out of order
+		[10]: max stack depth
+
+	Returns the array of states
+*/
+
+#define LL_MIS_UNDECIDED 0
+#define LL_MIS_IN 1
+#define LL_MIS_OUT 2
+
+static inline unsigned int __mis_hash(unsigned int v)
+{
+	unsigned int h = v * 0x9E3779B1U;
+	h ^= h >> 16;
+	h *= 0x85EBCA6BU;
+	h ^= h >> 13;
+
+	return h;
+}
+
+// Returns 1 if u has a higher priority than v
+static inline int __mis_higher_priority(unsigned int u, unsigned int hu, unsigned int v, unsigned int hv)
+{
+	return hu < hv || (hu == hv && u < v);
+}
+
+unsigned char* orca_mis(struct par_env* pe, struct ll_400_graph* g, unsigned int flags, unsigned long* exec_info, unsigned long* mis_size)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && g->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31morca_mis\033[0;37m using \033[3;31m%d\033[0;37m threads.\n", pe->threads_count);
+
+	// Allocate memory
+		unsigned char* states = numa_alloc_interleaved(sizeof(unsigned char) * g->vertices_count);
+		assert(states != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			states[v] = LL_MIS_UNDECIDED;
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Deciding vertices
+		unsigned long mt = - get_nano_time();
+		unsigned long in_count = 0;
+		unsigned long pushed = 0;
+		unsigned long max_depth = 0;
+		#pragma omp parallel reduction(+:in_count, pushed) reduction(max:max_depth)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			// Each frame of the stack is a vertex and the index of the next edge to be scanned
+			unsigned long stack_size = 1024;
+			unsigned int* stack_vertices = malloc(sizeof(unsigned int) * stack_size);
+			unsigned long* stack_edges = malloc(sizeof(unsigned long) * stack_size);
+			assert(stack_vertices != NULL && stack_edges != NULL);
+
+			unsigned int partition = -1U;
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break;
+
+				for(unsigned int s = partitions[partition]; s < partitions[partition + 1]; s++)
+				{
+					if(__atomic_load_n(&states[s], __ATOMIC_RELAXED) != LL_MIS_UNDECIDED)
+						continue;
+
+					unsigned long depth = 1;
+					stack_vertices[0] = s;
+					stack_edges[0] = g->offsets_list[s];
+
+					while(depth)
+					{
+						unsigned int v = stack_vertices[depth - 1];
+						unsigned long e = stack_edges[depth - 1];
+						unsigned long end = g->offsets_list[v + 1];
+						unsigned int hv = __mis_hash(v);
+						unsigned int state = LL_MIS_IN;
+						unsigned int next = -1U;
+
+						if(__atomic_load_n(&states[v], __ATOMIC_ACQUIRE) != LL_MIS_UNDECIDED)
+						{
+							depth--;
+							continue;
+						}
+
+						for(; e < end; e++)
+						{
+							unsigned int u = g->edges_list[e];
+							if(!__mis_higher_priority(u, __mis_hash(u), v, hv))
+								continue;
+
+							unsigned char su = __atomic_load_n(&states[u], __ATOMIC_ACQUIRE);
+							if(su == LL_MIS_IN)
+							{
+								state = LL_MIS_OUT;
+								break;
+							}
+							if(su == LL_MIS_UNDECIDED)
+							{
+								next = u;
+								break;
+							}
+						}
+
+						if(next != -1U)
+						{
+							// Deciding the neighbour first
+							stack_edges[depth - 1] = e;
+							if(depth == stack_size)
+							{
+								stack_size *= 2;
+								stack_vertices = realloc(stack_vertices, sizeof(unsigned int) * stack_size);
+								stack_edges = realloc(stack_edges, sizeof(unsigned long) * stack_size);
+								assert(stack_vertices != NULL && stack_edges != NULL);
+							}
+							stack_vertices[depth] = next;
+							stack_edges[depth] = g->offsets_list[next];
+							depth++;
+							pushed++;
+							if(depth > max_depth)
+								max_depth = depth;
+
+							continue;
+						}
+
+						// As the state is the same for all threads, only the thread that changes it counts it
+						unsigned char expected = LL_MIS_UNDECIDED;
+						if(__atomic_compare_exchange_n(&states[v], &expected, state, 0, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+							if(state == LL_MIS_IN)
+								in_count++;
+						depth--;
+					}
+				}
+			}
+
+			free(stack_vertices);
+			stack_vertices = NULL;
+			free(stack_edges);
+			stack_edges = NULL;
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("Deciding vertices:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("MIS size:         \t\t%'lu\n", in_count);
+		if(flags & 1U)
+			printf("Pushed vertices:  \t\t%'lu\nMax stack depth:  \t\t%'lu\n", pushed, max_depth);
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = in_count;
+			exec_info[9] = pushed;
+			exec_info[10] = max_depth;
+		}
+		if(mis_size)
+			*mis_size = in_count;
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return states;
+}
+
+/*
+	Validates a maximal independent set:
+		(1) all vertices are decided,
+		(2) independence: no two neighbours are in the MIS,
+		(3) maximality: each vertex that is not in the MIS has a neighbour in the MIS.
+
+	Returns 1 if the MIS is valid.
+*/
+int mis_validate(struct par_env* pe, struct ll_400_graph* g, unsigned char* states, unsigned long mis_size)
+{
+	assert(pe != NULL && g != NULL && states != NULL);
+
+	unsigned long in_count = 0;
+	unsigned long errors = 0;
+	#pragma omp parallel for schedule(dynamic, 1024) reduction(+:in_count, errors)
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+	{
+		if(states[v] == LL_MIS_IN)
+		{
+			in_count++;
+			for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+			{
+				unsigned int u = g->edges_list[e];
+				if(u != v && states[u] == LL_MIS_IN)
+				{
+					errors++;
+					break;
+				}
+			}
+		}
+		else if(states[v] == LL_MIS_OUT)
+		{
+			unsigned int found = 0;
+			for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1] && !found; e++)
+				if(states[g->edges_list[e]] == LL_MIS_IN)
+					found = 1;
+			if(!found)
+				errors++;
+		}
+		else
+			errors++;
+	}
+
+	if(in_count != mis_size)
+		errors++;
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors\n", errors);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	return errors == 0;
+}
+
+void mis_release(struct ll_400_graph* g, unsigned char* states)
+{
+	assert(g != NULL && states != NULL);
+
+	numa_free(states, sizeof(unsigned char) * g->vertices_count);
+	states = NULL;
+
+	return;
+}
+
+#endif
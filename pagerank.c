@@ -0,0 +1,554 @@
+#ifndef __PAGERANK_C
+#define __PAGERANK_C
+
+// This file contains the implementation of PageRank using pull, push, and cache-blocked pull SpMV
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+#include "energy.c"
+
+/*
+	The PageRank definition used by `pagerank()` and `spmv_pagerank()` (ihtl.c):
+	The damping factor is `LL_PR_DAMPING`, the ranks are initialized to 1 / |V|, and in each iteration,
+	the rank of dangling vertices (with no out-edges) is evenly distributed among all vertices, so the
+	sum of ranks remains 1:
+		rank[v] = (1 - d) / |V| + d * (sum of rank[u] / out_degree[u] for in-neighbours u of v + dangling_sum / |V|)
+*/
+#define LL_PR_DAMPING 0.85
+
+#define LL_PR_PULL 0
+#define LL_PR_PUSH 1
+#define LL_PR_BLOCKED 2
+
+const char* pagerank_mode_names[] = {"Pull", "Push", "Blocked"};
+
+/*
+	Adds `val` to `*dest` atomically using CAS on the 8-byte representation of the double.
+*/
+static inline void __pagerank_atomic_add(double* dest, double val)
+{
+	unsigned long* dest_bits = (unsigned long*)dest;
+	unsigned long old_bits = __atomic_load_n(dest_bits, __ATOMIC_RELAXED);
+	while(1)
+	{
+		double old_val;
+		memcpy(&old_val, &old_bits, sizeof(double));
+		double new_val = old_val + val;
+		unsigned long new_bits;
+		memcpy(&new_bits, &new_val, sizeof(double));
+		if(__atomic_compare_exchange_n(dest_bits, &old_bits, new_bits, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			break;
+	}
+
+	return;
+}
+
+/*
+	Returns the number of source vertices in each block of the blocked mode, so that the contributions
+	of a block (8 bytes per vertex) fill half of the L3 cache. If the L3 size is not known, L2 is used
+	and if none is known, 1 MB is assumed.
+*/
+unsigned int pagerank_block_vertices(struct par_env* pe)
+{
+	unsigned long cache_size = pe->L3_cache_size;
+	if(cache_size == 0)
+		cache_size = pe->L2_cache_size;
+	if(cache_size == 0)
+		cache_size = 1024UL * 1024;
+
+	unsigned long block_vertices = cache_size / 2 / sizeof(double);
+	block_vertices = max(64UL, block_vertices - block_vertices % 64);
+
+	return (unsigned int)min(block_vertices, -1U / 2UL);
+}
+
+/*
+	PageRank, as defined above `LL_PR_DAMPING`.
+
+	Each iteration computes the contributions, x[u] = rank[u] / out_degree[u], and then y = A^T x using
+	one of the modes:
+
+		`LL_PR_PULL`: each vertex reads the contributions of its in-neighbours from the CSC.
+		Vertices are scheduled using `parallel_edge_partitioning()` of the CSC and dynamic partitioning.
+
+		`LL_PR_PUSH`: each vertex adds its contribution to its out-neighbours in the CSR using atomic
+		CAS on doubles. Vertices are scheduled using `parallel_edge_partitioning()` of the CSR.
+
+		`LL_PR_BLOCKED`: the source vertices are divided into blocks whose contributions fit in
+		the cache (`pagerank_block_vertices()`) and the pull SpMV is performed block by block.
+		In the preprocessing, the CSC is split into one sub-CSC per block, stored block-major: 
+		a segment of a block is a destination vertex with in-neighbours in that block and its 
+		in-neighbours in the block (`sub_vertices`, `sub_offsets`, and `sub_edges`). As the 
+		neighbour-lists of the CSC are sorted, each vertex has at most one segment per block.
+		A block pass reads only the segments of that block, so the random accesses to `x` are 
+		limited to a cache-resident range, the in-neighbours are read sequentially, and `y` is 
+		updated only for the vertices with in-neighbours in the block. The segments of each block 
+		are divided into `partitions_count` partitions with almost the same number of edges.
+
+	csr: the graph
+	csc: the transposed graph, required for the pull and blocked modes and its neighbour-lists should be
+		sorted for the blocked mode (e.g., using `potra()` or `atomic_transpose()` with bit 1 of flags set)
+
+	flags:
+		bit 0: print stats, including per-iteration times, deltas, hw events, and energy
+		bit 1: do not reset papi (per-iteration hw events are not read)
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events, sum of iterations
+		[8]: mode
+		[9]: iterations
+		[10]: number of source blocks (for the blocked mode)
+		[11]: vertices per source block (for the blocked mode)
+		[15]: number of segments of the sub-CSCs (for the blocked mode)
+		[12]: preprocessing time
+		[13]: iterations time
+		[14]: delta of the last iteration (L1 norm) multiplied by 1e12
+		[18]: packages energy (J), sum of iterations
+		[19]: DRAM energy (J), sum of iterations
+
+	Returns the array of ranks
+*/
+double* pagerank(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, unsigned int mode, unsigned int iterations, unsigned int flags, unsigned long* exec_info)
+{
+	// (1) Initial checks
+		assert(pe != NULL && csr != NULL && csr->vertices_count > 0);
+		assert(mode <= LL_PR_BLOCKED);
+		assert(mode == LL_PR_PUSH || (csc != NULL && csc->vertices_count == csr->vertices_count && csc->edges_count == csr->edges_count));
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mpagerank\033[0;37m, %s, using \033[3;31m%d\033[0;37m threads.\n", pagerank_mode_names[mode], pe->threads_count);
+		const double damping = LL_PR_DAMPING;
+		const unsigned int vc = csr->vertices_count;
+
+	// (2) Allocate memory
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+		double* rank = numa_alloc_interleaved(sizeof(double) * vc);
+		double* x = numa_alloc_interleaved(sizeof(double) * vc);
+		double* y = numa_alloc_interleaved(sizeof(double) * vc);
+		assert(rank != NULL && x != NULL && y != NULL);
+
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < vc; v++)
+			rank[v] = 1.0 / vc;
+
+	// (3) Preprocessing
+		unsigned long mt = - get_nano_time();
+		struct ll_400_graph* pg = mode == LL_PR_PUSH ? csr : csc;
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(pg, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+		unsigned int block_vertices = vc;
+		unsigned int blocks_count = 1;
+		unsigned long segments_count = 0;
+		unsigned int* sub_vertices = NULL;
+		unsigned long* sub_offsets = NULL;
+		unsigned int* sub_edges = NULL;
+		unsigned long* sub_partitions = NULL;
+		if(mode == LL_PR_BLOCKED)
+		{
+			block_vertices = pagerank_block_vertices(pe);
+			blocks_count = (vc + block_vertices - 1) / block_vertices;
+
+			// Checking if the neighbour-lists are sorted
+			unsigned long unsorted = 0;
+			#pragma omp parallel for schedule(dynamic, 1024) reduction(+:unsorted)
+			for(unsigned int v = 0; v < vc; v++)
+				for(unsigned long e = csc->offsets_list[v] + 1; e < csc->offsets_list[v + 1]; e++)
+					if(csc->edges_list[e - 1] > csc->edges_list[e])
+					{
+						unsorted++;
+						break;
+					}
+			assert(unsorted == 0 && "The neighbour-lists of the CSC should be sorted for the blocked mode.");
+
+			// Counting segments and edges of each block per thread, each thread processes consecutive partitions
+			const unsigned int thread_partitions = partitions_count / pe->threads_count;
+			unsigned long* threads_segments = calloc(sizeof(unsigned long), (unsigned long)pe->threads_count * blocks_count);
+			unsigned long* threads_edges = calloc(sizeof(unsigned long), (unsigned long)pe->threads_count * blocks_count);
+			assert(threads_segments != NULL && threads_edges != NULL);
+
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				unsigned long* ts = threads_segments + (unsigned long)tid * blocks_count;
+				unsigned long* te = threads_edges + (unsigned long)tid * blocks_count;
+				for(unsigned int v = partitions[tid * thread_partitions]; v < partitions[(tid + 1) * thread_partitions]; v++)
+				{
+					unsigned int last_block = -1U;
+					for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+					{
+						unsigned int block = csc->edges_list[e] / block_vertices;
+						if(block != last_block)
+						{
+							ts[block]++;
+							last_block = block;
+						}
+						te[block]++;
+					}
+				}
+			}
+
+			// Converting the counts to the offsets of the threads in the block-major sub-CSCs
+			unsigned long* blocks_segments = calloc(sizeof(unsigned long), blocks_count + 1);
+			assert(blocks_segments != NULL);
+			unsigned long edges_count = 0;
+			for(unsigned int b = 0; b < blocks_count; b++)
+			{
+				blocks_segments[b] = segments_count;
+				for(unsigned int t = 0; t < pe->threads_count; t++)
+				{
+					unsigned long temp = threads_segments[(unsigned long)t * blocks_count + b];
+					threads_segments[(unsigned long)t * blocks_count + b] = segments_count;
+					segments_count += temp;
+
+					temp = threads_edges[(unsigned long)t * blocks_count + b];
+					threads_edges[(unsigned long)t * blocks_count + b] = edges_count;
+					edges_count += temp;
+				}
+			}
+			blocks_segments[blocks_count] = segments_count;
+			assert(edges_count == csc->edges_count);
+
+			sub_vertices = numa_alloc_interleaved(sizeof(unsigned int) * max(1UL, segments_count));
+			sub_offsets = numa_alloc_interleaved(sizeof(unsigned long) * (segments_count + 1));
+			sub_edges = numa_alloc_interleaved(sizeof(unsigned int) * max(1UL, edges_count));
+			sub_partitions = numa_alloc_interleaved(sizeof(unsigned long) * blocks_count * (partitions_count + 1));
+			assert(sub_vertices != NULL && sub_offsets != NULL && sub_edges != NULL && sub_partitions != NULL);
+			sub_offsets[segments_count] = edges_count;
+
+			// Writing the segments
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				unsigned long* ts = threads_segments + (unsigned long)tid * blocks_count;
+				unsigned long* te = threads_edges + (unsigned long)tid * blocks_count;
+				for(unsigned int v = partitions[tid * thread_partitions]; v < partitions[(tid + 1) * thread_partitions]; v++)
+				{
+					unsigned int last_block = -1U;
+					for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = csc->edges_list[e];
+						unsigned int block = u / block_vertices;
+						if(block != last_block)
+						{
+							sub_vertices[ts[block]] = v;
+							sub_offsets[ts[block]] = te[block];
+							ts[block]++;
+							last_block = block;
+						}
+						sub_edges[te[block]++] = u;
+					}
+				}
+			}
+
+			// Partitioning the segments of each block
+			#pragma omp parallel for schedule(dynamic, 1)
+			for(unsigned int b = 0; b < blocks_count; b++)
+			{
+				unsigned long* bp = sub_partitions + (unsigned long)b * (partitions_count + 1);
+				unsigned long s = blocks_segments[b];
+				unsigned long block_start = sub_offsets[s];
+				unsigned long block_edges = sub_offsets[blocks_segments[b + 1]] - block_start;
+				for(unsigned int p = 0; p < partitions_count; p++)
+				{
+					unsigned long target = block_start + block_edges * p / partitions_count;
+					while(s < blocks_segments[b + 1] && sub_offsets[s] < target)
+						s++;
+					bp[p] = s;
+				}
+				bp[partitions_count] = blocks_segments[b + 1];
+			}
+
+			free(threads_segments);
+			threads_segments = NULL;
+			free(threads_edges);
+			threads_edges = NULL;
+			free(blocks_segments);
+			blocks_segments = NULL;
+		}
+		mt += get_nano_time();
+		unsigned long preprocessing_time = mt;
+		if(flags & 1U)
+		{
+			PT("Preprocessing:");
+			if(mode == LL_PR_BLOCKED)
+				printf("Blocks: %'u, vertices per block: %'u, segments: %'lu, L2: %'u (B), L3: %'u (B)\n", 
+					blocks_count, block_vertices, segments_count, pe->L2_cache_size, pe->L3_cache_size);
+		}
+
+	// (4) Iterations
+		unsigned long total_events[32] = {0};
+		unsigned long iter_events[32] = {0};
+		unsigned long iterations_time = 0;
+		double delta = 0;
+		#ifdef _ENERGY_MEASUREMENT
+			struct energy_measurement* em = energy_measurement_init();
+			double packages_energy = 0;
+			double drams_energy = 0;
+		#endif
+
+		for(unsigned int iter = 0; iter < iterations; iter++)
+		{
+			// (4.1) Reset papi and start energy measurement
+			if(!(flags & 2U))
+				#pragma omp parallel
+				{
+					unsigned tid = omp_get_thread_num();
+					papi_reset(pe->papi_args[tid]);
+				}
+			#ifdef _ENERGY_MEASUREMENT
+				energy_measurement_start(em);
+			#endif
+
+			mt = - get_nano_time();
+			for(unsigned int t = 0; t < pe->threads_count; t++)
+				ttimes[t] = 0;
+
+			// (4.2) Contributions
+			double dangling_sum = 0;
+			#pragma omp parallel reduction(+:dangling_sum)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] -= get_nano_time();
+
+				#pragma omp for nowait
+				for(unsigned int v = 0; v < vc; v++)
+				{
+					unsigned long degree = csr->offsets_list[v + 1] - csr->offsets_list[v];
+					if(degree)
+						x[v] = rank[v] / degree;
+					else
+					{
+						x[v] = 0;
+						dangling_sum += rank[v];
+					}
+					y[v] = 0;
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+
+			// (4.3) SpMV
+			for(unsigned int b = 0; b < blocks_count; b++)
+			{
+				#pragma omp parallel
+				{
+					unsigned tid = omp_get_thread_num();
+					ttimes[tid] -= get_nano_time();
+					unsigned int partition = -1U;
+
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+
+						if(mode == LL_PR_PULL)
+							for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+							{
+								double sum = 0;
+								for(unsigned long e = csc->offsets_list[v]; e < csc->offsets_list[v + 1]; e++)
+									sum += x[csc->edges_list[e]];
+								y[v] = sum;
+							}
+
+						if(mode == LL_PR_PUSH)
+							for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+							{
+								double c = x[v];
+								if(c == 0)
+									continue;
+								for(unsigned long e = csr->offsets_list[v]; e < csr->offsets_list[v + 1]; e++)
+									__pagerank_atomic_add(&y[csr->edges_list[e]], c);
+							}
+
+						if(mode == LL_PR_BLOCKED)
+						{
+							unsigned long* bp = sub_partitions + (unsigned long)b * (partitions_count + 1);
+							for(unsigned long s = bp[partition]; s < bp[partition + 1]; s++)
+							{
+								double sum = 0;
+								for(unsigned long e = sub_offsets[s]; e < sub_offsets[s + 1]; e++)
+									sum += x[sub_edges[e]];
+								y[sub_vertices[s]] += sum;
+							}
+						}
+					}
+
+					ttimes[tid] += get_nano_time();
+				}
+				dynamic_partitioning_reset(dp);
+			}
+
+			// (4.4) Updating ranks
+			double iter_delta = 0;
+			const double base = (1 - damping) / vc + damping * dangling_sum / vc;
+			#pragma omp parallel reduction(+:iter_delta)
+			{
+				unsigned tid = omp_get_thread_num();
+				ttimes[tid] -= get_nano_time();
+
+				#pragma omp for nowait
+				for(unsigned int v = 0; v < vc; v++)
+				{
+					double r = base + damping * y[v];
+					iter_delta += fabs(r - rank[v]);
+					rank[v] = r;
+				}
+
+				ttimes[tid] += get_nano_time();
+			}
+			delta = iter_delta;
+			mt += get_nano_time();
+			iterations_time += mt;
+
+			// (4.5) Reading papi and energy
+			#ifdef _ENERGY_MEASUREMENT
+				struct energy_counters_vals* evals = energy_measurement_stop(em);
+				packages_energy += evals->packages_total / 1e6;
+				drams_energy += evals->drams_total / 1e6;
+			#endif
+			if(!(flags & 2U))
+			{
+				#pragma omp parallel
+				{
+					assert(0 == thread_papi_read(pe));
+				}
+				for(unsigned int e = 0; e < pe->hw_events_count; e++)
+					total_events[e] += pe->hw_events[e];
+			}
+
+			if(flags & 1U)
+			{
+				char temp[255];
+				sprintf(temp, "Iteration %'3u, delta: %.3e:", iter, delta);
+				PTIP(temp);
+				if(!(flags & 2U) && pe->hw_events_count)
+					print_hw_events(pe, 1);
+				#ifdef _ENERGY_MEASUREMENT
+					printf("  Packages energy : %'.2f (J), DRAM energy : %'.2f (J)\n", evals->packages_total/1e6, evals->drams_total/1e6);
+				#endif
+			}
+			#ifdef _ENERGY_MEASUREMENT
+				evals = NULL;
+			#endif
+			if(!(flags & 2U))
+				copy_reset_hw_events(pe, iter_events, 1);
+		}
+
+	// (5) Saving events
+		#ifdef _ENERGY_MEASUREMENT
+			energy_measurement_release(em);
+			em = NULL;
+			printf("Packages energy:  \t\t %'.2f (J)\n", packages_energy);
+			printf("DRAM energy:      \t\t %'.2f (J)\n", drams_energy);
+			if(exec_info)
+			{
+				exec_info[18] = packages_energy;
+				exec_info[19] = drams_energy;
+			}
+		#endif
+		if(!(flags & 2U))
+		{
+			for(unsigned int e = 0; e < pe->hw_events_count; e++)
+				pe->hw_events[e] = total_events[e];
+			if(flags & 1U)
+			{
+				printf("\nTotal of iterations:");
+				print_hw_events(pe, 1);
+			}
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+			else
+				reset_hw_events(pe);
+		}
+
+	// (6) Finalizing
+		t0 += get_nano_time();
+		printf("Last delta:       \t\t %.3e\n", delta);
+		printf("Iterations time:  \t\t %'.1f (ms)\n", iterations_time/1e6);
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = mode;
+			exec_info[9] = iterations;
+			exec_info[10] = blocks_count;
+			exec_info[11] = block_vertices;
+			exec_info[12] = preprocessing_time;
+			exec_info[13] = iterations_time;
+			exec_info[14] = delta * 1e12;
+			exec_info[15] = segments_count;
+		}
+
+	// (7) Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		if(sub_vertices != NULL)
+		{
+			numa_free(sub_vertices, sizeof(unsigned int) * max(1UL, segments_count));
+			sub_vertices = NULL;
+			numa_free(sub_offsets, sizeof(unsigned long) * (segments_count + 1));
+			sub_offsets = NULL;
+			numa_free(sub_edges, sizeof(unsigned int) * max(1UL, csc->edges_count));
+			sub_edges = NULL;
+			numa_free(sub_partitions, sizeof(unsigned long) * blocks_count * (partitions_count + 1));
+			sub_partitions = NULL;
+		}
+		free(ttimes);
+		ttimes = NULL;
+		numa_free(x, sizeof(double) * vc);
+		x = NULL;
+		numa_free(y, sizeof(double) * vc);
+		y = NULL;
+
+	return rank;
+}
+
+/*
+	Compares two rank arrays and returns 1 if their maximum relative difference is less than 1e-9.
+	It also checks that the sum of ranks is 1.
+*/
+int pagerank_validate(struct par_env* pe, unsigned int vertices_count, double* rank_1, double* rank_2)
+{
+	assert(pe != NULL && rank_1 != NULL && rank_2 != NULL);
+
+	double max_diff = 0;
+	double sum = 0;
+	#pragma omp parallel for reduction(max:max_diff) reduction(+:sum)
+	for(unsigned int v = 0; v < vertices_count; v++)
+	{
+		double diff = fabs(rank_1[v] - rank_2[v]) / max(fabs(rank_1[v]), 1e-300);
+		if(diff > max_diff)
+			max_diff = diff;
+		sum += rank_2[v];
+	}
+
+	int correct = max_diff < 1e-9 && fabs(sum - 1) < 1e-6;
+	if(correct)
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m, max relative diff: %.3e\n", max_diff);
+	else
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, max relative diff: %.3e, sum of ranks: %.9f\n", max_diff, sum);
+
+	return correct;
+}
+
+void pagerank_release(unsigned int vertices_count, double* rank)
+{
+	assert(rank != NULL);
+
+	numa_free(rank, sizeof(double) * vertices_count);
+	rank = NULL;
+
+	return;
+}
+
+#endif
@@ -74,84 +74,31 @@ int serial_edge_partitioning(struct ll_400_graph* g, unsigned int* borders, int
 	return 0;
 }
 
-int parallel_edge_partitioning(struct ll_400_graph* g, unsigned int* borders, int partitions)
-{
-	assert(partitions > 0 && g->vertices_count > 0);
-
-	borders[0] = 0;
-	borders[partitions] = g->vertices_count;
-
-	if(g->vertices_count <= 4 * partitions)
-	{
-		unsigned int remained_vertices = g->vertices_count;
-		unsigned int remained_partitions = partitions;
-		for(int i=1;i<partitions;i++)
-		{
-			if(remained_vertices > 0)
-			{
-				unsigned int q = max(1,remained_vertices/remained_partitions);
-				borders[i] = borders[i-1] + q;
-				remained_vertices -= q;
-			}
-			else
-				borders[i] = g->vertices_count;
-
-			//printf("%d %d %d\n",i,borders[i], remained_vertices);
-			remained_partitions--;
-		}
-	}
-	else
-	{
-		unsigned long edges_per_thread = (g->edges_count + g->vertices_count) / partitions;
-		
-		#pragma omp parallel for
-		for(unsigned int t = 1; t < partitions; t++)
-		{
-			unsigned long start = 0;
-			unsigned long end = g->vertices_count;
-			unsigned long target = t * edges_per_thread;
-			unsigned long m = (start + end)/2;
-			while(1)
-			{
-				unsigned long m_val = g->offsets_list[m] + m;
-				if( m_val == target )
-					break;
-
-				unsigned long b_val = g->offsets_list[m - 1] + m - 1;
-				if( b_val < target && m_val > target )
-					break;
-
-				if(m_val > target)
-					end = m;
-				if(m_val < target)
-					start = m;
-
-				unsigned long new_m = (start + end)/2;
-				if(new_m == m)
-					break;
-				m = new_m;
-			}
-			assert( m <= g->vertices_count );
-			
-			borders[t] = m;
-		}	
-
-		unsigned int last_m = 0;
-		for(unsigned int t = 1; t < partitions; t++)
-		{
-			if(borders[t] <= last_m)
-				borders[t] = last_m + 1;
-			if(borders[t] > g->vertices_count)
-				borders[t] = g->vertices_count;
-			
-			last_m = borders[t];
-		}
-	}
-
-	//verify_serial_edge_partitioning(g, borders, partitions);
-
-	return 0;
-}
+/*
+	parallel_edge_partitioning() for ll_400_graph, parallel_edge_partitioning_800() for ll_800_graph,
+	parallel_edge_partitioning_400s() for ll_400s_graph, and parallel_edge_partitioning_404() for ll_404_graph
+	are instantiated from partitioning.tpl.c.
+	`borders` has `partitions + 1` elements of the vertex ID type of the graph.
+*/
+#define LL_T_GRAPH                         ll_400_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning
+#include "partitioning.tpl.c"
+
+#define LL_T_GRAPH                         ll_800_graph
+#define LL_T_VID                           unsigned long
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_800
+#include "partitioning.tpl.c"
+
+#define LL_T_GRAPH                         ll_400s_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_400s
+#include "partitioning.tpl.c"
+
+#define LL_T_GRAPH                         ll_404_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_404
+#include "partitioning.tpl.c"
 
 struct dynamic_partitioning
 {
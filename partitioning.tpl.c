@@ -0,0 +1,90 @@
+/*
+	Template of the edge partitioning functions for graphs with 4 Bytes and 8 Bytes vertex IDs.
+	This file is included by `partitioning.c` once per vertex ID type with the following macros defined:
+		`LL_T_GRAPH`: struct name of the graph, e.g., `ll_400_graph` or `ll_400s_graph` (4 Bytes offsets)
+		`LL_T_VID`: type of vertex IDs, e.g., `unsigned int`
+		`LL_T_PARALLEL_EDGE_PARTITIONING`: name of the parallel edge partitioning function
+*/
+
+int LL_T_PARALLEL_EDGE_PARTITIONING(struct LL_T_GRAPH* g, LL_T_VID* borders, int partitions)
+{
+	assert(partitions > 0 && g->vertices_count > 0);
+
+	borders[0] = 0;
+	borders[partitions] = g->vertices_count;
+
+	if(g->vertices_count <= 4 * partitions)
+	{
+		LL_T_VID remained_vertices = g->vertices_count;
+		unsigned int remained_partitions = partitions;
+		for(int i=1;i<partitions;i++)
+		{
+			if(remained_vertices > 0)
+			{
+				LL_T_VID q = max(1,remained_vertices/remained_partitions);
+				borders[i] = borders[i-1] + q;
+				remained_vertices -= q;
+			}
+			else
+				borders[i] = g->vertices_count;
+
+			//printf("%d %d %d\n",i,borders[i], remained_vertices);
+			remained_partitions--;
+		}
+	}
+	else
+	{
+		unsigned long edges_per_thread = (g->edges_count + g->vertices_count) / partitions;
+		
+		#pragma omp parallel for
+		for(unsigned int t = 1; t < partitions; t++)
+		{
+			unsigned long start = 0;
+			unsigned long end = g->vertices_count;
+			unsigned long target = t * edges_per_thread;
+			unsigned long m = (start + end)/2;
+			while(1)
+			{
+				unsigned long m_val = g->offsets_list[m] + m;
+				if( m_val == target )
+					break;
+
+				unsigned long b_val = g->offsets_list[m - 1] + m - 1;
+				if( b_val < target && m_val > target )
+					break;
+
+				if(m_val > target)
+					end = m;
+				if(m_val < target)
+					start = m;
+
+				unsigned long new_m = (start + end)/2;
+				if(new_m == m)
+					break;
+				m = new_m;
+			}
+			assert( m <= g->vertices_count );
+			
+			borders[t] = m;
+		}	
+
+		LL_T_VID last_m = 0;
+		for(unsigned int t = 1; t < partitions; t++)
+		{
+			if(borders[t] <= last_m)
+				borders[t] = last_m + 1;
+			if(borders[t] > g->vertices_count)
+				borders[t] = g->vertices_count;
+			
+			last_m = borders[t];
+		}
+	}
+
+	//verify_serial_edge_partitioning(g, borders, partitions);
+
+	return 0;
+}
+
+#undef LL_T_GRAPH
+#undef LL_T_VID
+#undef LL_T_PARALLEL_EDGE_PARTITIONING
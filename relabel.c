@@ -324,8 +324,12 @@ unsigned int* sapco_sort_degree_ordering(struct par_env* pe, struct ll_400_graph
 		Step-2: Counting degrees
 		Step-3: Calculating offsets
 		Step-4: Writing IDs
+	The sort is stable: each thread counts and writes the same static range of vertices and has its own offset
+	for each degree, so vertices with the same degree are in ascending order of their IDs and the result is deterministic.
+
 	flags:
 		0: print details
+		1: do not reset PAPI
 
 	exec_info: if not NULL, will have 
 		[0]: exec time
@@ -343,11 +347,12 @@ unsigned int* counting_sort_degree_ordering(struct par_env* pe, struct ll_400_gr
 			printf("\n\033[3;33mcounting_sort_degree_ordering\033[0;37m using \033[3;33m%d\033[0;37m threads.\n", pe->threads_count);
 
 		// Reset papi
-		#pragma omp parallel 
-		{
-			unsigned tid = omp_get_thread_num();
-			papi_reset(pe->papi_args[tid]);
-		}
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
 
 	// (1.2) Identifying the max_degree
 		unsigned long max_degree = 0;
@@ -394,7 +399,7 @@ unsigned int* counting_sort_degree_ordering(struct par_env* pe, struct ll_400_gr
 			assert(threads_counters[tid] != NULL);
 			unsigned int* my_counter = threads_counters[tid];
 
-			#pragma omp for nowait
+			#pragma omp for schedule(static) nowait
 			for(unsigned int v = 0; v < g->vertices_count; v++)
 			{
 				unsigned long degree = g->offsets_list[v+1] - g->offsets_list[v];
@@ -409,7 +414,7 @@ unsigned int* counting_sort_degree_ordering(struct par_env* pe, struct ll_400_gr
 		if(exec_info)
 			exec_info[9] = mt;
 		
-	// (3.1) Calculating total count of low-degree counts over different partitions
+	// (3.1) Calculating total count of each degree and the offset of each thread in it
 		mt = -get_nano_time();
 		#pragma omp parallel for 
 		for(unsigned int v=0; v < max_degree; v++)
@@ -417,7 +422,11 @@ unsigned int* counting_sort_degree_ordering(struct par_env* pe, struct ll_400_gr
 			unsigned int sum = 0;
 			
 			for(unsigned int t = 0; t<pe->threads_count; t++)
-				sum += threads_counters[t][v];
+			{
+				unsigned int temp = threads_counters[t][v];
+				threads_counters[t][v] = sum;
+				sum += temp;
+			}
 			
 			global_counter[v] = sum;
 		}
@@ -483,18 +492,22 @@ unsigned int* counting_sort_degree_ordering(struct par_env* pe, struct ll_400_gr
 			unsigned int tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
 
-			// Releasing memory
-			numa_free(threads_counters[tid], sizeof(unsigned int) * max_degree );
-			threads_counters[tid] = NULL;
+			unsigned int* my_counter = threads_counters[tid];
 
-			#pragma omp for nowait
+			// The same static schedule as (2)
+			#pragma omp for schedule(static) nowait
 			for(unsigned int v = 0; v < g->vertices_count; v++)
 			{
 				unsigned long degree = g->offsets_list[v+1] - g->offsets_list[v];
-				unsigned int offset = __atomic_fetch_add(&global_counter[degree], 1U, __ATOMIC_RELAXED);
+				unsigned int offset = global_counter[degree] + my_counter[degree]++;
 					
 				ret[offset] = v;
 			}
+
+			// Releasing memory
+			numa_free(threads_counters[tid], sizeof(unsigned int) * max_degree );
+			threads_counters[tid] = NULL;
+			my_counter = NULL;
 			
 			ttimes[tid] += get_nano_time();
 		}
@@ -685,218 +698,922 @@ unsigned int* random_ordering(struct par_env* pe, unsigned int vertices_count, i
 }
 
 /*
-	relabel_graph() 
-
-	flags: 
-		bit 0 : TODO: validate results
-		bit 1 : sort neighbour-list of the output  
-*/
+	Hub ordering
+
+	Hot vertices, i.e., vertices with a degree greater than the average degree, are packed at the beginning 
+	of the new ID space and the cold vertices keep their relative order after the hot vertices.
+	By default (hub-cluster) the hot vertices also keep their relative order. If bit 2 of `flags` is set
+	(hub-sort), the hot vertices are sorted by degree in descending order using `counting_sort_degree_ordering()`.
+
+	@INPROCEEDINGS{10.1109/IISWC.2018.8573478,
+		author={Balaji, Vignesh and Lucia, Brandon},
+		booktitle={2018 IEEE International Symposium on Workload Characterization (IISWC)}, 
+		title={When is Graph Reordering an Optimization? Studying the Effect of Lightweight Graph Reordering Across Applications and Input Graphs}, 
+		year={2018},
+		pages={203-214},
+		doi={10.1109/IISWC.2018.8573478}
+	}
 
-struct ll_400_graph* relabel_graph(struct par_env* pe, struct ll_400_graph* g, unsigned int* RA_o2n, unsigned int flags)
-{
-	// Initial checks
-		unsigned long tt = - get_nano_time();
-		assert(pe != NULL && g != NULL && RA_o2n != NULL);
-		assert(relabeling_array_validate(pe, RA_o2n, g->vertices_count));
-		printf("\n\033[3;35mrelabel_graph\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
+	Returns an RA_o2n array (indexed by an old vertex ID to get its new vertex ID) that can be passed to `relabel_graph()`.
 
-	// Partitioning
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		printf("partitions: %'u \n", partitions_count);
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+	flags:
+		0: print details
+		1: do not reset PAPI
+		2: hub-sort
 
-	// Allocating memory
-		struct ll_400_graph* out_graph =calloc(sizeof(struct ll_400_graph),1);
-		assert(out_graph != NULL);
-		out_graph->vertices_count = g->vertices_count;
-		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + g->vertices_count));
-		assert(out_graph->offsets_list != NULL);
+	exec_info: if not NULL, will have 
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of hot vertices
+		[9]: hot degree threshold, i.e., the average degree
+*/
+unsigned int* hub_ordering(struct par_env* pe, struct ll_400_graph* g, unsigned long* exec_info, unsigned int flags)
+{
+	// (1.1) Initial checks
+		unsigned long t0 = - get_nano_time();
+		assert(pe != NULL && g!= NULL && g->vertices_count != 0 && g->offsets_list != NULL);
+		assert(g->vertices_count < (1UL<<32));
+		if(flags & 1U)
+			printf("\n\033[3;33mhub_ordering\033[0;37m (%s) using \033[3;33m%d\033[0;37m threads.\n", 
+				(flags & 4U) ? "hub-sort" : "hub-cluster", pe->threads_count);
 
-		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
-		assert(partitions_total_edges != NULL);
+		// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
 
+	// (1.2) Memory allocation
 		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
 		assert(ttimes != NULL);
 
-	// (1) Identifying degree of vertices in the out_graph
+		unsigned int partitions_count = 64 * pe->threads_count;
+		unsigned int* hot_offsets = calloc(sizeof(unsigned int), partitions_count + 1);
+		unsigned int* cold_offsets = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(hot_offsets != NULL && cold_offsets != NULL);
+
+		unsigned int* RA_o2n = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(RA_o2n != NULL);
+
+		unsigned long threshold = g->edges_count / g->vertices_count;
+		unsigned int vertices_per_partition = max(1UL, g->vertices_count / partitions_count);
+
+	// (2) Counting hot vertices of each partition
 		unsigned long mt = - get_nano_time();
 		#pragma omp parallel  
 		{
 			unsigned int tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
-			#pragma omp for nowait 
-			for(unsigned int p = 0; p<partitions_count; p++)
+
+			#pragma omp for nowait
+			for(unsigned int p = 0; p < partitions_count; p++)
 			{
-				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
-				{
-					unsigned int degree = g->offsets_list[v + 1] - g->offsets_list[v];
-					unsigned int new_v = RA_o2n[v];
-					out_graph->offsets_list[new_v] = degree; 
-				}
+				unsigned int start_vertex = min(g->vertices_count, (unsigned long)vertices_per_partition * p);
+				unsigned int end_vertex = min(g->vertices_count, (unsigned long)vertices_per_partition * (p + 1));
+				if(p + 1 == partitions_count)
+					end_vertex = g->vertices_count;
+
+				unsigned int hot = 0;
+				for(unsigned int v = start_vertex; v < end_vertex; v++)
+					if(g->offsets_list[v + 1] - g->offsets_list[v] > threshold)
+						hot++;
+
+				hot_offsets[p] = hot;
+				cold_offsets[p] = end_vertex - start_vertex - hot;
 			}
+			
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
-		PTIP("(1) Identifying degrees");
-		
-	// (2) Calculating sum of edges of each partition in partitions_total_edges
+		if(flags & 1U)
+			PTIP("(2) Counting hot vertices");
+
+	// (3) Calculating offsets
+		mt = - get_nano_time();
+		unsigned int hot_vertices = 0;
+		for(unsigned int p = 0; p < partitions_count; p++)
+		{
+			unsigned int temp = hot_offsets[p];
+			hot_offsets[p] = hot_vertices;
+			hot_vertices += temp;
+		}
+		hot_offsets[partitions_count] = hot_vertices;
+
+		unsigned int cold_offset = hot_vertices;
+		for(unsigned int p = 0; p < partitions_count; p++)
+		{
+			unsigned int temp = cold_offsets[p];
+			cold_offsets[p] = cold_offset;
+			cold_offset += temp;
+		}
+		cold_offsets[partitions_count] = cold_offset;
+		assert(cold_offset == g->vertices_count);
+		mt += get_nano_time();
+		if(flags & 1U)
+		{
+			PT("(3) Calculating offsets");
+			printf("Hot vertices: \t\t\t%'u (%.1f%%), degree > %'lu\n", hot_vertices, 100.0 * hot_vertices / g->vertices_count, threshold);
+		}
+
+	// (4) Sorting hot vertices
+		unsigned int* RA_n2o = NULL;
+		if(flags & 4U)
+		{
+			mt = - get_nano_time();
+			RA_n2o = counting_sort_degree_ordering(pe, g, NULL, 2U);
+			assert(RA_n2o != NULL);
+			mt += get_nano_time();
+			if(flags & 1U)
+				PT("(4) Sorting hot vertices");
+		}
+
+	// (5) Writing IDs
 		mt = - get_nano_time();
 		#pragma omp parallel  
 		{
 			unsigned int tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
-			#pragma omp for nowait 
-			for(unsigned int p = 0; p<partitions_count; p++)
+
+			#pragma omp for nowait
+			for(unsigned int p = 0; p < partitions_count; p++)
 			{
-				unsigned long sum = 0;
-				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
-					sum += out_graph->offsets_list[v];
-				partitions_total_edges[p] = sum;
+				unsigned int start_vertex = min(g->vertices_count, (unsigned long)vertices_per_partition * p);
+				unsigned int end_vertex = min(g->vertices_count, (unsigned long)vertices_per_partition * (p + 1));
+				if(p + 1 == partitions_count)
+					end_vertex = g->vertices_count;
+
+				unsigned int hot_offset = hot_offsets[p];
+				unsigned int cold_offset = cold_offsets[p];
+				for(unsigned int v = start_vertex; v < end_vertex; v++)
+					if(g->offsets_list[v + 1] - g->offsets_list[v] > threshold)
+					{
+						if(RA_n2o == NULL)
+							RA_o2n[v] = hot_offset;
+						hot_offset++;
+					}
+					else
+						RA_o2n[v] = cold_offset++;
+
+				assert(hot_offset == hot_offsets[p + 1] && cold_offset == cold_offsets[p + 1]);
+			}
+
+			// The first `hot_vertices` vertices of a degree ordering are the hot vertices
+			if(RA_n2o != NULL)
+			{
+				#pragma omp for nowait
+				for(unsigned int n = 0; n < hot_vertices; n++)
+					RA_o2n[RA_n2o[n]] = n;
 			}
+			
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
-		PTIP("(2) Calculating sum");
-	
-	// Partial sum of partitions_total_edges
+		if(flags & 1U)
+			PTIP("(5) Writing IDs");
+
+	// Releasing memory
+		free(ttimes);
+		ttimes = NULL;
+
+		free(hot_offsets);
+		hot_offsets = NULL;
+
+		free(cold_offsets);
+		cold_offsets = NULL;
+
+		if(RA_n2o != NULL)
 		{
-			unsigned long sum = 0;
-			for(unsigned int p = 0; p < partitions_count; p++)
+			numa_free(RA_n2o, sizeof(unsigned int) * g->vertices_count);
+			RA_n2o = NULL;
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		if(flags & 1U)
+			printf("\nExecution time: %'10.1f (ms)\n", t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = hot_vertices;
+			exec_info[9] = threshold;
+
+			#pragma omp parallel
 			{
-				unsigned long temp = partitions_total_edges[p];
-				partitions_total_edges[p] = sum;
-				sum += temp;
+				assert(0 == thread_papi_read(pe));
+			}
+			
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+
+			copy_reset_hw_events(pe, &exec_info[1], 1);
+
+			printf("\n");
+		}
+
+	return RA_o2n;
+}
+
+/*
+	Returns the bandwidth of the graph, i.e., the max ID difference of the endpoints of an edge, 
+	after relabeling by `RA_o2n`. If `RA_o2n` is NULL, the bandwidth of the current labels is returned.
+*/
+unsigned long relabeled_graph_bandwidth(struct ll_400_graph* g, unsigned int* RA_o2n)
+{
+	unsigned long bandwidth = 0;
+	#pragma omp parallel for reduction(max: bandwidth) schedule(dynamic, 4096)
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+	{
+		long new_v = RA_o2n == NULL ? v : RA_o2n[v];
+		for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+		{
+			long new_u = RA_o2n == NULL ? g->edges_list[e] : RA_o2n[g->edges_list[e]];
+			unsigned long diff = labs(new_u - new_v);
+			if(diff > bandwidth)
+				bandwidth = diff;
+		}
+	}
+
+	return bandwidth;
+}
+
+/*
+	Sorts `list` by the degree of vertices in ascending order (ties by vertex ID). 
+*/
+void __rcm_sort_by_degree(struct ll_400_graph* g, unsigned int* list, unsigned int count)
+{
+	if(count < 2)
+		return;
+
+	if(count <= 16)
+	{
+		for(unsigned int i = 1; i < count; i++)
+		{
+			unsigned int v = list[i];
+			unsigned long v_degree = g->offsets_list[v + 1] - g->offsets_list[v];
+			unsigned int j = i;
+			for(; j > 0; j--)
+			{
+				unsigned int u = list[j - 1];
+				unsigned long u_degree = g->offsets_list[u + 1] - g->offsets_list[u];
+				if(u_degree < v_degree || (u_degree == v_degree && u < v))
+					break;
+				list[j] = u;
 			}
-			out_graph->edges_count = sum;
-			printf("%-20s \t\t\t %'10lu\n","New graph edges:", out_graph->edges_count);
-			assert(out_graph->edges_count == g->edges_count);
+			list[j] = v;
 		}
-		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
-		out_graph->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * out_graph->edges_count);
-		assert(out_graph->edges_list != NULL);
 
-	// (3) Updating the out_graph->offsets_list
+		return;
+	}
+
+	unsigned long* keys = malloc(sizeof(unsigned long) * count);
+	assert(keys != NULL);
+	for(unsigned int i = 0; i < count; i++)
+	{
+		unsigned int v = list[i];
+		unsigned long degree = min(g->offsets_list[v + 1] - g->offsets_list[v], (unsigned long)-1U);
+		keys[i] = (degree << 32) + v;
+	}
+	quick_sort_ulong(keys, 0, count - 1);
+	for(unsigned int i = 0; i < count; i++)
+		list[i] = (unsigned int)keys[i];
+
+	free(keys);
+	keys = NULL;
+
+	return;
+}
+
+/*
+	Reverse Cuthill-McKee (RCM)
+
+	@INPROCEEDINGS{10.1145/800195.805928,
+		author={Cuthill, E. and McKee, J.},
+		booktitle={Proceedings of the 1969 24th National Conference}, 
+		title={Reducing the Bandwidth of Sparse Symmetric Matrices}, 
+		year={1969},
+		pages={157-172},
+		doi={10.1145/800195.805928}
+	}
+
+	Each component is traversed by a level-synchronous BFS starting from its min-degree vertex. 
+	The order of the Cuthill-McKee BFS is preserved in parallel: a new vertex is the child of its
+	first (i.e., lowest position) parent in the frontier and children of each parent are sorted by degree:
+	(1) Vertices are sorted by degree using `counting_sort_degree_ordering()` that is stable, so the start vertex of
+	each BFS is the unvisited vertex with the min degree and the min ID among them, and the order is deterministic.
+	(2) BFS levels, each having 4 passes over the frontier:
+		(2.1) Each unvisited neighbour selects the frontier vertex with the lowest position as its parent using CAS.
+		(2.2) Counting the children of each frontier vertex.
+		(2.3) Prefix sum of the counts specifies the position of the children in the next frontier.
+		(2.4) Writing the children and sorting them by degree.
+		Small frontiers (< LL_RCM_PARALLEL_FRONTIER) are processed by the master thread.
+	(3) Reversing the order.
+
+	g:
+		Should be symmetric. For directed graphs, only the outgoing edges are traversed.
+
+	Returns an RA_o2n array (indexed by an old vertex ID to get its new vertex ID) that can be passed to `relabel_graph()`.
+
+	flags:
+		0: print details
+		1: do not reset PAPI
+
+	exec_info: if not NULL, will have 
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of BFS traversals (components)
+		[9]: number of BFS levels
+		[10]: bandwidth of the input graph
+		[11]: bandwidth of the relabeled graph
+*/
+
+#define LL_RCM_PARALLEL_FRONTIER 1024
+
+unsigned int* rcm_ordering(struct par_env* pe, struct ll_400_graph* g, unsigned long* exec_info, unsigned int flags)
+{
+	// (1.1) Initial checks
+		unsigned long t0 = - get_nano_time();
+		assert(pe != NULL && g!= NULL && g->vertices_count != 0 && g->offsets_list != NULL);
+		assert(g->vertices_count < (1UL<<32) - 3);
+		if(flags & 1U)
+			printf("\n\033[3;33mrcm_ordering\033[0;37m using \033[3;33m%d\033[0;37m threads.\n", pe->threads_count);
+
+		// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// (1.2) Memory allocation
+		unsigned int vertices_count = g->vertices_count;
+		unsigned int* RA_o2n = numa_alloc_interleaved(sizeof(unsigned int) * vertices_count);
+		unsigned int* order = numa_alloc_interleaved(sizeof(unsigned int) * vertices_count);
+		unsigned int* parent = numa_alloc_interleaved(sizeof(unsigned int) * vertices_count);
+		unsigned int* counts = numa_alloc_interleaved(sizeof(unsigned int) * vertices_count);
+		assert(RA_o2n != NULL && order != NULL && parent != NULL && counts != NULL);
+
+		// RA_o2n[v]: -1U: unvisited, -2U: selected as a child in (2.2), otherwise the position of v in the order
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < vertices_count; v++)
+		{
+			RA_o2n[v] = -1U;
+			parent[v] = -1U;
+		}
+
+	// (1) Degree ordering, in descending order of degrees and ascending order of IDs for equal degrees
+		unsigned long mt = - get_nano_time();
+		unsigned int* RA_n2o = counting_sort_degree_ordering(pe, g, NULL, 2U);
+		assert(RA_n2o != NULL);
+		mt += get_nano_time();
+		if(flags & 1U)
+			PT("(1) Degree ordering");
+
+	// (2) BFS levels
 		mt = - get_nano_time();
-		#pragma omp parallel  
+		unsigned int placed = 0;
+		unsigned int components = 0;
+		unsigned int levels = 0;
+		// The degree buckets of RA_n2o are visited from the last one (min degree) and each one from its start (min ID)
+		unsigned int bucket_start = vertices_count;
+		unsigned int bucket_end = vertices_count;
+		unsigned int cursor = vertices_count;
+		while(placed < vertices_count)
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			#pragma omp for nowait 
-			for(unsigned int p = 0; p<partitions_count; p++)
+			// Selecting the unvisited vertex with the min degree and the min ID as the start vertex
+			while(1)
 			{
-				unsigned long current_offset = partitions_total_edges[p];
-				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				if(cursor == bucket_end)
 				{
-					unsigned long v_degree = out_graph->offsets_list[v];
-					out_graph->offsets_list[v] = current_offset;
-					current_offset += v_degree;
+					assert(bucket_start > 0);
+					bucket_end = bucket_start;
+					unsigned int v = RA_n2o[bucket_end - 1];
+					unsigned long degree = g->offsets_list[v + 1] - g->offsets_list[v];
+					for(bucket_start = bucket_end - 1; bucket_start > 0; bucket_start--)
+					{
+						unsigned int u = RA_n2o[bucket_start - 1];
+						if(g->offsets_list[u + 1] - g->offsets_list[u] != degree)
+							break;
+					}
+					cursor = bucket_start;
 				}
 
-				if(p + 1 < partitions_count)
-					assert(current_offset == partitions_total_edges[p + 1]);
-				else
-					assert(current_offset == out_graph->edges_count);
+				if(RA_o2n[RA_n2o[cursor]] == -1U)
+					break;
+				cursor++;
+			}
+			order[placed] = RA_n2o[cursor];
+			RA_o2n[RA_n2o[cursor]] = placed;
+			unsigned int level_start = placed;
+			unsigned int level_end = placed + 1;
+			placed++;
+			components++;
+
+			while(level_start < level_end)
+			{
+				unsigned int frontier_size = level_end - level_start;
+				unsigned int* frontier = &order[level_start];
+				levels++;
+
+				// (2.1) Selecting parents
+				#pragma omp parallel for schedule(dynamic, 64) if(frontier_size >= LL_RCM_PARALLEL_FRONTIER)
+				for(unsigned int i = 0; i < frontier_size; i++)
+				{
+					unsigned int v = frontier[i];
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = g->edges_list[e];
+						if(RA_o2n[u] != -1U)
+							continue;
+
+						unsigned int p = parent[u];
+						while(i < p)
+						{
+							if(__sync_bool_compare_and_swap(&parent[u], p, i))
+								break;
+							p = parent[u];
+						}
+					}
+				}
+
+				// (2.2) Counting children
+				#pragma omp parallel for schedule(dynamic, 64) if(frontier_size >= LL_RCM_PARALLEL_FRONTIER)
+				for(unsigned int i = 0; i < frontier_size; i++)
+				{
+					unsigned int v = frontier[i];
+					unsigned int count = 0;
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = g->edges_list[e];
+						if(RA_o2n[u] == -1U && parent[u] == i)
+						{
+							RA_o2n[u] = -2U;
+							count++;
+						}
+					}
+					counts[i] = count;
+				}
+
+				// (2.3) Prefix sum
+				unsigned int next_frontier_size = 0;
+				for(unsigned int i = 0; i < frontier_size; i++)
+				{
+					unsigned int temp = counts[i];
+					counts[i] = next_frontier_size;
+					next_frontier_size += temp;
+				}
+				assert(placed + next_frontier_size <= vertices_count);
+
+				// (2.4) Writing children
+				#pragma omp parallel for schedule(dynamic, 64) if(frontier_size >= LL_RCM_PARALLEL_FRONTIER)
+				for(unsigned int i = 0; i < frontier_size; i++)
+				{
+					unsigned int v = frontier[i];
+					unsigned int start = level_end + counts[i];
+					unsigned int pos = start;
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = g->edges_list[e];
+						if(RA_o2n[u] == -2U && parent[u] == i)
+						{
+							order[pos] = u;
+							RA_o2n[u] = pos;
+							pos++;
+						}
+					}
+					assert(pos == (i + 1 < frontier_size ? level_end + counts[i + 1] : level_end + next_frontier_size));
+
+					__rcm_sort_by_degree(g, &order[start], pos - start);
+					for(unsigned int p = start; p < pos; p++)
+						RA_o2n[order[p]] = p;
+				}
+
+				placed += next_frontier_size;
+				level_start = level_end;
+				level_end += next_frontier_size;
 			}
-			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
-		PTIP("(3) Update offsets_list");	
+		if(flags & 1U)
+		{
+			PT("(2) BFS levels");
+			printf("Components: \t\t\t%'u\nLevels: \t\t\t%'u\n", components, levels);
+		}
 
-	// out_graph partitioning
-		unsigned int* out_partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(out_partitions != NULL);
-		parallel_edge_partitioning(out_graph, out_partitions, partitions_count);
-		
-	// (4) Writing edges
+	// (3) Reversing the order
 		mt = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < vertices_count; v++)
+			RA_o2n[v] = vertices_count - 1 - RA_o2n[v];
+		mt += get_nano_time();
+		if(flags & 1U)
+			PT("(3) Reversing");
+
+	// Releasing memory
+		numa_free(RA_n2o, sizeof(unsigned int) * vertices_count);
+		RA_n2o = NULL;
+		numa_free(order, sizeof(unsigned int) * vertices_count);
+		order = NULL;
+		numa_free(parent, sizeof(unsigned int) * vertices_count);
+		parent = NULL;
+		numa_free(counts, sizeof(unsigned int) * vertices_count);
+		counts = NULL;
+
+	// Finalizing
+		t0 += get_nano_time();
+		if(flags & 1U)
+			printf("\nExecution time: %'10.1f (ms)\n", t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = components;
+			exec_info[9] = levels;
+
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+
+			copy_reset_hw_events(pe, &exec_info[1], 1);
+
+			exec_info[10] = relabeled_graph_bandwidth(g, NULL);
+			exec_info[11] = relabeled_graph_bandwidth(g, RA_o2n);
+			if(flags & 1U)
+				printf("Bandwidth: \t\t\t%'lu -> %'lu\n", exec_info[10], exec_info[11]);
+
+			printf("\n");
+		}
+
+	return RA_o2n;
+}
+
+/*
+	Gorder-lite: a windowed greedy ordering
+
+	Gorder selects the next vertex as the one that has the max score with the last `w` placed vertices, where the score 
+	of two vertices is the number of their common neighbours plus the number of edges between them:
+
+	@INPROCEEDINGS{10.1145/2882903.2915220,
+		author={Wei, Hao and Yu, Jeffrey Xu and Lu, Can and Lin, Xuemin},
+		booktitle={Proceedings of the 2016 International Conference on Management of Data}, 
+		title={Speedup Graph Processing by Graph Ordering}, 
+		year={2016},
+		pages={1813-1828},
+		doi={10.1145/2882903.2915220}
+	}
+
+	To reduce its cost, the vertices are divided into partitions of consecutive IDs and each partition is ordered 
+	independently by a thread, i.e., the new IDs of the vertices of a partition are in the ID range of the partition.
+	The IDs are those of `base_RA_o2n`, if not NULL, e.g., the result of `rcm_ordering()`, so that the neighbours of most 
+	vertices are in the same partition. Otherwise, the current IDs are used with edge-balanced partitions. Inside a partition, the greedy selection of Gorder is performed with a window of LL_GORDER_LITE_WINDOW vertices
+	and a bucket priority queue (the unit heap of Gorder). Common neighbours are only counted through vertices with degree 
+	<= LL_GORDER_LITE_HUB_DEGREE and for vertices with degree <= LL_GORDER_LITE_HUB_DEGREE, as hubs would make the 
+	score updates quadratic. Scores are only kept for the vertices of the same partition.
+
+	g:
+		Should be symmetric. For directed graphs, only the outgoing edges are considered.
+
+	base_RA_o2n:
+		An RA_o2n array that specifies the IDs used for partitioning, or NULL.
+
+	Returns an RA_o2n array (indexed by an old vertex ID to get its new vertex ID) that can be passed to `relabel_graph()`.
+
+	flags:
+		0: print details
+		1: do not reset PAPI
+
+	exec_info: if not NULL, will have 
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of partitions
+		[9]: number of edges whose endpoints are at most LL_GORDER_LITE_WINDOW IDs apart in the relabeled graph
+*/
+
+#define LL_GORDER_LITE_WINDOW      5
+#define LL_GORDER_LITE_HUB_DEGREE  32
+#define LL_GORDER_LITE_MAX_BUCKET  255
+
+struct __gorder_lite_heap
+{
+	unsigned int* score;
+	unsigned int* prev;
+	unsigned int* next;
+	unsigned int heads[LL_GORDER_LITE_MAX_BUCKET + 1];
+	unsigned int top;
+};
+
+static inline void __gorder_lite_remove(struct __gorder_lite_heap* h, unsigned int x)
+{
+	unsigned int b = min(h->score[x], LL_GORDER_LITE_MAX_BUCKET);
+	if(h->prev[x] != -1U)
+		h->next[h->prev[x]] = h->next[x];
+	else
+		h->heads[b] = h->next[x];
+	if(h->next[x] != -1U)
+		h->prev[h->next[x]] = h->prev[x];
+
+	return;
+}
+
+static inline void __gorder_lite_insert(struct __gorder_lite_heap* h, unsigned int x)
+{
+	unsigned int b = min(h->score[x], LL_GORDER_LITE_MAX_BUCKET);
+	h->prev[x] = -1U;
+	h->next[x] = h->heads[b];
+	if(h->heads[b] != -1U)
+		h->prev[h->heads[b]] = x;
+	h->heads[b] = x;
+	if(b > h->top)
+		h->top = b;
+
+	return;
+}
+
+static inline void __gorder_lite_update(struct __gorder_lite_heap* h, unsigned int x, int delta)
+{
+	unsigned int new_score = h->score[x] + delta;
+	if(min(new_score, LL_GORDER_LITE_MAX_BUCKET) == min(h->score[x], LL_GORDER_LITE_MAX_BUCKET))
+	{
+		h->score[x] = new_score;
+		return;
+	}
+
+	__gorder_lite_remove(h, x);
+	h->score[x] = new_score;
+	__gorder_lite_insert(h, x);
+
+	return;
+}
+
+/*
+	Updates the scores of the unplaced vertices of the partition [start_id, end_id) of base IDs
+	when `v` enters (delta = 1) or leaves (delta = -1) the window.
+*/
+static inline void __gorder_lite_apply(struct ll_400_graph* g, struct __gorder_lite_heap* h, unsigned int* RA_o2n,
+	unsigned int* base_RA_o2n, unsigned int start_id, unsigned int end_id, unsigned int v, int delta)
+{
+	unsigned long v_degree = g->offsets_list[v + 1] - g->offsets_list[v];
+	for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+	{
+		unsigned int u = g->edges_list[e];
+		unsigned int u_id = base_RA_o2n == NULL ? u : base_RA_o2n[u];
+		if(u_id >= start_id && u_id < end_id && RA_o2n[u] == -1U)
+			__gorder_lite_update(h, u_id - start_id, delta);
+
+		if(v_degree > LL_GORDER_LITE_HUB_DEGREE || g->offsets_list[u + 1] - g->offsets_list[u] > LL_GORDER_LITE_HUB_DEGREE)
+			continue;
+
+		for(unsigned long e2 = g->offsets_list[u]; e2 < g->offsets_list[u + 1]; e2++)
+		{
+			unsigned int w = g->edges_list[e2];
+			unsigned int w_id = base_RA_o2n == NULL ? w : base_RA_o2n[w];
+			if(w != v && w_id >= start_id && w_id < end_id && RA_o2n[w] == -1U)
+				__gorder_lite_update(h, w_id - start_id, delta);
+		}
+	}
+
+	return;
+}
+
+unsigned int* gorder_lite_ordering(struct par_env* pe, struct ll_400_graph* g, unsigned int* base_RA_o2n, unsigned long* exec_info, unsigned int flags)
+{
+	// (1.1) Initial checks
+		unsigned long t0 = - get_nano_time();
+		assert(pe != NULL && g!= NULL && g->vertices_count != 0 && g->offsets_list != NULL);
+		assert(g->vertices_count < (1UL<<32));
+		if(flags & 1U)
+			printf("\n\033[3;33mgorder_lite_ordering\033[0;37m using \033[3;33m%d\033[0;37m threads.\n", pe->threads_count);
+
+		// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel 
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// (1.2) Partitioning and memory allocation
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		if(base_RA_o2n == NULL)
+			parallel_edge_partitioning(g, partitions, partitions_count);
+		else
+			for(unsigned int p = 0; p <= partitions_count; p++)
+				partitions[p] = (unsigned long)g->vertices_count * p / partitions_count;
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+		unsigned int* RA_o2n = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+		assert(RA_o2n != NULL);
+
+		// The vertex of each base ID
+		unsigned int* base_RA_n2o = NULL;
+		if(base_RA_o2n != NULL)
+		{
+			base_RA_n2o = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+			assert(base_RA_n2o != NULL);
+		}
+
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+		{
+			RA_o2n[v] = -1U;
+			if(base_RA_n2o != NULL)
+				base_RA_n2o[base_RA_o2n[v]] = v;
+		}
+
+	// (2) Greedy ordering of partitions
+		unsigned long mt = - get_nano_time();
 		#pragma omp parallel  
 		{
 			unsigned int tid = omp_get_thread_num();
 			ttimes[tid] = - get_nano_time();
 			unsigned int partition = -1U;
-				
+
+			struct __gorder_lite_heap heap;
+			unsigned int window[LL_GORDER_LITE_WINDOW];
+
 			while(1)
 			{
 				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
 				if(partition == -1U)
 					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-				{
-					unsigned int new_v = RA_o2n[v];
-					unsigned long new_e = out_graph->offsets_list[new_v];
 
-					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+				unsigned int start_id = partitions[partition];
+				unsigned int end_id = partitions[partition + 1];
+				unsigned int count = end_id - start_id;
+				if(count == 0)
+					continue;
+
+				heap.score = calloc(sizeof(unsigned int), count);
+				heap.prev = malloc(sizeof(unsigned int) * count);
+				heap.next = malloc(sizeof(unsigned int) * count);
+				assert(heap.score != NULL && heap.prev != NULL && heap.next != NULL);
+				for(unsigned int b = 0; b <= LL_GORDER_LITE_MAX_BUCKET; b++)
+					heap.heads[b] = -1U;
+				heap.top = 0;
+
+				// Vertices with zero score are selected in the order of their base IDs
+				for(unsigned int x = count; x > 0; x--)
+					__gorder_lite_insert(&heap, x - 1);
+
+				for(unsigned int p = 0; p < count; p++)
+				{
+					while(heap.heads[heap.top] == -1U)
 					{
-						out_graph->edges_list[new_e] = RA_o2n[g->edges_list[e]];
-						new_e++;
+						assert(heap.top > 0);
+						heap.top--;
 					}
 
-					assert(new_e == out_graph->offsets_list[new_v+1]);
+					unsigned int x = heap.heads[heap.top];
+					__gorder_lite_remove(&heap, x);
+					unsigned int v = base_RA_n2o == NULL ? start_id + x : base_RA_n2o[start_id + x];
+					RA_o2n[v] = start_id + p;
+
+					if(p >= LL_GORDER_LITE_WINDOW)
+						__gorder_lite_apply(g, &heap, RA_o2n, base_RA_o2n, start_id, end_id, window[p % LL_GORDER_LITE_WINDOW], -1);
+					window[p % LL_GORDER_LITE_WINDOW] = v;
+					__gorder_lite_apply(g, &heap, RA_o2n, base_RA_o2n, start_id, end_id, v, 1);
 				}
+
+				free(heap.score);
+				free(heap.prev);
+				free(heap.next);
+				heap.score = NULL;
+				heap.prev = NULL;
+				heap.next = NULL;
 			}
+
 			ttimes[tid] += get_nano_time();
 		}
 		mt += get_nano_time();
 		dynamic_partitioning_reset(dp);
-		PTIP("(4) Writing edges");
-
-	// (5) Sorting
-		if((flags & 2U))
-		{	
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;	
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = out_partitions[partition]; v < out_partitions[partition + 1]; v++)
-					{
-						unsigned int degree = out_graph->offsets_list[v+1] - out_graph->offsets_list[v];
-						if(degree < 2)
-							continue;
-						quick_sort_uint(&out_graph->edges_list[out_graph->offsets_list[v]], 0, degree - 1);
-					}
-				}
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("(5) Sorting");
-		}
+		if(flags & 1U)
+			PTIP("(2) Greedy ordering");
 
 	// Releasing memory
 		free(partitions);
 		partitions = NULL;
 
-		free(out_partitions);
-		out_partitions = NULL;
-
 		dynamic_partitioning_release(dp);
 		dp = NULL;
 
-		free(partitions_total_edges);
-		partitions_total_edges = NULL;
-
 		free(ttimes);
 		ttimes = NULL;
 
+		if(base_RA_n2o != NULL)
+		{
+			numa_free(base_RA_n2o, sizeof(unsigned int) * g->vertices_count);
+			base_RA_n2o = NULL;
+		}
+
 	// Finalizing
-		tt += get_nano_time();
-		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
-		print_ll_400_graph(out_graph);
-		
-	return out_graph;
+		t0 += get_nano_time();
+		if(flags & 1U)
+			printf("\nExecution time: %'10.1f (ms)\n", t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = partitions_count;
+
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+
+			copy_reset_hw_events(pe, &exec_info[1], 1);
+
+			unsigned long window_edges = 0;
+			#pragma omp parallel for reduction(+: window_edges) schedule(dynamic, 4096)
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					if(labs((long)RA_o2n[v] - (long)RA_o2n[g->edges_list[e]]) <= LL_GORDER_LITE_WINDOW)
+						window_edges++;
+			exec_info[9] = window_edges;
+			if(flags & 1U)
+				printf("Window edges: \t\t\t%'lu (%.1f%%)\n", window_edges, 100.0 * window_edges / max(1UL, g->edges_count));
+
+			printf("\n");
+		}
+
+	return RA_o2n;
+}
+
+/*
+	Sorts the 8 Bytes edges of an ll_404_graph by destination (and then by weight).
+*/
+void __relabel_sort_404_edges(unsigned long* list, unsigned long count)
+{
+	for(unsigned long e = 0; e < count; e++)
+		list[e] = (list[e] << 32) | (list[e] >> 32);
+
+	quick_sort_ulong(list, 0, count - 1);
+
+	for(unsigned long e = 0; e < count; e++)
+		list[e] = (list[e] << 32) | (list[e] >> 32);
+
+	return;
+}
+
+/*
+	Returns the vertex whose neighbour-list contains the edge index `e`, i.e., the vertex `v` 
+	with `offsets_list[v] <= e < offsets_list[v + 1]`, searching in vertices [start_vertex, end_vertex).
+*/
+static inline unsigned int __relabel_edge_source(unsigned long* offsets_list, unsigned long start_vertex, unsigned long end_vertex, unsigned long e)
+{
+	unsigned long start = start_vertex;
+	unsigned long end = end_vertex;
+	while(end - start > 1)
+	{
+		unsigned long m = (start + end) / 2;
+		if(offsets_list[m] <= e)
+			start = m;
+		else
+			end = m;
+	}
+
+	return start;
 }
 
+/*
+	relabel_graph() and relabel_graph_in_place() for ll_400_graph and relabel_ll_404_graph() and 
+	relabel_ll_404_graph_in_place() for ll_404_graph are instantiated from relabel.tpl.c.
+	The edges of an ll_404_graph are accessed as 8 Bytes elements containing the destination in the 
+	lower 4 Bytes and the weight in the higher 4 Bytes.
+*/
+#define LL_T_GRAPH                         ll_400_graph
+#define LL_T_EDGE                          unsigned int
+#define LL_T_EDGE_VID(edge)                (edge)
+#define LL_T_EDGE_SET_VID(edge, v)         (v)
+#define LL_T_SORT_EDGES(list, count)       quick_sort_uint(list, 0, (count) - 1)
+#define LL_T_PRINT_GRAPH(g)                print_ll_400_graph(g)
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning
+#define LL_T_RELABEL_GRAPH                 relabel_graph
+#define LL_T_RELABEL_GRAPH_IN_PLACE        relabel_graph_in_place
+#include "relabel.tpl.c"
+
+#define LL_T_GRAPH                         ll_404_graph
+#define LL_T_EDGE                          unsigned long
+#define LL_T_EDGE_VID(edge)                ((unsigned int)(edge))
+#define LL_T_EDGE_SET_VID(edge, v)         (((edge) & 0xFFFFFFFF00000000UL) | (v))
+#define LL_T_SORT_EDGES(list, count)       __relabel_sort_404_edges(list, count)
+#define LL_T_PRINT_GRAPH(g)                
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_404
+#define LL_T_RELABEL_GRAPH                 relabel_ll_404_graph
+#define LL_T_RELABEL_GRAPH_IN_PLACE        relabel_ll_404_graph_in_place
+#include "relabel.tpl.c"
 unsigned int* get_create_fixed_random_ordering(struct par_env* pe, char* graph_basename, unsigned int vertices_count, int iterations)
 {
 	// Creating the folder, if does not exist
@@ -980,5 +1697,235 @@ unsigned int* get_create_fixed_random_ordering(struct par_env* pe, char* graph_b
 
 	return RA;
 }
-		
+
+/*
+	A checksum of the offsets_list of `g`, used to identify the graph of a cached ordering.
+	The edges_list is not included as reading it would take as long as creating most of the orderings.
+*/
+unsigned long ll_400_graph_offsets_checksum(struct ll_400_graph* g)
+{
+	unsigned long checksum = 0;
+	#pragma omp parallel for reduction(+: checksum)
+	for(unsigned long v = 0; v <= g->vertices_count; v++)
+	{
+		// splitmix64 finalizer of (v, offsets_list[v])
+		unsigned long z = g->offsets_list[v] + v * 0x9E3779B97F4A7C15UL;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9UL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBUL;
+		checksum += z ^ (z >> 31);
+	}
+
+	return checksum;
+}
+
+#define LL_ORDERING_DEGREE        0
+#define LL_ORDERING_RCM           1
+#define LL_ORDERING_HUB_CLUSTER   2
+#define LL_ORDERING_HUB_SORT      3
+#define LL_ORDERING_GORDER_LITE   4
+#define LL_ORDERING_RANDOM        5
+
+char* ll_ordering_names[] = {"DEG", "RCM", "HUBC", "HUBS", "GORL", "RND"};
+
+#define LL_CACHED_ORDERING_MAGIC        0x4C4C5241434845UL   // "LLRACHE"
+#define LL_CACHED_ORDERING_HEADER_SIZE  4096UL
+
+struct ll_cached_ordering_header
+{
+	unsigned long magic;
+	unsigned long type;
+	unsigned long param;
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	unsigned long offsets_checksum;
+};
+
+/*
+	get_create_cached_ordering()
+
+	Returns the RA_o2n array (indexed by an old vertex ID to get its new vertex ID) of ordering `type` of `g` 
+	from LL_GRAPH_RA_BIN_FOLDER. If the array has not been cached or it belongs to another graph, it is created, 
+	stored, and then loaded.
+
+	type:
+		LL_ORDERING_DEGREE: descending degree order using `sapco_sort_degree_ordering()`
+		LL_ORDERING_RCM: `rcm_ordering()`
+		LL_ORDERING_HUB_CLUSTER: `hub_ordering()`
+		LL_ORDERING_HUB_SORT: `hub_ordering()` with hub-sort
+		LL_ORDERING_GORDER_LITE: `gorder_lite_ordering()` on RCM
+		LL_ORDERING_RANDOM: `random_ordering()` with `param` iterations
+
+	param: 
+		Is passed to the ordering (currently only used by LL_ORDERING_RANDOM) and is part of the file name.
+
+	The file contains a header (`struct ll_cached_ordering_header`, padded to LL_CACHED_ORDERING_HEADER_SIZE) recording |V|, |E|,
+	and `ll_400_graph_offsets_checksum()` of the graph, followed by the array. The array is mmapped (read-only) and should be released
+	by `munmap(RA, sizeof(unsigned int) * g->vertices_count)`. The file is written to a temporary file and renamed so that concurrent 
+	jobs either see the complete file or create it themselves.
+*/
+unsigned int* get_create_cached_ordering(struct par_env* pe, char* graph_basename, struct ll_400_graph* g, unsigned int type, unsigned int param)
+{
+	// Initial checks
+		assert(pe != NULL && graph_basename != NULL && g != NULL && g->vertices_count != 0);
+		assert(g->vertices_count < (1UL<<32));
+		assert(type <= LL_ORDERING_RANDOM);
+		unsigned long t0 = - get_nano_time();
+
+	// Creating the folder, if does not exist
+		{
+			struct stat st = {0};
+			if (stat(LL_GRAPH_RA_BIN_FOLDER, &st) == -1)
+				mkdir(LL_GRAPH_RA_BIN_FOLDER, 0700);
+		}
+
+	// Identifying the file
+		char* file_name = malloc(PATH_MAX);
+		assert(file_name != NULL);
+		sprintf(file_name, "%s/%s_%s_%u.bin", LL_GRAPH_RA_BIN_FOLDER, graph_basename, ll_ordering_names[type], param);
+		unsigned long array_size = sizeof(unsigned int) * g->vertices_count;
+		unsigned long file_size = LL_CACHED_ORDERING_HEADER_SIZE + array_size;
+
+		struct ll_cached_ordering_header header = {
+			LL_CACHED_ORDERING_MAGIC, type, param, g->vertices_count, g->edges_count, ll_400_graph_offsets_checksum(g)
+		};
+
+	// Checking the cached file
+		int cached = 0;
+		{
+			int fd = open(file_name, O_RDONLY);
+			if(fd >= 0)
+			{
+				struct ll_cached_ordering_header stored_header;
+				struct stat st = {0};
+				if(fstat(fd, &st) == 0 && st.st_size == file_size && 
+					pread(fd, &stored_header, sizeof(stored_header), 0) == sizeof(stored_header) &&
+					memcmp(&stored_header, &header, sizeof(header)) == 0
+				)
+					cached = 1;
+				else
+					printf("The cached ordering %s does not match the graph.\n", file_name);
+				
+				close(fd);
+				fd = -1;
+			}
+		}
+
+	// Creating the file
+		if(!cached)
+		{
+			unsigned int* RA = NULL;
+			if(type == LL_ORDERING_DEGREE)
+			{
+				unsigned int* RA_n2o = sapco_sort_degree_ordering(pe, g, NULL, 0);
+				assert(RA_n2o != NULL);
+				RA = numa_alloc_interleaved(array_size);
+				assert(RA != NULL);
+				#pragma omp parallel for
+				for(unsigned int v = 0; v < g->vertices_count; v++)
+					RA[RA_n2o[v]] = v;
+				numa_free(RA_n2o, array_size);
+				RA_n2o = NULL;
+			}
+			if(type == LL_ORDERING_RCM)
+				RA = rcm_ordering(pe, g, NULL, 0);
+			if(type == LL_ORDERING_HUB_CLUSTER)
+				RA = hub_ordering(pe, g, NULL, 0);
+			if(type == LL_ORDERING_HUB_SORT)
+				RA = hub_ordering(pe, g, NULL, 4U);
+			if(type == LL_ORDERING_GORDER_LITE)
+			{
+				unsigned int* base_RA = rcm_ordering(pe, g, NULL, 0);
+				RA = gorder_lite_ordering(pe, g, base_RA, NULL, 0);
+				numa_free(base_RA, array_size);
+				base_RA = NULL;
+			}
+			if(type == LL_ORDERING_RANDOM)
+				RA = random_ordering(pe, g->vertices_count, param, NULL);
+			assert(RA != NULL);
+			assert(relabeling_array_validate(pe, RA, g->vertices_count));
+
+			char* temp_file_name = malloc(PATH_MAX);
+			assert(temp_file_name != NULL);
+			sprintf(temp_file_name, "%s.%d.tmp", file_name, getpid());
+
+			int fd=open(temp_file_name, O_RDWR|O_CREAT|O_TRUNC, 0600);
+			if(fd < 0)
+			{
+				printf("Can't open the file, %d, %s\n",errno, strerror(errno));
+				return NULL;
+			}
+
+			if(ftruncate(fd, file_size)!=0)
+			{
+				printf("Can't truncate the file, %d, %s\n",errno, strerror(errno));
+				return NULL;	
+			}
+
+			unsigned char* mem = mmap(
+				NULL
+				, file_size
+				, PROT_READ|PROT_WRITE
+				, MAP_SHARED
+				, fd
+				, 0
+			);
+			if(mem == MAP_FAILED)
+			{
+				printf("Can't mmap the file, %d, %s\n",errno, strerror(errno));
+				return NULL;	
+			}
+
+			memcpy(mem, &header, sizeof(header));
+			unsigned int* stored_RA = (unsigned int*)(mem + LL_CACHED_ORDERING_HEADER_SIZE);
+			#pragma omp parallel for
+			for(unsigned int v = 0; v < g->vertices_count; v++)
+				stored_RA[v] = RA[v];
+
+			int ret = msync(mem, file_size, MS_SYNC);
+			assert(ret == 0);
+
+			munmap(mem, file_size);
+			mem = NULL;
+			stored_RA = NULL;
+
+			close(fd);
+			fd = -1;
+
+			ret = rename(temp_file_name, file_name);
+			assert(ret == 0);
+
+			free(temp_file_name);
+			temp_file_name = NULL;
+
+			numa_free(RA, array_size);
+			RA = NULL;
+		}
+
+	// Loading the array
+		int fd=open(file_name, O_RDONLY);
+		assert(fd > 0);
+
+		unsigned int* RA = mmap(
+			NULL
+			, array_size
+			, PROT_READ 
+			, MAP_SHARED
+			, fd
+			, LL_CACHED_ORDERING_HEADER_SIZE
+		);
+		assert(RA != MAP_FAILED);
+
+		close(fd);
+		fd = -1;
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("%s ordering %s: %s in %'.1f (ms)\n", ll_ordering_names[type], cached ? "loaded" : "created", file_name, t0 / 1e6);
+
+		free(file_name);
+		file_name = NULL;
+
+	return RA;
+}
+
 #endif
\ No newline at end of file
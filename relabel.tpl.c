@@ -0,0 +1,501 @@
+/*
+	Template of the graph relabeling functions for graphs without (ll_400) and with (ll_404) edge weights.
+	This file is included by `relabel.c` once per graph type with the following macros defined:
+		`LL_T_GRAPH`: struct name of the graph, e.g., `ll_400_graph` or `ll_404_graph`
+		`LL_T_EDGE`: type of an element of the edges_list containing one edge (and its weight)
+		`LL_T_EDGE_VID(edge)`: the destination of an edge
+		`LL_T_EDGE_SET_VID(edge, v)`: the edge with its destination replaced by `v` (keeping the weight)
+		`LL_T_SORT_EDGES(list, count)`: sorts `count` edges by destination
+		`LL_T_PRINT_GRAPH(g)`: prints the graph
+		`LL_T_PARALLEL_EDGE_PARTITIONING`: the partitioning function of the graph type
+		`LL_T_RELABEL_GRAPH` and `LL_T_RELABEL_GRAPH_IN_PLACE`: names of the functions
+*/
+
+/*
+	relabel_graph() and relabel_ll_404_graph()
+
+	Creates a new graph with the vertices relabeled by RA_o2n. Weights are moved together with the destinations.
+
+	flags: 
+		bit 0 : TODO: validate results
+		bit 1 : sort neighbour-list of the output  
+*/
+
+struct LL_T_GRAPH* LL_T_RELABEL_GRAPH(struct par_env* pe, struct LL_T_GRAPH* g, unsigned int* RA_o2n, unsigned int flags)
+{
+	// Initial checks
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && g != NULL && RA_o2n != NULL);
+		assert(relabeling_array_validate(pe, RA_o2n, g->vertices_count));
+		printf("\n\033[3;35m%s\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", __func__, pe->threads_count);
+
+	// Partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		printf("partitions: %'u \n", partitions_count);
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(g, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Allocating memory
+		struct LL_T_GRAPH* out_graph =calloc(sizeof(struct LL_T_GRAPH),1);
+		assert(out_graph != NULL);
+		out_graph->vertices_count = g->vertices_count;
+		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + g->vertices_count));
+		assert(out_graph->offsets_list != NULL);
+
+		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
+		assert(partitions_total_edges != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (1) Identifying degree of vertices in the out_graph
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			#pragma omp for nowait 
+			for(unsigned int p = 0; p<partitions_count; p++)
+			{
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				{
+					unsigned int degree = g->offsets_list[v + 1] - g->offsets_list[v];
+					unsigned int new_v = RA_o2n[v];
+					out_graph->offsets_list[new_v] = degree; 
+				}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(1) Identifying degrees");
+		
+	// (2) Calculating sum of edges of each partition in partitions_total_edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			#pragma omp for nowait 
+			for(unsigned int p = 0; p<partitions_count; p++)
+			{
+				unsigned long sum = 0;
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+					sum += out_graph->offsets_list[v];
+				partitions_total_edges[p] = sum;
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(2) Calculating sum");
+	
+	// Partial sum of partitions_total_edges
+		{
+			unsigned long sum = 0;
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long temp = partitions_total_edges[p];
+				partitions_total_edges[p] = sum;
+				sum += temp;
+			}
+			out_graph->edges_count = sum;
+			printf("%-20s \t\t\t %'10lu\n","New graph edges:", out_graph->edges_count);
+			assert(out_graph->edges_count == g->edges_count);
+		}
+		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
+		out_graph->edges_list = numa_alloc_interleaved(sizeof(LL_T_EDGE) * out_graph->edges_count);
+		assert(out_graph->edges_list != NULL);
+		LL_T_EDGE* edges = (LL_T_EDGE*)g->edges_list;
+		LL_T_EDGE* out_edges = (LL_T_EDGE*)out_graph->edges_list;
+
+	// (3) Updating the out_graph->offsets_list
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			#pragma omp for nowait 
+			for(unsigned int p = 0; p<partitions_count; p++)
+			{
+				unsigned long current_offset = partitions_total_edges[p];
+				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				{
+					unsigned long v_degree = out_graph->offsets_list[v];
+					out_graph->offsets_list[v] = current_offset;
+					current_offset += v_degree;
+				}
+
+				if(p + 1 < partitions_count)
+					assert(current_offset == partitions_total_edges[p + 1]);
+				else
+					assert(current_offset == out_graph->edges_count);
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(3) Update offsets_list");	
+
+	// out_graph partitioning
+		unsigned int* out_partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(out_partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(out_graph, out_partitions, partitions_count);
+		
+	// (4) Writing edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+				
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned int new_v = RA_o2n[v];
+					unsigned long new_e = out_graph->offsets_list[new_v];
+
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						out_edges[new_e] = LL_T_EDGE_SET_VID(edges[e], RA_o2n[LL_T_EDGE_VID(edges[e])]);
+						new_e++;
+					}
+
+					assert(new_e == out_graph->offsets_list[new_v+1]);
+				}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("(4) Writing edges");
+
+	// (5) Sorting
+		if((flags & 2U))
+		{	
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;	
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(unsigned int v = out_partitions[partition]; v < out_partitions[partition + 1]; v++)
+					{
+						unsigned int degree = out_graph->offsets_list[v+1] - out_graph->offsets_list[v];
+						if(degree < 2)
+							continue;
+						LL_T_SORT_EDGES(&out_edges[out_graph->offsets_list[v]], degree);
+					}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("(5) Sorting");
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+
+		free(out_partitions);
+		out_partitions = NULL;
+
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+		free(partitions_total_edges);
+		partitions_total_edges = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		LL_T_PRINT_GRAPH(out_graph);
+		
+	return out_graph;
+}
+
+/*
+	relabel_graph_in_place() and relabel_ll_404_graph_in_place()
+
+	Relabels the vertices of `g` by RA_o2n without creating a second copy of the edges, so the peak memory is 
+	the graph plus O(|V|) for the new offsets_list. 
+
+	The move of the edges is a permutation of the edges_list: the edge at index `e` of the neighbour-list of `v`
+	goes to index `e - offsets_list[v]` of the neighbour-list of RA_o2n[v] in the new offsets_list. 
+	The permutation is performed by cycle-following in parallel: the edges_list is divided into chunks of 
+	LL_RELABEL_IN_PLACE_CHUNK edges that are dynamically assigned to threads. The first vertex of each chunk is 
+	stored, so the source vertex of an edge is found by a binary search limited to the vertices of its chunk.
+	Each thread follows LL_RELABEL_IN_PLACE_CHAINS chains at the same time to overlap their memory accesses. For each edge of its chunks 
+	that has not been moved, a thread claims the edge by marking it (using bit 31 of the destination) and 
+	carries it to its new index and continues with the edge that was there, until it reaches a marked index, 
+	i.e., an index whose edge has been claimed by itself or another thread. Atomic exchanges make sure each 
+	edge is carried by one thread. The destinations are relabeled in a sequential pass before the cycle-following
+	to shorten the chain of dependent memory accesses of each move.
+
+	The input graph should be writable (not mapped from shm or streamed) and |V| should be less than 2^31.
+
+	flags: 
+		bit 1 : sort neighbour-lists after relabeling
+*/
+
+#ifndef LL_RELABEL_IN_PLACE_CHUNK
+	#define LL_RELABEL_IN_PLACE_CHUNK   (1UL << 16)
+	#define LL_RELABEL_IN_PLACE_CHAINS  16
+#endif
+
+void LL_T_RELABEL_GRAPH_IN_PLACE(struct par_env* pe, struct LL_T_GRAPH* g, unsigned int* RA_o2n, unsigned int flags)
+{
+	// Initial checks
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && g != NULL && RA_o2n != NULL);
+		assert(g->vertices_count < (1UL << 31));
+		assert(relabeling_array_validate(pe, RA_o2n, g->vertices_count));
+		printf("\n\033[3;35m%s\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", __func__, pe->threads_count);
+
+	// Partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+		assert(partitions != NULL);
+		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
+		assert(partitions_total_edges != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+		unsigned long* offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (1 + g->vertices_count));
+		assert(offsets_list != NULL);
+
+		LL_T_EDGE* edges = (LL_T_EDGE*)g->edges_list;
+		const LL_T_EDGE mark = ((LL_T_EDGE)1) << 31;
+
+	// (1) Identifying degree of vertices in the new offsets_list
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			offsets_list[RA_o2n[v]] = g->offsets_list[v + 1] - g->offsets_list[v];
+		mt += get_nano_time();
+		PT("(1) Identifying degrees");
+
+	// (2) Calculating the new offsets_list
+		mt = - get_nano_time();
+		for(unsigned int p = 0; p <= partitions_count; p++)
+			partitions[p] = (unsigned long)g->vertices_count * p / partitions_count;
+
+		#pragma omp parallel for 
+		for(unsigned int p = 0; p < partitions_count; p++)
+		{
+			unsigned long sum = 0;
+			for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+				sum += offsets_list[v];
+			partitions_total_edges[p] = sum;
+		}
+
+		unsigned long sum = 0;
+		for(unsigned int p = 0; p < partitions_count; p++)
+		{
+			unsigned long temp = partitions_total_edges[p];
+			partitions_total_edges[p] = sum;
+			sum += temp;
+		}
+		assert(sum == g->edges_count);
+		offsets_list[g->vertices_count] = g->edges_count;
+
+		#pragma omp parallel for 
+		for(unsigned int p = 0; p < partitions_count; p++)
+		{
+			unsigned long current_offset = partitions_total_edges[p];
+			for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
+			{
+				unsigned long v_degree = offsets_list[v];
+				offsets_list[v] = current_offset;
+				current_offset += v_degree;
+			}
+		}
+		mt += get_nano_time();
+		PT("(2) New offsets_list");
+
+	// (3) Relabeling the destinations
+		mt = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned long e = 0; e < g->edges_count; e++)
+			edges[e] = LL_T_EDGE_SET_VID(edges[e], RA_o2n[LL_T_EDGE_VID(edges[e])]);
+		mt += get_nano_time();
+		PT("(3) Relabeling destinations");
+
+	// (4) Cycle-following
+		mt = - get_nano_time();
+		unsigned long chunks_count = (g->edges_count + LL_RELABEL_IN_PLACE_CHUNK - 1) / LL_RELABEL_IN_PLACE_CHUNK;
+		unsigned int* chunks_vertices = malloc(sizeof(unsigned int) * (chunks_count + 1));
+		assert(chunks_vertices != NULL);
+		#pragma omp parallel for
+		for(unsigned long c = 0; c < chunks_count; c++)
+			chunks_vertices[c] = __relabel_edge_source(g->offsets_list, 0, g->vertices_count, c * LL_RELABEL_IN_PLACE_CHUNK);
+		chunks_vertices[chunks_count] = g->vertices_count - 1;
+
+		unsigned long moved_edges = 0;
+		unsigned long cycles = 0;
+		#pragma omp parallel reduction(+: moved_edges, cycles)
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			// Edges being carried and their current indices
+			LL_T_EDGE carried_edges[LL_RELABEL_IN_PLACE_CHAINS];
+			unsigned long carried_indices[LL_RELABEL_IN_PLACE_CHAINS];
+			unsigned long new_indices[LL_RELABEL_IN_PLACE_CHAINS];
+
+			#pragma omp for schedule(dynamic, 1) nowait
+			for(unsigned long c = 0; c < chunks_count; c++)
+			{
+				unsigned long start_edge = c * LL_RELABEL_IN_PLACE_CHUNK;
+				unsigned long end_edge = min(g->edges_count, start_edge + LL_RELABEL_IN_PLACE_CHUNK);
+				unsigned long s = start_edge;
+				unsigned int chains = 0;
+				while(1)
+				{
+					// Claiming edges of the chunk to start new chains
+					for(; s < end_edge && chains < LL_RELABEL_IN_PLACE_CHAINS; s++)
+					{
+						LL_T_EDGE edge = edges[s];
+						if(edge & mark)
+							continue;
+						if(!__sync_bool_compare_and_swap(&edges[s], edge, edge | mark))
+							continue;
+
+						carried_edges[chains] = edge;
+						carried_indices[chains] = s;
+						chains++;
+						cycles++;
+					}
+					if(chains == 0)
+						break;
+
+					// Identifying the new indices of the carried edges
+					for(unsigned int i = 0; i < chains; i++)
+					{
+						unsigned long e = carried_indices[i];
+						unsigned long e_chunk = e / LL_RELABEL_IN_PLACE_CHUNK;
+						unsigned int v = __relabel_edge_source(g->offsets_list, chunks_vertices[e_chunk], chunks_vertices[e_chunk + 1] + 1, e);
+						new_indices[i] = offsets_list[RA_o2n[v]] + e - g->offsets_list[v];
+						__builtin_prefetch(&edges[new_indices[i]], 1);
+					}
+
+					// Moving the carried edges and picking up the edges at the new indices
+					for(unsigned int i = 0; i < chains; )
+					{
+						LL_T_EDGE edge = __atomic_exchange_n(&edges[new_indices[i]], carried_edges[i] | mark, __ATOMIC_RELAXED);
+						moved_edges++;
+						if(edge & mark)
+						{
+							// The chain has reached a claimed index
+							chains--;
+							carried_edges[i] = carried_edges[chains];
+							carried_indices[i] = carried_indices[chains];
+							new_indices[i] = new_indices[chains];
+							continue;
+						}
+
+						carried_edges[i] = edge;
+						carried_indices[i] = new_indices[i];
+						i++;
+					}
+				}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		assert(moved_edges == g->edges_count);
+		free(chunks_vertices);
+		chunks_vertices = NULL;
+		{
+			char temp[255];
+			sprintf(temp, "(4) Cycle-following, cycles: %'lu", cycles);
+			PTIP(temp);
+		}
+
+	// (5) Removing marks and replacing the offsets_list
+		mt = - get_nano_time();
+		#pragma omp parallel for
+		for(unsigned long e = 0; e < g->edges_count; e++)
+			edges[e] &= ~mark;
+
+		numa_free(g->offsets_list, sizeof(unsigned long) * (1 + g->vertices_count));
+		g->offsets_list = offsets_list;
+		offsets_list = NULL;
+		mt += get_nano_time();
+		PT("(5) Replacing offsets_list");
+
+	// (6) Sorting
+		if((flags & 2U))
+		{	
+			mt = - get_nano_time();
+			LL_T_PARALLEL_EDGE_PARTITIONING(g, partitions, partitions_count);
+			struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;	
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						unsigned long degree = g->offsets_list[v+1] - g->offsets_list[v];
+						if(degree < 2)
+							continue;
+						LL_T_SORT_EDGES(&edges[g->offsets_list[v]], degree);
+					}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_release(dp);
+			dp = NULL;
+			PTIP("(6) Sorting");
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+
+		free(partitions_total_edges);
+		partitions_total_edges = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		LL_T_PRINT_GRAPH(g);
+		
+	return;
+}
+
+#undef LL_T_GRAPH
+#undef LL_T_EDGE
+#undef LL_T_EDGE_VID
+#undef LL_T_EDGE_SET_VID
+#undef LL_T_SORT_EDGES
+#undef LL_T_PRINT_GRAPH
+#undef LL_T_PARALLEL_EDGE_PARTITIONING
+#undef LL_T_RELABEL_GRAPH
+#undef LL_T_RELABEL_GRAPH_IN_PLACE
@@ -0,0 +1,894 @@
+#ifndef __SCC_C
+#define __SCC_C
+
+// This file contains the implementation of the Strongly Connected Components
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+
+/*
+	Strongly Connected Components using Trimming, Forward-Backward, and Coloring (Multistep)
+
+	[Multistep, DOI:10.1109/IPDPS.2014.64]
+
+	(1) Trimming: vertices without active in-neighbours or without active out-neighbours
+	are SCCs of size 1. Trimming is repeated (at most `LL_SCC_TRIM_MAX_PASSES` passes) until no
+	vertex is trimmed.
+
+	(2) Forward-Backward: similar to Zero Planting in `cc_thrifty_400()`, the active vertex with the
+	max (in-degree * out-degree) is selected as the pivot which is likely to be in the largest SCC.
+	The vertices reachable from the pivot (forward traversal over CSR) and the vertices that reach the
+	pivot (backward traversal over CSC) are identified using level-synchronous traversals with shared
+	SPF worklists. Their intersection is the SCC of the pivot. Then, the trimming is repeated.
+
+	(3) Coloring: for the long tail of small SCCs, in each round:
+		(3.1) each active vertex gets its ID as color and the max color is propagated forward
+		(pushed over the CSR) until convergence. So, each vertex is reachable from the vertex whose ID is
+		equal to its color (the root) and all vertices of an SCC have the same color.
+		(3.2) the SCC of each root is identified by backward propagation (pushed over the CSC) limited to
+		the vertices with the same color.
+	Both propagations use worklists, so each iteration processes only the vertices changed in the previous
+	iteration, and the active vertices are kept in a list that is compacted after each round.
+	The assigned vertices are removed and rounds are repeated while more than `LL_SCC_SERIAL_THRESHOLD` vertices
+	are unassigned and each round assigns at least 1/`LL_SCC_MIN_ROUND_RATIO` of the remaining vertices.
+	As the max color may pass long chains of SCCs many times, coloring is stopped when the total number of
+	processed edges exceeds `threads_count` / `LL_SCC_COLORING_WORK_RATIO` times (|V| + |E|), the work of
+	the serial Tarjan, as it cannot be faster than the serial Tarjan even with a linear speedup.
+
+	(4) Serial: the remaining vertices are assigned by the serial Tarjan's algorithm over the subgraph
+	induced by them, as coloring needs many rounds for long chains of small SCCs.
+
+	Vertices are scheduled using `parallel_edge_partitioning()` of the CSR and dynamic partitioning. The worklists
+	are processed using dynamic scheduling by at most one thread per `LL_SCC_WORKLIST_VERTICES_PER_THREAD` vertices.
+
+	csr: the graph
+	csc: the transposed graph, e.g., created by `potra()`
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: number of SCCs
+		[9]: number of trimmed vertices
+		[10]: the pivot
+		[11]: size of the SCC of the pivot
+		[12]: number of coloring rounds
+		[13]: trimming time
+		[14]: forward-backward time
+		[15]: coloring time
+		[16]: number of vertices assigned by the serial Tarjan
+		[17]: serial Tarjan time
+
+	Returns the array of SCC labels, i.e., the ID of a vertex of the SCC
+*/
+
+#define LL_SCC_UNASSIGNED (-1U)
+#define LL_SCC_TRIM_MAX_PASSES 16
+#define LL_SCC_SERIAL_THRESHOLD (1U << 16)
+#define LL_SCC_MIN_ROUND_RATIO 64
+#define LL_SCC_COLORING_WORK_RATIO 2
+#define LL_SCC_WORKLIST_VERTICES_PER_THREAD 256
+
+// Returns 1 if `v` has an active neighbour other than itself in `g`
+static inline int __scc_has_active_neighbour(struct ll_400_graph* g, unsigned int v, unsigned int* scc)
+{
+	for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+	{
+		unsigned int u = g->edges_list[e];
+		if(u != v && scc[u] == LL_SCC_UNASSIGNED)
+			return 1;
+	}
+
+	return 0;
+}
+
+/*
+	Trims the active vertices without active in-neighbours or out-neighbours.
+	Returns the number of trimmed vertices.
+*/
+unsigned long __scc_trim(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, unsigned int* scc,
+	unsigned int* partitions, struct dynamic_partitioning* dp, unsigned long* ttimes)
+{
+	unsigned long total_trimmed = 0;
+	for(unsigned int pass = 0; pass < LL_SCC_TRIM_MAX_PASSES; pass++)
+	{
+		unsigned long trimmed = 0;
+		#pragma omp parallel reduction(+:trimmed)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] -= get_nano_time();
+			unsigned int partition = -1U;
+
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break;
+
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					if(scc[v] != LL_SCC_UNASSIGNED)
+						continue;
+
+					if(!__scc_has_active_neighbour(csr, v, scc) || !__scc_has_active_neighbour(csc, v, scc))
+					{
+						scc[v] = v;
+						trimmed++;
+					}
+				}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		dynamic_partitioning_reset(dp);
+
+		total_trimmed += trimmed;
+		if(trimmed == 0)
+			break;
+	}
+
+	return total_trimmed;
+}
+
+/*
+	Marks the active vertices reachable from the vertices of `worklist` in `g` by setting their `marks` to 1.
+	The vertices of `worklist` should have been marked by the caller and `-1U` elements are skipped.
+	If `color` is not NULL, the traversal is limited to the neighbours with the same color.
+	`worklist` and `next_worklist` have `worklist_size` elements.
+	Returns the number of marked vertices, including the vertices of `worklist`.
+*/
+unsigned long __scc_reach(struct par_env* pe, struct ll_400_graph* g, unsigned int* color, unsigned int* scc, unsigned char* marks,
+	unsigned int* worklist, unsigned int worklist_length, unsigned int* next_worklist, unsigned int worklist_size, unsigned long* ttimes)
+{
+	unsigned int waspr = 16;  // worklist_allocation_size_per_request
+	unsigned long marked = 0;
+	#pragma omp parallel for reduction(+:marked)
+	for(unsigned int index = 0; index < worklist_length; index++)
+		if(worklist[index] != -1U)
+			marked++;
+
+	while(worklist_length)
+	{
+		// Small levels, e.g., in long chains, are processed by fewer threads to reduce the synchronization cost
+		unsigned int threads = min(pe->threads_count, 1 + worklist_length / LL_SCC_WORKLIST_VERTICES_PER_THREAD);
+		unsigned int next_worklist_length = waspr * threads;
+		unsigned long level_marked = 0;
+
+		#pragma omp parallel num_threads(threads) reduction(+:level_marked)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] -= get_nano_time();
+
+			unsigned int thread_index = tid * waspr;
+			unsigned int thread_end = (tid + 1) * waspr;
+
+			#pragma omp for schedule(dynamic, 64) nowait
+			for(unsigned int index = 0; index < worklist_length; index++)
+			{
+				unsigned int v = worklist[index];
+				if(v == -1U)
+					continue;
+
+				for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+				{
+					unsigned int u = g->edges_list[e];
+					if(marks[u] || scc[u] != LL_SCC_UNASSIGNED)
+						continue;
+					if(color != NULL && color[u] != color[v])
+						continue;
+					if(!__sync_bool_compare_and_swap(&marks[u], 0, 1))
+						continue;
+
+					level_marked++;
+					next_worklist[thread_index++] = u;
+					if(thread_index == thread_end)
+					{
+						// grab a new chunk
+						do
+						{
+							thread_index = next_worklist_length;
+							thread_end = thread_index + waspr;
+						}while(__sync_val_compare_and_swap(&next_worklist_length, thread_index, thread_end) != thread_index);
+						assert(next_worklist_length <= worklist_size);
+					}
+				}
+			}
+
+			// fill unused indecis with -1 to prevent from being processed in the next level
+			while(thread_index < thread_end)
+				next_worklist[thread_index++] = -1U;
+
+			ttimes[tid] += get_nano_time();
+		}
+
+		marked += level_marked;
+		worklist_length = level_marked ? next_worklist_length : 0;
+
+		unsigned int* temp = worklist;
+		worklist = next_worklist;
+		next_worklist = temp;
+	}
+
+	return marked;
+}
+
+/*
+	Propagates the max color forward (pushed over `csr`) from the active vertices of `worklist` until
+	convergence. In each iteration, only the vertices whose colors have been changed in the previous
+	iteration are processed. `queued[v]` is the last iteration in which `v` has been added to the next
+	worklist and should be less than 1 for the vertices of `worklist`.
+	`worklist` and `next_worklist` have `worklist_size` elements.
+
+	Returns the number of processed edges, or -1UL if it exceeds `max_edges`, i.e., the colors are not
+	complete. `*iterations_p` is set to the number of iterations.
+*/
+unsigned long __scc_color(struct par_env* pe, struct ll_400_graph* csr, unsigned int* scc, unsigned int* color, unsigned int* queued,
+	unsigned int* worklist, unsigned int worklist_length, unsigned int* next_worklist, unsigned int worklist_size,
+	unsigned long max_edges, unsigned int* iterations_p, unsigned long* ttimes)
+{
+	unsigned int waspr = 16;  // worklist_allocation_size_per_request
+	unsigned long edges = 0;
+	unsigned int iter = 0;
+
+	while(worklist_length)
+	{
+		iter++;
+		unsigned int threads = min(pe->threads_count, 1 + worklist_length / LL_SCC_WORKLIST_VERTICES_PER_THREAD);
+		unsigned int next_worklist_length = waspr * threads;
+		unsigned long queued_count = 0;
+		unsigned long iter_edges = 0;
+
+		#pragma omp parallel num_threads(threads) reduction(+:queued_count, iter_edges)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] -= get_nano_time();
+
+			unsigned int thread_index = tid * waspr;
+			unsigned int thread_end = (tid + 1) * waspr;
+
+			#pragma omp for schedule(dynamic, 64) nowait
+			for(unsigned int index = 0; index < worklist_length; index++)
+			{
+				unsigned int v = worklist[index];
+				if(v == -1U)
+					continue;
+
+				// If `color[v]` is increased after this read, `v` is queued for the next iteration
+				unsigned int c = color[v];
+				iter_edges += csr->offsets_list[v + 1] - csr->offsets_list[v];
+				for(unsigned long e = csr->offsets_list[v]; e < csr->offsets_list[v + 1]; e++)
+				{
+					unsigned int u = csr->edges_list[e];
+					if(scc[u] != LL_SCC_UNASSIGNED)
+						continue;
+
+					// Atomic max
+					unsigned int cu = color[u];
+					int updated = 0;
+					while(cu < c)
+					{
+						unsigned int prev = __sync_val_compare_and_swap(&color[u], cu, c);
+						if(prev == cu)
+						{
+							updated = 1;
+							break;
+						}
+						cu = prev;
+					}
+					if(!updated)
+						continue;
+
+					unsigned int q = queued[u];
+					if(q == iter || !__sync_bool_compare_and_swap(&queued[u], q, iter))
+						continue;
+
+					queued_count++;
+					next_worklist[thread_index++] = u;
+					if(thread_index == thread_end)
+					{
+						// grab a new chunk
+						do
+						{
+							thread_index = next_worklist_length;
+							thread_end = thread_index + waspr;
+						}while(__sync_val_compare_and_swap(&next_worklist_length, thread_index, thread_end) != thread_index);
+						assert(next_worklist_length <= worklist_size);
+					}
+				}
+			}
+
+			// fill unused indecis with -1 to prevent from being processed in the next iteration
+			while(thread_index < thread_end)
+				next_worklist[thread_index++] = -1U;
+
+			ttimes[tid] += get_nano_time();
+		}
+
+		edges += iter_edges;
+		if(edges > max_edges)
+		{
+			*iterations_p = iter;
+			return -1UL;
+		}
+
+		worklist_length = queued_count ? next_worklist_length : 0;
+
+		unsigned int* temp = worklist;
+		worklist = next_worklist;
+		next_worklist = temp;
+	}
+
+	*iterations_p = iter;
+	return edges;
+}
+
+/*
+	Writes the active vertices of `list` (or all vertices if `list` is NULL) to `active_list` that has
+	`active_list_size` elements. Unused elements of `active_list` are set to `-1U`.
+	Returns the length of `active_list` and sets `*active_p` to the number of active vertices and
+	`*active_edges_p` to the number of their out-edges in `csr`.
+*/
+unsigned int __scc_active_list(struct par_env* pe, struct ll_400_graph* csr, unsigned int* scc, unsigned int* list, unsigned int list_length,
+	unsigned int* active_list, unsigned int active_list_size, unsigned long* active_p, unsigned long* active_edges_p)
+{
+	unsigned int waspr = 16;  // worklist_allocation_size_per_request
+	unsigned int active_list_length = waspr * pe->threads_count;
+	unsigned long active = 0;
+	unsigned long active_edges = 0;
+	unsigned int length = list == NULL ? csr->vertices_count : list_length;
+
+	#pragma omp parallel reduction(+:active, active_edges)
+	{
+		unsigned tid = omp_get_thread_num();
+		unsigned int thread_index = tid * waspr;
+		unsigned int thread_end = (tid + 1) * waspr;
+
+		#pragma omp for nowait
+		for(unsigned int index = 0; index < length; index++)
+		{
+			unsigned int v = list == NULL ? index : list[index];
+			if(v == -1U || scc[v] != LL_SCC_UNASSIGNED)
+				continue;
+
+			active++;
+			active_edges += csr->offsets_list[v + 1] - csr->offsets_list[v];
+			active_list[thread_index++] = v;
+			if(thread_index == thread_end)
+			{
+				// grab a new chunk
+				do
+				{
+					thread_index = active_list_length;
+					thread_end = thread_index + waspr;
+				}while(__sync_val_compare_and_swap(&active_list_length, thread_index, thread_end) != thread_index);
+				assert(active_list_length <= active_list_size);
+			}
+		}
+
+		while(thread_index < thread_end)
+			active_list[thread_index++] = -1U;
+	}
+
+	*active_p = active;
+	*active_edges_p = active_edges;
+	return active_list_length;
+}
+
+/*
+	Serial Tarjan's SCC with an explicit stack over the unassigned vertices of `scc`, i.e., the vertices
+	with `LL_SCC_UNASSIGNED` label and the edges between them. The label of each SCC is the ID of its root.
+	Returns the number of identified SCCs.
+*/
+unsigned long __scc_tarjan(struct ll_400_graph* g, unsigned int* scc)
+{
+	assert(g != NULL && scc != NULL);
+	const unsigned int vc = g->vertices_count;
+
+	unsigned int* index = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	unsigned int* low = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	unsigned int* stack = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	unsigned int* call_vertices = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	unsigned long* call_edges = numa_alloc_interleaved(sizeof(unsigned long) * vc);
+	assert(index != NULL && low != NULL && stack != NULL && call_vertices != NULL && call_edges != NULL);
+	for(unsigned int v = 0; v < vc; v++)
+		index[v] = -1U;
+
+	unsigned long sccs = 0;
+	unsigned int next_index = 0;
+	unsigned int stack_size = 0;
+	for(unsigned int s = 0; s < vc; s++)
+	{
+		if(index[s] != -1U || scc[s] != LL_SCC_UNASSIGNED)
+			continue;
+
+		unsigned int depth = 1;
+		call_vertices[0] = s;
+		call_edges[0] = g->offsets_list[s];
+		index[s] = low[s] = next_index++;
+		stack[stack_size++] = s;
+
+		while(depth)
+		{
+			unsigned int v = call_vertices[depth - 1];
+			unsigned long e = call_edges[depth - 1];
+			if(e < g->offsets_list[v + 1])
+			{
+				call_edges[depth - 1]++;
+				unsigned int u = g->edges_list[e];
+				if(index[u] == -1U)
+				{
+					// Skipping the vertices that have been assigned before
+					if(scc[u] != LL_SCC_UNASSIGNED)
+						continue;
+
+					index[u] = low[u] = next_index++;
+					stack[stack_size++] = u;
+					call_vertices[depth] = u;
+					call_edges[depth] = g->offsets_list[u];
+					depth++;
+				}
+				// u is on the stack
+				else if(scc[u] == LL_SCC_UNASSIGNED && index[u] < low[v])
+					low[v] = index[u];
+
+				continue;
+			}
+
+			// All neighbours of v have been visited
+			if(low[v] == index[v])
+			{
+				unsigned int u;
+				do
+				{
+					u = stack[--stack_size];
+					scc[u] = v;
+				}while(u != v);
+				sccs++;
+			}
+
+			depth--;
+			if(depth && low[v] < low[call_vertices[depth - 1]])
+				low[call_vertices[depth - 1]] = low[v];
+		}
+	}
+
+	numa_free(index, sizeof(unsigned int) * vc);
+	index = NULL;
+	numa_free(low, sizeof(unsigned int) * vc);
+	low = NULL;
+	numa_free(stack, sizeof(unsigned int) * vc);
+	stack = NULL;
+	numa_free(call_vertices, sizeof(unsigned int) * vc);
+	call_vertices = NULL;
+	numa_free(call_edges, sizeof(unsigned long) * vc);
+	call_edges = NULL;
+
+	return sccs;
+}
+
+unsigned int* scc_multistep(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, unsigned int flags, unsigned long* exec_info, unsigned int* sccs_p)
+{
+	// (1) Initial checks
+		assert(pe != NULL && csr != NULL && csc != NULL && csr->vertices_count > 0);
+		assert(csr->vertices_count == csc->vertices_count && csr->edges_count == csc->edges_count);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mscc_multistep\033[0;37m using \033[3;31m%d\033[0;37m threads.\n", pe->threads_count);
+		const unsigned int vc = csr->vertices_count;
+
+	// (2) Allocate memory
+		unsigned int* scc = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		unsigned int* color = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		assert(scc != NULL && color != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < vc; v++)
+			scc[v] = LL_SCC_UNASSIGNED;
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (3) Edge partitioning
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(csr, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (4) Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// (5) Trimming
+		unsigned long mt = - get_nano_time();
+		unsigned long trimmed = __scc_trim(pe, csr, csc, scc, partitions, dp, ttimes);
+		mt += get_nano_time();
+		unsigned long trim_time = mt;
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "(5) Trimming, trimmed: %'lu:", trimmed);
+			PTIP(temp);
+		}
+
+	// (6) Forward-Backward from the pivot
+		mt = - get_nano_time();
+		for(unsigned int t = 0; t < pe->threads_count; t++)
+			ttimes[t] = 0;
+		unsigned int pivot = -1U;
+		unsigned long pivot_scc_size = 0;
+		{
+			// Selecting the pivot
+			unsigned long max_vals[2] = {0, -1UL};
+			#pragma omp parallel
+			{
+				unsigned long thread_max_vals[2] = {0, -1UL};
+
+				#pragma omp for nowait
+				for(unsigned int v = 0; v < vc; v++)
+				{
+					if(scc[v] != LL_SCC_UNASSIGNED)
+						continue;
+
+					unsigned long product = (csr->offsets_list[v + 1] - csr->offsets_list[v]) * (csc->offsets_list[v + 1] - csc->offsets_list[v]);
+					if(product > thread_max_vals[0] || thread_max_vals[1] == -1UL)
+					{
+						thread_max_vals[0] = product;
+						thread_max_vals[1] = v;
+					}
+				}
+
+				#pragma omp critical
+				{
+					if(thread_max_vals[1] != -1UL && (max_vals[1] == -1UL || thread_max_vals[0] > max_vals[0]))
+					{
+						max_vals[0] = thread_max_vals[0];
+						max_vals[1] = thread_max_vals[1];
+					}
+				}
+			}
+
+			if(max_vals[1] != -1UL)
+			{
+				pivot = max_vals[1];
+
+				unsigned int worklist_size = vc + 2 * 16 * pe->threads_count;
+				unsigned int* worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+				unsigned int* next_worklist = numa_alloc_interleaved(sizeof(unsigned int) * worklist_size);
+				unsigned char* fw = numa_alloc_interleaved(sizeof(unsigned char) * vc);
+				unsigned char* bw = numa_alloc_interleaved(sizeof(unsigned char) * vc);
+				assert(worklist != NULL && next_worklist != NULL && fw != NULL && bw != NULL);
+
+				worklist[0] = pivot;
+				fw[pivot] = 1;
+				unsigned long fw_count = __scc_reach(pe, csr, NULL, scc, fw, worklist, 1, next_worklist, worklist_size, ttimes);
+				worklist[0] = pivot;
+				bw[pivot] = 1;
+				unsigned long bw_count = __scc_reach(pe, csc, NULL, scc, bw, worklist, 1, next_worklist, worklist_size, ttimes);
+
+				#pragma omp parallel for reduction(+:pivot_scc_size)
+				for(unsigned int v = 0; v < vc; v++)
+					if(fw[v] && bw[v])
+					{
+						scc[v] = pivot;
+						pivot_scc_size++;
+					}
+
+				if(flags & 1U)
+					printf("Pivot: %'u, forward: %'lu, backward: %'lu, SCC: %'lu\n", pivot, fw_count, bw_count, pivot_scc_size);
+
+				numa_free(worklist, sizeof(unsigned int) * worklist_size);
+				worklist = NULL;
+				numa_free(next_worklist, sizeof(unsigned int) * worklist_size);
+				next_worklist = NULL;
+				numa_free(fw, sizeof(unsigned char) * vc);
+				fw = NULL;
+				numa_free(bw, sizeof(unsigned char) * vc);
+				bw = NULL;
+			}
+		}
+		mt += get_nano_time();
+		unsigned long fb_time = mt;
+		if(flags & 1U)
+			PTIP("(6) Forward-Backward:");
+
+		// Trimming the remaining vertices
+		mt = - get_nano_time();
+		for(unsigned int t = 0; t < pe->threads_count; t++)
+			ttimes[t] = 0;
+		unsigned long trimmed_2 = __scc_trim(pe, csr, csc, scc, partitions, dp, ttimes);
+		trimmed += trimmed_2;
+		mt += get_nano_time();
+		trim_time += mt;
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "(6) Trimming, trimmed: %'lu:", trimmed_2);
+			PTIP(temp);
+		}
+
+	// (7) Coloring rounds
+		unsigned long coloring_time = 0;
+		unsigned int rounds = 0;
+		unsigned long active = 0;
+		unsigned long coloring_edges = 0;
+		unsigned long active_edges = 0;
+		unsigned int list_size = vc + 2 * 16 * pe->threads_count;
+		unsigned int* active_list = numa_alloc_interleaved(sizeof(unsigned int) * list_size);
+		unsigned int* next_active_list = numa_alloc_interleaved(sizeof(unsigned int) * list_size);
+		assert(active_list != NULL && next_active_list != NULL);
+		unsigned int active_list_length = __scc_active_list(pe, csr, scc, NULL, 0, active_list, list_size, &active, &active_edges);
+
+		if(active > LL_SCC_SERIAL_THRESHOLD)
+		{
+			unsigned long coloring_max_edges = pe->threads_count * (active + csr->edges_count) / LL_SCC_COLORING_WORK_RATIO;
+			unsigned int* worklist = numa_alloc_interleaved(sizeof(unsigned int) * list_size);
+			unsigned int* next_worklist = numa_alloc_interleaved(sizeof(unsigned int) * list_size);
+			unsigned int* queued = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+			unsigned char* marks = numa_alloc_interleaved(sizeof(unsigned char) * vc);
+			assert(worklist != NULL && next_worklist != NULL && queued != NULL && marks != NULL);
+
+			while(active > LL_SCC_SERIAL_THRESHOLD)
+			{
+				// The first iteration of coloring processes all active edges
+				if(coloring_edges + active_edges > coloring_max_edges)
+				{
+					if(flags & 1U)
+						printf("(7) Coloring skipped, active edges: %'lu\n", active_edges);
+					break;
+				}
+
+				mt = - get_nano_time();
+				for(unsigned int t = 0; t < pe->threads_count; t++)
+					ttimes[t] = 0;
+
+				// (7.1) Forward propagation of the max color
+				#pragma omp parallel for
+				for(unsigned int index = 0; index < active_list_length; index++)
+				{
+					unsigned int v = active_list[index];
+					worklist[index] = v;
+					if(v != -1U)
+					{
+						color[v] = v;
+						queued[v] = 0;
+					}
+				}
+
+				unsigned int color_iters = 0;
+				unsigned long round_edges = __scc_color(pe, csr, scc, color, queued, worklist, active_list_length, next_worklist, list_size,
+					coloring_max_edges - coloring_edges, &color_iters, ttimes);
+
+				// The serial Tarjan is faster than completing the coloring of long chains of SCCs
+				if(round_edges == -1UL)
+				{
+					mt += get_nano_time();
+					coloring_time += mt;
+					if(flags & 1U)
+					{
+						char temp[255];
+						sprintf(temp, "(7) Coloring round %'3u, color iters: %'3u, stopped:", rounds, color_iters);
+						PTIP(temp);
+					}
+					break;
+				}
+				coloring_edges += round_edges;
+
+				// (7.2) Identifying roots
+				#pragma omp parallel for
+				for(unsigned int index = 0; index < active_list_length; index++)
+				{
+					unsigned int v = active_list[index];
+					if(v != -1U && color[v] == v)
+					{
+						marks[v] = 1;
+						worklist[index] = v;
+					}
+					else
+						worklist[index] = -1U;
+				}
+
+				// (7.3) Backward propagation from the roots limited to the same colors
+				__scc_reach(pe, csc, color, scc, marks, worklist, active_list_length, next_worklist, list_size, ttimes);
+
+				#pragma omp parallel for
+				for(unsigned int index = 0; index < active_list_length; index++)
+				{
+					unsigned int v = active_list[index];
+					if(v != -1U && marks[v])
+					{
+						scc[v] = color[v];
+						marks[v] = 0;
+					}
+				}
+
+				unsigned long remaining = 0;
+				unsigned int next_active_list_length = __scc_active_list(pe, csr, scc, active_list, active_list_length, next_active_list, list_size,
+					&remaining, &active_edges);
+				assert(remaining < active);
+
+				unsigned int* temp = active_list;
+				active_list = next_active_list;
+				next_active_list = temp;
+				active_list_length = next_active_list_length;
+
+				mt += get_nano_time();
+				coloring_time += mt;
+				if(flags & 1U)
+				{
+					char temp[255];
+					sprintf(temp, "(7) Coloring round %'3u, color iters: %'3u, assigned: %'lu:", rounds, color_iters, active - remaining);
+					PTIP(temp);
+				}
+				unsigned long round_assigned = active - remaining;
+				active = remaining;
+				rounds++;
+
+				// Coloring is not effective for long chains of SCCs
+				if(round_assigned < active / LL_SCC_MIN_ROUND_RATIO)
+					break;
+			}
+
+			numa_free(worklist, sizeof(unsigned int) * list_size);
+			worklist = NULL;
+			numa_free(next_worklist, sizeof(unsigned int) * list_size);
+			next_worklist = NULL;
+			numa_free(queued, sizeof(unsigned int) * vc);
+			queued = NULL;
+			numa_free(marks, sizeof(unsigned char) * vc);
+			marks = NULL;
+		}
+
+		numa_free(active_list, sizeof(unsigned int) * list_size);
+		active_list = NULL;
+		numa_free(next_active_list, sizeof(unsigned int) * list_size);
+		next_active_list = NULL;
+
+	// (8) Serial Tarjan for the remaining vertices
+		mt = - get_nano_time();
+		unsigned long serial_vertices = active;
+		if(active)
+			__scc_tarjan(csr, scc);
+		mt += get_nano_time();
+		unsigned long serial_time = mt;
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "(8) Serial Tarjan, vertices: %'lu:", serial_vertices);
+			PT(temp);
+		}
+
+	// (9) Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// (10) Counting SCCs
+		unsigned int sccs = 0;
+		#pragma omp parallel for reduction(+:sccs)
+		for(unsigned int v = 0; v < vc; v++)
+			if(scc[v] == v)
+				sccs++;
+
+	// (11) Finalizing
+		t0 += get_nano_time();
+		printf("|SCCs|:           \t\t%'u\n", sccs);
+		if(flags & 1U)
+			printf("Trimmed vertices: \t\t%'lu\nPivot SCC:        \t\t%'lu\nColoring rounds:  \t\t%'u\nSerial vertices:  \t\t%'lu\n", trimmed, pivot_scc_size, rounds, serial_vertices);
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = sccs;
+			exec_info[9] = trimmed;
+			exec_info[10] = pivot;
+			exec_info[11] = pivot_scc_size;
+			exec_info[12] = rounds;
+			exec_info[13] = trim_time;
+			exec_info[14] = fb_time;
+			exec_info[15] = coloring_time;
+			exec_info[16] = serial_vertices;
+			exec_info[17] = serial_time;
+		}
+		if(sccs_p)
+			*sccs_p = sccs;
+
+	// (12) Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+		numa_free(color, sizeof(unsigned int) * vc);
+		color = NULL;
+
+	return scc;
+}
+
+/*
+	Serial Tarjan's SCC, used for validation.
+	Returns the array of SCC labels, i.e., the ID of the root of each SCC.
+*/
+unsigned int* scc_tarjan_serial(struct ll_400_graph* g)
+{
+	assert(g != NULL);
+
+	unsigned int* scc = numa_alloc_interleaved(sizeof(unsigned int) * g->vertices_count);
+	assert(scc != NULL);
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+		scc[v] = LL_SCC_UNASSIGNED;
+
+	__scc_tarjan(g, scc);
+
+	return scc;
+}
+
+/*
+	Validates the SCC labels against `scc_tarjan_serial()`:
+		(1) the label of each vertex is a vertex of the same SCC whose label is itself,
+		(2) the number of SCCs is the same.
+	As the labels are vertices of their SCCs, vertices of different SCCs have different labels and (2) guarantees
+	that each SCC has one label.
+
+	Returns 1 if the labels are valid.
+*/
+int scc_validate(struct par_env* pe, struct ll_400_graph* g, unsigned int* scc, unsigned int sccs)
+{
+	assert(pe != NULL && g != NULL && scc != NULL);
+
+	unsigned long t0 = - get_nano_time();
+	unsigned int* scc_t = scc_tarjan_serial(g);
+	t0 += get_nano_time();
+	printf("Serial Tarjan:    \t\t %'.1f (ms)\n", t0/1e6);
+
+	unsigned long errors = 0;
+	unsigned int sccs_t = 0;
+	#pragma omp parallel for reduction(+:errors, sccs_t)
+	for(unsigned int v = 0; v < g->vertices_count; v++)
+	{
+		if(scc_t[v] == v)
+			sccs_t++;
+		if(scc[v] >= g->vertices_count || scc_t[scc[v]] != scc_t[v] || scc[scc[v]] != scc[v])
+			errors++;
+	}
+	if(sccs_t != sccs)
+		errors++;
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors, |SCCs|: %'u, Tarjan |SCCs|: %'u\n", errors, sccs, sccs_t);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	numa_free(scc_t, sizeof(unsigned int) * g->vertices_count);
+	scc_t = NULL;
+
+	return errors == 0;
+}
+
+void scc_release(struct ll_400_graph* g, unsigned int* scc)
+{
+	assert(g != NULL && scc != NULL);
+
+	numa_free(scc, sizeof(unsigned int) * g->vertices_count);
+	scc = NULL;
+
+	return;
+}
+
+#endif
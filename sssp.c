@@ -0,0 +1,491 @@
+#ifndef __SSSP_C
+#define __SSSP_C
+
+// This file contains the implementation of the Single-Source Shortest Paths algorithms
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+
+/*
+	Delta-Stepping SSSP
+
+	https://doi.org/10.1016/S0196-6774(03)00076-2
+
+	Vertices are placed in buckets of width `delta` based on their tentative distances. Buckets are processed
+	in ascending order and for each bucket:
+		- Light phase: light edges (weight < delta) of the vertices of the bucket are relaxed, repeatedly,
+		  until no vertex is added to the bucket.
+		- Heavy phase: heavy edges (weight >= delta) of the vertices settled in the bucket are relaxed once.
+
+	Each thread has its own array of buckets (`struct sssp_bin`s) and adds the vertices whose distances are
+	reduced by that thread to them, so no synchronization is required for insertion. At the start of each
+	round, the bins of the current bucket of all threads are gathered in the shared frontier, which is
+	divided into partitions and processed using dynamic partitioning. A vertex may be inserted multiple times,
+	the stale entries are skipped by checking the bucket of their current distances.
+
+	If `delta` is 0, it is selected as `max_weight / average_degree` [Meyer and Sanders].
+
+	g:
+		Each edge has two unsigned int elements in the edges_list: [dest, weight].
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: delta
+		[9]: number of processed buckets
+		[10]: number of rounds (light phases + heavy phases)
+		[11]: number of reached vertices
+		[12]: number of relaxations that reduced a distance
+
+	Returns the array of distances, with -1UL for unreachable vertices
+*/
+
+struct sssp_bin
+{
+	unsigned int* list;
+	unsigned long size;
+	unsigned long capacity;
+};
+
+struct sssp_thread_bins
+{
+	struct sssp_bin* bins;
+	unsigned long bins_count;
+	unsigned long settled_size;
+	unsigned long settled_capacity;
+	unsigned int* settled;
+};
+
+static inline void __sssp_bin_add(struct sssp_thread_bins* tb, unsigned long bucket, unsigned int v)
+{
+	if(bucket >= tb->bins_count)
+	{
+		unsigned long new_count = max(2 * tb->bins_count, bucket + 1);
+		tb->bins = realloc(tb->bins, sizeof(struct sssp_bin) * new_count);
+		assert(tb->bins != NULL);
+		memset(tb->bins + tb->bins_count, 0, sizeof(struct sssp_bin) * (new_count - tb->bins_count));
+		tb->bins_count = new_count;
+	}
+
+	struct sssp_bin* bin = &tb->bins[bucket];
+	if(bin->size == bin->capacity)
+	{
+		bin->capacity = max(64, 2 * bin->capacity);
+		bin->list = realloc(bin->list, sizeof(unsigned int) * bin->capacity);
+		assert(bin->list != NULL);
+	}
+	bin->list[bin->size++] = v;
+
+	return;
+}
+
+static inline void __sssp_settled_add(struct sssp_thread_bins* tb, unsigned int v)
+{
+	if(tb->settled_size == tb->settled_capacity)
+	{
+		tb->settled_capacity = max(1024, 2 * tb->settled_capacity);
+		tb->settled = realloc(tb->settled, sizeof(unsigned int) * tb->settled_capacity);
+		assert(tb->settled != NULL);
+	}
+	tb->settled[tb->settled_size++] = v;
+
+	return;
+}
+
+// Reduces `dist[u]` to `new_dist` and returns 1 if it has been reduced
+static inline int __sssp_relax(unsigned long* dist, unsigned int u, unsigned long new_dist)
+{
+	unsigned long old_dist = dist[u];
+	while(new_dist < old_dist)
+	{
+		if(__atomic_compare_exchange_n(&dist[u], &old_dist, new_dist, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+			return 1;
+	}
+
+	return 0;
+}
+
+unsigned long* sssp_delta_stepping(struct par_env* pe, struct ll_404_graph* g, unsigned int source, unsigned int delta, unsigned int flags, unsigned long* exec_info)
+{
+	// Initial checks
+		assert(pe != NULL && g != NULL && source < g->vertices_count);
+		unsigned long t0 = - get_nano_time();
+
+	// Selecting delta
+		if(delta == 0)
+		{
+			unsigned long max_weight = 1;
+			#pragma omp parallel for reduction(max:max_weight)
+			for(unsigned long e = 0; e < g->edges_count; e++)
+				if(g->edges_list[2 * e + 1] > max_weight)
+					max_weight = g->edges_list[2 * e + 1];
+
+			double average_degree = 1.0 * g->edges_count / g->vertices_count;
+			delta = max(1, max_weight / max(1.0, average_degree));
+		}
+		printf("\n\033[3;31msssp_delta_stepping\033[0;37m, source: %'u, delta: %'u, using \033[3;31m%d\033[0;37m threads.\n",
+			source, delta, pe->threads_count);
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned long* dist = numa_alloc_interleaved(sizeof(unsigned long) * g->vertices_count);
+		assert(dist != NULL);
+		#pragma omp parallel for
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			dist[v] = -1UL;
+
+		struct sssp_thread_bins* tbs = calloc(sizeof(struct sssp_thread_bins), pe->threads_count);
+		unsigned long* threads_offsets = calloc(sizeof(unsigned long), pe->threads_count + 1);
+		unsigned long* light_ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		unsigned long* heavy_ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(tbs != NULL && threads_offsets != NULL && light_ttimes != NULL && heavy_ttimes != NULL);
+
+		unsigned long frontier_capacity = 1024 * 1024;
+		unsigned int* frontier = numa_alloc_interleaved(sizeof(unsigned int) * frontier_capacity);
+		assert(frontier != NULL);
+
+		unsigned int partitions_count = pe->threads_count * 64;
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Initial bucket
+		dist[source] = 0;
+		__sssp_bin_add(&tbs[0], 0, source);
+
+	// Processing buckets
+		unsigned long bucket = 0;
+		unsigned long buckets_count = 0;
+		unsigned long rounds = 0;
+		unsigned long relaxations = 0;
+		unsigned long light_mt = 0;
+		unsigned long heavy_mt = 0;
+		unsigned long mt = - get_nano_time();
+		while(1)
+		{
+			buckets_count++;
+			for(unsigned int t = 0; t < pe->threads_count; t++)
+				tbs[t].settled_size = 0;
+
+			// Light phases
+			while(1)
+			{
+				// Gathering bins of the current bucket into the frontier
+				threads_offsets[0] = 0;
+				for(unsigned int t = 0; t < pe->threads_count; t++)
+				{
+					unsigned long size = 0;
+					if(bucket < tbs[t].bins_count)
+						size = tbs[t].bins[bucket].size;
+					threads_offsets[t + 1] = threads_offsets[t] + size;
+				}
+				unsigned long frontier_size = threads_offsets[pe->threads_count];
+				if(frontier_size == 0)
+					break;
+
+				if(frontier_size > frontier_capacity)
+				{
+					numa_free(frontier, sizeof(unsigned int) * frontier_capacity);
+					frontier_capacity = 2 * frontier_size;
+					frontier = numa_alloc_interleaved(sizeof(unsigned int) * frontier_capacity);
+					assert(frontier != NULL);
+				}
+
+				#pragma omp parallel
+				{
+					unsigned tid = omp_get_thread_num();
+					if(bucket < tbs[tid].bins_count)
+					{
+						struct sssp_bin* bin = &tbs[tid].bins[bucket];
+						memcpy(frontier + threads_offsets[tid], bin->list, sizeof(unsigned int) * bin->size);
+						bin->size = 0;
+					}
+				}
+
+				// Relaxing light edges
+				light_mt -= get_nano_time();
+				#pragma omp parallel reduction(+:relaxations)
+				{
+					unsigned tid = omp_get_thread_num();
+					light_ttimes[tid] -= get_nano_time();
+					struct sssp_thread_bins* tb = &tbs[tid];
+					unsigned int partition = -1U;
+
+					while(1)
+					{
+						partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+						if(partition == -1U)
+							break;
+
+						unsigned long start = (frontier_size * partition) / partitions_count;
+						unsigned long end = (frontier_size * (partition + 1)) / partitions_count;
+						for(unsigned long i = start; i < end; i++)
+						{
+							unsigned int v = frontier[i];
+							unsigned long dv = dist[v];
+							if(dv / delta != bucket)
+								continue;
+
+							__sssp_settled_add(tb, v);
+							for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							{
+								unsigned int w = g->edges_list[2 * e + 1];
+								if(w >= delta)
+									continue;
+
+								unsigned int u = g->edges_list[2 * e];
+								if(__sssp_relax(dist, u, dv + w))
+								{
+									relaxations++;
+									__sssp_bin_add(tb, (dv + w) / delta, u);
+								}
+							}
+						}
+					}
+					light_ttimes[tid] += get_nano_time();
+				}
+				light_mt += get_nano_time();
+				dynamic_partitioning_reset(dp);
+				rounds++;
+			}
+
+			// Heavy phase
+			heavy_mt -= get_nano_time();
+			#pragma omp parallel reduction(+:relaxations)
+			{
+				unsigned tid = omp_get_thread_num();
+				heavy_ttimes[tid] -= get_nano_time();
+				struct sssp_thread_bins* tb = &tbs[tid];
+
+				// The current bucket is settled and no vertex is added to it, so its bin is released
+				if(bucket < tb->bins_count && tb->bins[bucket].list != NULL)
+				{
+					free(tb->bins[bucket].list);
+					tb->bins[bucket].list = NULL;
+					tb->bins[bucket].capacity = 0;
+				}
+
+				for(unsigned long i = 0; i < tb->settled_size; i++)
+				{
+					unsigned int v = tb->settled[i];
+					unsigned long dv = dist[v];
+					for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+					{
+						unsigned int w = g->edges_list[2 * e + 1];
+						if(w < delta)
+							continue;
+
+						unsigned int u = g->edges_list[2 * e];
+						if(__sssp_relax(dist, u, dv + w))
+						{
+							relaxations++;
+							__sssp_bin_add(tb, (dv + w) / delta, u);
+						}
+					}
+				}
+				heavy_ttimes[tid] += get_nano_time();
+			}
+			heavy_mt += get_nano_time();
+			rounds++;
+
+			// Identifying the next non-empty bucket
+			unsigned long next_bucket = -1UL;
+			for(unsigned int t = 0; t < pe->threads_count; t++)
+				for(unsigned long b = bucket + 1; b < tbs[t].bins_count && b < next_bucket; b++)
+					if(tbs[t].bins[b].size)
+					{
+						next_bucket = b;
+						break;
+					}
+			if(next_bucket == -1UL)
+				break;
+			bucket = next_bucket;
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+		{
+			PT("Processing buckets:");
+			printf("%-60s\t\t %'10.2f (ms) \t(%5.2f%%)\n", "  Light phases:", light_mt/1e6, get_idle_percentage(light_mt, light_ttimes, pe->threads_count));
+			printf("%-60s\t\t %'10.2f (ms) \t(%5.2f%%)\n", "  Heavy phases:", heavy_mt/1e6, get_idle_percentage(heavy_mt, heavy_ttimes, pe->threads_count));
+		}
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Finalizing
+		unsigned long reached = 0;
+		#pragma omp parallel for reduction(+:reached)
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			if(dist[v] != -1UL)
+				reached++;
+
+		t0 += get_nano_time();
+		if(flags & 1U)
+		{
+			printf("Buckets: %'lu, Rounds: %'lu, Relaxations: %'lu\n", buckets_count, rounds, relaxations);
+			printf("Reached vertices: \t\t%'lu\n", reached);
+		}
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = delta;
+			exec_info[9] = buckets_count;
+			exec_info[10] = rounds;
+			exec_info[11] = reached;
+			exec_info[12] = relaxations;
+		}
+
+	// Releasing memory
+		for(unsigned int t = 0; t < pe->threads_count; t++)
+		{
+			for(unsigned long b = 0; b < tbs[t].bins_count; b++)
+				if(tbs[t].bins[b].list != NULL)
+					free(tbs[t].bins[b].list);
+			free(tbs[t].bins);
+			if(tbs[t].settled != NULL)
+				free(tbs[t].settled);
+		}
+		free(tbs);
+		tbs = NULL;
+		free(threads_offsets);
+		threads_offsets = NULL;
+		numa_free(frontier, sizeof(unsigned int) * frontier_capacity);
+		frontier = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(light_ttimes);
+		light_ttimes = NULL;
+		free(heavy_ttimes);
+		heavy_ttimes = NULL;
+
+	return dist;
+}
+
+/*
+	Serial Dijkstra using a binary heap with lazy deletion. We use this for validation of results.
+*/
+unsigned long* sssp_dijkstra_serial(struct ll_404_graph* g, unsigned int source)
+{
+	// Initial checks
+		assert(g != NULL && source < g->vertices_count);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;33msssp_dijkstra_serial\033[0;37m\n");
+
+	// Memory allocation
+		unsigned long* dist = numa_alloc_interleaved(sizeof(unsigned long) * g->vertices_count);
+		assert(dist != NULL);
+		for(unsigned int v = 0; v < g->vertices_count; v++)
+			dist[v] = -1UL;
+
+		// Each element of the heap is (distance, vertex)
+		unsigned long heap_capacity = g->edges_count + 1;
+		unsigned long* heap_dist = numa_alloc_interleaved(sizeof(unsigned long) * heap_capacity);
+		unsigned int* heap_vertex = numa_alloc_interleaved(sizeof(unsigned int) * heap_capacity);
+		assert(heap_dist != NULL && heap_vertex != NULL);
+		unsigned long heap_size = 0;
+
+	// Let's go
+		dist[source] = 0;
+		heap_dist[0] = 0;
+		heap_vertex[0] = source;
+		heap_size = 1;
+
+		while(heap_size)
+		{
+			unsigned long dv = heap_dist[0];
+			unsigned int v = heap_vertex[0];
+
+			// Removing the top
+			heap_size--;
+			{
+				unsigned long ld = heap_dist[heap_size];
+				unsigned int lv = heap_vertex[heap_size];
+				unsigned long i = 0;
+				while(1)
+				{
+					unsigned long c = 2 * i + 1;
+					if(c >= heap_size)
+						break;
+					if(c + 1 < heap_size && heap_dist[c + 1] < heap_dist[c])
+						c++;
+					if(heap_dist[c] >= ld)
+						break;
+					heap_dist[i] = heap_dist[c];
+					heap_vertex[i] = heap_vertex[c];
+					i = c;
+				}
+				heap_dist[i] = ld;
+				heap_vertex[i] = lv;
+			}
+
+			if(dv != dist[v])
+				continue;
+
+			for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+			{
+				unsigned int u = g->edges_list[2 * e];
+				unsigned long nd = dv + g->edges_list[2 * e + 1];
+				if(nd >= dist[u])
+					continue;
+				dist[u] = nd;
+
+				// Inserting
+				assert(heap_size < heap_capacity);
+				unsigned long i = heap_size++;
+				while(i > 0 && heap_dist[(i - 1) / 2] > nd)
+				{
+					heap_dist[i] = heap_dist[(i - 1) / 2];
+					heap_vertex[i] = heap_vertex[(i - 1) / 2];
+					i = (i - 1) / 2;
+				}
+				heap_dist[i] = nd;
+				heap_vertex[i] = u;
+			}
+		}
+
+	// Releasing memory
+		numa_free(heap_dist, sizeof(unsigned long) * heap_capacity);
+		heap_dist = NULL;
+		numa_free(heap_vertex, sizeof(unsigned int) * heap_capacity);
+		heap_vertex = NULL;
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Exec. time: \t\t %'.1f (ms) \n", t0 / 1e6);
+
+	return dist;
+}
+
+void sssp_release(struct ll_404_graph* g, unsigned long* dist)
+{
+	assert(g != NULL && dist != NULL);
+
+	numa_free(dist, sizeof(unsigned long) * g->vertices_count);
+	dist = NULL;
+
+	return;
+}
+
+#endif
@@ -19,882 +19,413 @@
 #include "relabel.c"
 #include "energy.c"
 
-void sort_neighbor_lists(struct par_env* pe, struct ll_400_graph* g)
-{
-	assert(pe != NULL && g!= NULL);
-
-	// Allocating mem
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;	
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(g, partitions, partitions_count);
-		
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
-
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-
-	// Sorting
-	unsigned long mt = - get_nano_time();
-	#pragma omp parallel  
-	{
-		unsigned int tid = omp_get_thread_num();
-		ttimes[tid] = - get_nano_time();
-		unsigned int partition = -1U;	
-		while(1)
-		{
-			partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-			if(partition == -1U)
-				break; 
-			for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-			{
-				unsigned int degree = g->offsets_list[v+1] - g->offsets_list[v];
-				if(degree < 2)
-					continue;
-				quick_sort_uint(&g->edges_list[g->offsets_list[v]], 0, degree - 1);
-			}
-		}
-		ttimes[tid] += get_nano_time();
-	}
-	mt += get_nano_time();
-	PTIP("Sorting");
-
-	// Releasing mem
-		free(partitions);
-		partitions = NULL;
-		free(ttimes);
-		ttimes = NULL;
-		dynamic_partitioning_release(dp);
-		dp = NULL;
-
-	return;	
-}
-
 /*
-	Validates the transposition of `g` to `t`
-	returns `1` as true, and `0` as false
-
-	`flags`:
-		bit 0: no self-edges
+	The 4 Bytes (ll_400) and 8 Bytes (ll_800) vertex ID versions of `sort_neighbor_lists()`, 
+	`validate_transposition()`, `symmetrize_graph()`, `atomic_transpose()`, and `symmetrize_graph_merge()` share their 
+	implementation in `trans.tpl.c`.
 */
-int validate_transposition(struct par_env* pe, struct ll_400_graph* g, struct ll_400_graph* t, unsigned int flags)
-{
-	assert(pe != NULL && g != NULL && t != NULL);
-
-	// Allocating mem
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;	
-		unsigned int* g_partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(g_partitions != NULL);
-		parallel_edge_partitioning(g, g_partitions, partitions_count);
-
-		unsigned int* t_partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(t_partitions != NULL);
-		parallel_edge_partitioning(t, t_partitions, partitions_count);
-		
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
-
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-		int ret = 1;
+#define LL_T_GRAPH                         ll_400_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning
+#define LL_T_BINARY_SEARCH                 uint_binary_search
+#define LL_T_QUICK_SORT                    quick_sort_uint
+#define LL_T_PRINT_GRAPH                   print_ll_400_graph
+#define LL_T_STREAM_WAIT_VERTICES          ll_400_stream_wait_vertices
+#define LL_T_SORT_NEIGHBOR_LISTS           sort_neighbor_lists
+#define LL_T_VALIDATE_TRANSPOSITION        validate_transposition
+#define LL_T_SYMMETRIZE_GRAPH              symmetrize_graph
+#define LL_T_ATOMIC_TRANSPOSE              atomic_transpose
+#define LL_T_SYMMETRIZE_GRAPH_MERGE        symmetrize_graph_merge
+#define LL_T_RELEASE_GRAPH                 release_numa_interleaved_ll_400_graph
+#include "trans.tpl.c"
+
+#define LL_T_GRAPH                         ll_800_graph
+#define LL_T_VID                           unsigned long
+#define LL_T_PARALLEL_EDGE_PARTITIONING    parallel_edge_partitioning_800
+#define LL_T_BINARY_SEARCH                 ulong_binary_search
+#define LL_T_QUICK_SORT                    quick_sort_ulong
+#define LL_T_PRINT_GRAPH                   print_ll_800_graph
+#define LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex)
+#define LL_T_SORT_NEIGHBOR_LISTS           sort_neighbor_lists_800
+#define LL_T_VALIDATE_TRANSPOSITION        validate_transposition_800
+#define LL_T_SYMMETRIZE_GRAPH              symmetrize_graph_800
+#define LL_T_ATOMIC_TRANSPOSE              atomic_transpose_800
+#define LL_T_SYMMETRIZE_GRAPH_MERGE        symmetrize_graph_merge_800
+#define LL_T_RELEASE_GRAPH                 release_numa_interleaved_ll_800_graph
+#include "trans.tpl.c"
 
-	// Validation
-		// Initial checks
-			assert(t->vertices_count == g->vertices_count);
-			assert(t->offsets_list[0] == 0);
-			assert(t->offsets_list[t->vertices_count] == t->edges_count);
-			assert(t->edges_count <= g->edges_count);
-
-		// Check if `g` is sorted
-			unsigned long mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned long thread_se = 0;
-				unsigned int partition = -1U;
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = g_partitions[partition]; v < g_partitions[partition + 1]; v++)		
-						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
-							if(e < (g->offsets_list[v + 1] - 1))
-								if(g->edges_list[e] >= g->edges_list[e + 1])
-								{
-									printf("v:%'u,  deg:%'lu,  eo:%'lu,  neighbour: %'u,  next-neighbour: %'u\n", v, g->offsets_list[v+1] - g->offsets_list[v], e, g->edges_list[e], g->edges_list[e+1]);
-									assert(g->edges_list[e] < g->edges_list[e + 1] && "The input graph does not have sorted neighbour-lists");
-									ret = 0;
-								}
-				}
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("Validation 1, check input is sorted");
-			if(!ret)
-				goto validate_transposition_rel_mem;
-
-		// If an edge is in `t` it should be in `g`
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = t_partitions[partition]; v < t_partitions[partition + 1]; v++)
-					{
-						assert(t->offsets_list[v+1] >= t->offsets_list[v]);
-						for(unsigned long e = t->offsets_list[v]; e < t->offsets_list[v + 1]; e++)
-						{
-							unsigned int dest = v;
-							unsigned int src = t->edges_list[e];
-
-							if((flags & 1U) && src == dest)
-							{
-								printf("Validation 1 error: src == dest %'u->%'u\n", src, dest);
-								assert(dest != src);
-								ret = 0;
-							}
-
-							unsigned long found = uint_binary_search(g->edges_list, g->offsets_list[src], g->offsets_list[src + 1], dest);
-							if(found == -1UL)
-							{
-								printf("Validation 1 error: cannot find %'u->%'u\n", src, dest);
-								assert(found != -1UL);
-								ret = 0;
-							}
-						}					
-					}
-				}
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("Validation 2, output includes all edges of the input");
-			if(!ret)
-				goto validate_transposition_rel_mem;
-
-		// If an edge is in `g` it should be in `t` for both endpoints 
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = g_partitions[partition]; v < g_partitions[partition + 1]; v++)
-						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
-						{
-							unsigned int src = v;
-							unsigned int dest = g->edges_list[e];
+/*
+	blocked_transpose() is a two-pass radix-partitioned (cache-blocked) transposition. 
 
-							if((flags & 1U) && src == dest)
-								continue;
+	The destination vertices are divided into buckets of 2^bucket_bits consecutive vertices. In the first pass, 
+	each thread scatters the (dest, src) pairs of its edges to the per-bucket regions of an intermediate array 
+	through a per-thread buffer of one cache line per bucket. The buffers of all buckets fit in half of the L2 
+	cache of the thread and full cache lines are flushed using non-temporal stores. In the second pass, the 
+	buckets are processed independently and the edges of each bucket are written to the out_graph. As the 
+	offsets of a bucket fit in L2, the random accesses of both passes are limited to the cache.
 
-							unsigned long found = uint_binary_search(t->edges_list, t->offsets_list[dest], t->offsets_list[dest + 1], src);
-							if(found == -1UL)
-							{
-								printf("Validation 2 error: cannot find %'u->%'u\n", src, dest);
-								assert(found != -1UL);
-								ret = 0;
-							}
-						}	
-				}
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("Validation 3, input includes all edges of the output");
+	As each thread processes a contiguous range of source vertices, the pairs of a bucket are ordered by 
+	source and neighbour-lists of the out_graph are created sorted.
 
-	// Releasing mem
-	validate_transposition_rel_mem:
+	It requires an additional 8|E| bytes for the intermediate array.
 
-		free(t_partitions);
-		t_partitions = NULL;
+	flags: 
+		bit 0 : validate results
+		bit 1 : sort neighbour-list of the output (neighbour-lists are always sorted)
+		bit 2 : remove self-edges
+		bit 3 : only create offsets_list of the out_graph and do not write edges
 
-		free(g_partitions);
-		g_partitions = NULL;
-		
-		free(ttimes);
-		ttimes = NULL;
-		
-		dynamic_partitioning_release(dp);
-		dp = NULL;
+	exec_info: the layout of `potra()`, with [38] set to 2 (Blocked) and [33] set to the number of buckets
+*/
+struct ll_400_graph* blocked_transpose(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags, unsigned long* exec_info)
+{
+	#ifdef _ENERGY_MEASUREMENT
+		struct energy_measurement* em = energy_measurement_init();
+		energy_measurement_start(em);
+	#endif
 
-	return ret;	
-}
+	// Initialization
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && in_graph != NULL && in_graph->vertices_count > 0);
+		printf("\n\033[3;35mblocked_transpose\033[0;37m using \033[3;35m%d\033[0;37m threads, flags: %x.\n", pe->threads_count, flags);
 
-/*
-	The input graph should have sorted neighbour-lists as binary search is 
-	used in order to check if a reverse edges exists.
+		// Reset papi
+		#pragma omp parallel 
+		{
+			unsigned tid = omp_get_thread_num();
+			papi_reset(pe->papi_args[tid]);
+		}
 
-	Before increasing symmetric degree of each vertex in Step 2, we search to see 
-	if that edge exists in the neighbour-list of the destination.
-	Total comlexity: O(|E|log(|E|/|V|)), assuming degree of each vertex is |E|/|V|.
+	// Constants
+		const unsigned long cache_line_pairs = 64 / sizeof(unsigned long);
+		unsigned long thread_L2_size = pe->L2_caches_total_size / pe->threads_count;
+		if(thread_L2_size == 0)
+			thread_L2_size = 1UL << 20;
+		const unsigned long max_buckets = max(1UL, thread_L2_size / 2 / 64);
+		unsigned int bucket_bits = 0;
+		while((1UL << (bucket_bits + 1)) * sizeof(unsigned long) <= thread_L2_size / 2)
+			bucket_bits++;
+		while(((in_graph->vertices_count - 1) >> bucket_bits) + 1 > max_buckets)
+			bucket_bits++;
+		const unsigned int buckets_count = ((in_graph->vertices_count - 1) >> bucket_bits) + 1;
 
-	We assign a bit for each edge to specify if this edge is symmetric or not. 
-	Using this bit array we do not repeat the search in Step 5.
-	
-	A faster version can rewrite all edges without searching for repeated edges 
-	(i.e., we need dynamic memory for neighbour lists of each vertex), 
-	but then after sorting we can remove repeated edges and rewrite the offsets list and filtered edges list.
-	This requires more memory, but is faster. 
-	Total complexity of this version will be: O((|E|/|V|)*log(|E|/|V|)).
-
-	Another solution is to create the csc graph from csr (2|E| + |E|log(|E|/V|)), 
-	and then creating symmetric graph from csc and csr. While the approximate complexity is the same as the first one,
-	this solution is faster as in the first solution we search out-neighbour list of each out-neighbour, 
-	but in the third solution, we sort in-neighbours of each vertex. Moreover, when we want to sort the output, 
-	sorting the symmetric graph is more prone to load imbalance than the csc graph.
+		printf("\n");
+		printf("Constants: \n");
+		printf("  L2 per thread:             %'lu KB\n", thread_L2_size / 1024);
+		printf("  Max. buckets:              %'lu\n", max_buckets);
+		printf("  Vertices per bucket:       %'lu\n", 1UL << bucket_bits);
+		printf("  Buckets:                   %'u\n", buckets_count);
+		printf("  Buffer per thread:         %'lu KB\n", buckets_count * 64UL / 1024);
+		printf("\n");
 
-	flags: 
-	bit 0 : validate results
-	bit 1 : sort neighbour-list of the output  
-	bit 2 : remove self-edges
-*/
-struct ll_400_graph* symmetrize_graph(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags)
-{
-	// Initial checks
-		unsigned long tt = - get_nano_time();
-		assert(pe != NULL && in_graph != NULL);
-		printf("\n\033[3;35msymmetrize_graph\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
-		unsigned long free_mem = get_free_mem();
-		if(free_mem < in_graph->edges_count * sizeof(unsigned int) + in_graph->vertices_count * sizeof(unsigned long))
+		if(exec_info)
 		{
-			printf("Not enough memory.\n");
-			return NULL;
+			exec_info[33] = buckets_count;
+			exec_info[38] = 2;
 		}
-		
-	// Partitioning
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
+
+	// Partitioning: one contiguous range of source vertices per thread
+		unsigned int* partitions = calloc(sizeof(unsigned int), pe->threads_count + 1);
 		assert(partitions != NULL);
-		parallel_edge_partitioning(in_graph, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+		parallel_edge_partitioning(in_graph, partitions, pe->threads_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, buckets_count);
 
 	// Allocating memory
-		struct ll_400_graph* out_graph =calloc(sizeof(struct ll_400_graph),1);
+		struct ll_400_graph* out_graph = calloc(sizeof(struct ll_400_graph),1);
 		assert(out_graph != NULL);
 		out_graph->vertices_count = in_graph->vertices_count;
 		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
 		assert(out_graph->offsets_list != NULL);
 
-		unsigned long* last_offsets = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
-		assert(last_offsets != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
 
-		unsigned char* edge_is_symmetric = numa_alloc_interleaved(sizeof(unsigned char) * ( 1 + in_graph->edges_count / 8));
-		assert(edge_is_symmetric != NULL);
+		// threads_buckets[tid * buckets_count + b]: number of pairs of thread tid in bucket b, and then, its write offset
+		unsigned long* threads_buckets = numa_alloc_interleaved(sizeof(unsigned long) * pe->threads_count * buckets_count);
+		assert(threads_buckets != NULL);
 
-		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
-		assert(partitions_total_edges != NULL);
+		unsigned long* buckets_offsets = calloc(sizeof(unsigned long), buckets_count + 1);
+		assert(buckets_offsets != NULL);
 
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
+		unsigned long* pairs = NULL;
 
-	// (1) Checking if neighbour-lists are sorted and decrease degree for self-edges	
-		unsigned long mt = - get_nano_time();
+	// (1) Counting pairs of each bucket
 		unsigned long self_edges = 0;
-		#pragma omp parallel  reduction(+:self_edges)
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;
-			while(1)
+			unsigned long mt = - get_nano_time();
+			exec_info && (exec_info[10] = mt);
+			#pragma omp parallel reduction(+:self_edges)
 			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)		
-				{
-					long degree = in_graph->offsets_list[v+1] - in_graph->offsets_list[v];
-					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
-					{
-						if(flags & 4U)  // remove self edges
-							if(in_graph->edges_list[e] == v)
-							{
-								self_edges++;
-								degree--;
-							}
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
 
-						if(e < (in_graph->offsets_list[v + 1] - 1))
-							if(in_graph->edges_list[e] >= in_graph->edges_list[e + 1])
-							{
-								printf("v:%u deg:%lu eo:%lu neighbour:%u neighbour+1:%u\n", v, in_graph->offsets_list[v+1] - in_graph->offsets_list[v], e, in_graph->edges_list[e], in_graph->edges_list[e+1]);
-								assert(in_graph->edges_list[e] < in_graph->edges_list[e + 1] && "The input graph does not have sorted neighbour-lists");
-							}
-					}
-					assert(degree >= 0);
-					out_graph->offsets_list[v] = degree;
-				}
-			}
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("1: Check");
-		printf("%-20s \t\t\t %'10lu\n","Self edges:", self_edges);
-
-	// (2) Identifying degree of vertices in the symmetric graph
-		mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				unsigned long* counts = threads_buckets + (unsigned long)tid * buckets_count;
+				for(unsigned int b = 0; b < buckets_count; b++)
+					counts[b] = 0;
+
+				ll_400_stream_wait_vertices(in_graph, partitions[tid], partitions[tid + 1]);
+				
+				for(unsigned int v = partitions[tid]; v < partitions[tid + 1]; v++)
 					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
 					{
 						unsigned int dest = in_graph->edges_list[e];
 						
-						// self-edges are already in in_graph (if they should exist), so we do not add them again 
 						if(dest == v)
-							continue;
-
-						// Check if the edge exists in the neighbour-list of the dest 
-						if(uint_binary_search(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], v) != -1UL)
 						{
-							// setting the bit in the edge_is_symmetric to prevent being searched again in Step 5
-							unsigned char val = (((unsigned char)1)<<(e % 8));
-							unsigned char val2 = __atomic_fetch_or(&edge_is_symmetric[e / 8], val, __ATOMIC_RELAXED);
-							assert((val2 & val) == 0);
-							continue;
+							self_edges++;
+							if(flags & 4U)  // remove self edges
+								continue;
 						}
 
-						// Increment the degree of dest
-						__atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
+						counts[dest >> bucket_bits]++;
 					}
+
+				ttimes[tid] += get_nano_time();
 			}
-			ttimes[tid] += get_nano_time();
+			mt += get_nano_time();
+			exec_info && (exec_info[10] += get_nano_time());
+			PTIP("(1) Counting pairs of buckets");
+			printf("%-20s \t\t\t %'10lu\n","  Self edges:", self_edges);
 		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("2: Degree");
-		
-	// (3) Storing the total edges of each partition in partitions_total_edges
-		mt = - get_nano_time();
-		#pragma omp parallel  
+
+	// (2) Identifying offsets of buckets and threads in the intermediate array
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			#pragma omp for nowait 
-			for(unsigned int p = 0; p<partitions_count; p++)
+			unsigned long mt = - get_nano_time();
+			exec_info && (exec_info[11] = mt);
+
+			#pragma omp parallel for
+			for(unsigned int b = 0; b < buckets_count; b++)
 			{
 				unsigned long sum = 0;
-				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
-					sum += out_graph->offsets_list[v];
-				partitions_total_edges[p] = sum;
+				for(unsigned int t = 0; t < pe->threads_count; t++)
+					sum += threads_buckets[(unsigned long)t * buckets_count + b];
+				buckets_offsets[b] = sum;
 			}
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		PTIP("3: Sum");
-	
-	// Partial sum of partitions_total_edges
-		{
+
 			unsigned long sum = 0;
-			for(unsigned int p = 0; p < partitions_count; p++)
+			for(unsigned int b = 0; b < buckets_count; b++)
 			{
-				unsigned long temp = partitions_total_edges[p];
-				partitions_total_edges[p] = sum;
+				unsigned long temp = buckets_offsets[b];
+				buckets_offsets[b] = sum;
 				sum += temp;
 			}
+			buckets_offsets[buckets_count] = sum;
 			out_graph->edges_count = sum;
-			printf("%-20s \t\t\t %'10lu\n","Symmetric edges:", out_graph->edges_count);
-		}
-		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
-		out_graph->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * out_graph->edges_count);
-		assert(out_graph->edges_list != NULL);
+			out_graph->offsets_list[out_graph->vertices_count] = sum;
+			printf("%-20s \t\t\t %'10lu\n","  out_graph edges:", out_graph->edges_count);
 
-	// (4) Updating the last_offsets and out_graph->offsets_list and copying in_graph edges of each vertex
-		mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			while(1)
+			#pragma omp parallel for
+			for(unsigned int b = 0; b < buckets_count; b++)
 			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				unsigned long current_offset = partitions_total_edges[partition];
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				unsigned long offset = buckets_offsets[b];
+				for(unsigned int t = 0; t < pe->threads_count; t++)
 				{
-					unsigned long sym_degree = out_graph->offsets_list[v];
-					out_graph->offsets_list[v] = current_offset;
-					unsigned long last_offset = current_offset;
-					current_offset += sym_degree;
-
-					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v+1]; e++)
-					{
-						unsigned int neighbour = in_graph->edges_list[e];
-						if( (flags & 4U) && neighbour == v)
-							continue;
-						out_graph->edges_list[last_offset++] = neighbour;
-					}
-					
-					last_offsets[v] = last_offset;
-					assert(last_offset <= current_offset);
+					unsigned long temp = threads_buckets[(unsigned long)t * buckets_count + b];
+					threads_buckets[(unsigned long)t * buckets_count + b] = offset;
+					offset += temp;
 				}
-
-				if(partition + 1 < partitions_count)
-					assert(current_offset == partitions_total_edges[partition + 1]);
+				assert(offset == buckets_offsets[b + 1]);
 			}
-			ttimes[tid] += get_nano_time();
+
+			pairs = numa_alloc_interleaved(sizeof(unsigned long) * (1 + out_graph->edges_count));
+			assert(pairs != NULL);
+
+			mt += get_nano_time();
+			exec_info && (exec_info[11] += get_nano_time());
+			PT("(2) Identifying offsets of buckets");
 		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("4: last_offsets");	
 
-	// (5) Writing edges
-		mt = - get_nano_time();
-		#pragma omp parallel  
+	// (3) Scattering pairs to buckets
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;
-				
-			while(1)
+			unsigned long mt = - get_nano_time();
+			exec_info && (exec_info[12] = mt);
+			#pragma omp parallel 
 			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
+				unsigned int tid = omp_get_thread_num();
+				unsigned int node_id = pe->thread2node[tid];
+				ttimes[tid] = - get_nano_time();
 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				unsigned long* offsets = threads_buckets + (unsigned long)tid * buckets_count;
+				unsigned long* buffers = numa_alloc_onnode(sizeof(unsigned long) * cache_line_pairs * buckets_count, node_id);
+				assert(buffers != NULL);
+				unsigned char* fills = calloc(sizeof(unsigned char), buckets_count);
+				assert(fills != NULL);
+				
+				for(unsigned int v = partitions[tid]; v < partitions[tid + 1]; v++)
 					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
 					{
-						unsigned int src = v;
 						unsigned int dest = in_graph->edges_list[e];
+						if(dest == v)
+							if(flags & 4U)  // remove self edges
+								continue;
 
-						// do not duplicate self edges
-						if(src == dest)
-							continue;
-
-						if(edge_is_symmetric[e / 8] & ( ((unsigned char)1) << (e % 8) ) )
-						// if(uint_binary_search(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], src) != -1UL) 
-							continue;
+						unsigned int b = dest >> bucket_bits;
+						unsigned long* buffer = buffers + cache_line_pairs * b;
+						buffer[fills[b]++] = ((unsigned long)dest << 32) | v;
 
-						unsigned long prev_offset = __atomic_fetch_add(&last_offsets[dest], 1UL, __ATOMIC_RELAXED);
-						assert(prev_offset < out_graph->offsets_list[dest+1]);
-						out_graph->edges_list[prev_offset] = src;
+						// Flushing when the buffer reaches the next cache line boundary of the intermediate array
+						if(fills[b] == cache_line_pairs - (offsets[b] & (cache_line_pairs - 1)))
+						{
+							unsigned long o = offsets[b];
+							for(unsigned int i = 0; i < fills[b]; i++)
+								_mm_stream_si64((long long*)(pairs + o + i), buffer[i]);
+							offsets[b] += fills[b];
+							fills[b] = 0;
+						}
 					}
-			}
-
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("5: Writing edges");
 
-	// Sorting
-		if((flags & 2U))
-		{	
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;	
-				
-				#pragma omp for nowait schedule(static, 16)
-				for(unsigned int v = 0; v < out_graph->vertices_count; v++)
+				for(unsigned int b = 0; b < buckets_count; b++)
 				{
-					unsigned int degree = out_graph->offsets_list[v+1] - out_graph->offsets_list[v];
-					if(degree < 2)
-						continue;
-					quick_sort_uint(&out_graph->edges_list[out_graph->offsets_list[v]], 0, degree - 1);
+					unsigned long* buffer = buffers + cache_line_pairs * b;
+					for(unsigned int i = 0; i < fills[b]; i++)
+						pairs[offsets[b] + i] = buffer[i];
+					offsets[b] += fills[b];
 				}
-				
+				_mm_sfence();
+
+				numa_free(buffers, sizeof(unsigned long) * cache_line_pairs * buckets_count);
+				buffers = NULL;
+				free(fills);
+				fills = NULL;
+
 				ttimes[tid] += get_nano_time();
 			}
 			mt += get_nano_time();
-
-			PTIP("Sorting");
+			PTIP("  (3.1) Scattering pairs");
 		}
 
-	// Validation
-		if((flags & 1U))
-		{	
-			assert(out_graph->vertices_count == in_graph->vertices_count);
-			assert(out_graph->offsets_list[0] == 0);
-			assert(out_graph->offsets_list[out_graph->vertices_count] == out_graph->edges_count);
-
-			// If an edge is in out_graph it should be in in_graph 
-			mt = - get_nano_time();
+		if(!(flags & 8U))
+		{
+			out_graph->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * out_graph->edges_count);
+			assert(out_graph->edges_list != NULL);
+		}
+			
+	// (3.2) Processing buckets: degrees, offsets, and edges of the destination vertices of each bucket
+		{
+			unsigned long mt = - get_nano_time();
 			#pragma omp parallel  
 			{
 				unsigned int tid = omp_get_thread_num();
 				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;
+				unsigned int b = -1U;		
 				while(1)
 				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
+					b = dynamic_partitioning_get_next_partition(dp, tid, b);
+					if(b == -1U)
 						break; 
-					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					{
-						assert(out_graph->offsets_list[v+1] == last_offsets[v]);
-						assert(out_graph->offsets_list[v+1] >= out_graph->offsets_list[v]);
-						for(unsigned long e = out_graph->offsets_list[v]; e < out_graph->offsets_list[v + 1]; e++)
-						{
-							unsigned int dest = v;
-							unsigned int src = out_graph->edges_list[e];
 
-							if((flags & 4U) && src == dest)
-							{
-								printf("Validation error: src == dest %'u->%'u\n", src, dest);
-								assert(dest != src);
-							}
+					unsigned int start_vertex = b << bucket_bits;
+					unsigned int end_vertex = min(out_graph->vertices_count, (unsigned long)(b + 1) << bucket_bits);
+					unsigned long* offsets_list = out_graph->offsets_list;
 
-							// it can be an edge in the neighbour-list of src						
-							unsigned long found =  uint_binary_search(in_graph->edges_list, in_graph->offsets_list[src], in_graph->offsets_list[src + 1], dest);
-							if(found != -1UL)
-								continue;
+					for(unsigned int v = start_vertex; v < end_vertex; v++)
+						offsets_list[v] = 0;
+					for(unsigned long p = buckets_offsets[b]; p < buckets_offsets[b + 1]; p++)
+						offsets_list[pairs[p] >> 32]++;
 
-							// it can be an edge in the neighbour-list of dest
-							found =  uint_binary_search(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], src);
-							if(found == -1UL)
-							{
-								printf("Validation error: cannot find %'u->%'u\n", src, dest);
-								assert(found != -1UL);
-							}
-						}					
+					unsigned long current_offset = buckets_offsets[b];
+					for(unsigned int v = start_vertex; v < end_vertex; v++)
+					{
+						unsigned long degree = offsets_list[v];
+						offsets_list[v] = current_offset;
+						current_offset += degree;
 					}
-				}
-				ttimes[tid] += get_nano_time();
-			}
-			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("Validation 1");
+					assert(current_offset == buckets_offsets[b + 1]);
 
-			// If an edge is in in_graph it should be in out_graph for both endpoints 
-			assert((flags & 2U) && "Neighbour-list should be sorted for the second evaluation.");
-			mt = - get_nano_time();
-			#pragma omp parallel  
-			{
-				unsigned int tid = omp_get_thread_num();
-				ttimes[tid] = - get_nano_time();
-				unsigned int partition = -1U;
-				while(1)
-				{
-					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-					if(partition == -1U)
-						break; 
-					for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-						for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
-						{
-							unsigned int src = v;
-							unsigned int dest = in_graph->edges_list[e];
-
-							if((flags & 4U) && src == dest)
-								continue;
+					if(flags & 8U)
+						continue;
 
-							unsigned long found = uint_binary_search(out_graph->edges_list, out_graph->offsets_list[src], out_graph->offsets_list[src + 1], dest);
-							assert(found != -1UL);
+					for(unsigned long p = buckets_offsets[b]; p < buckets_offsets[b + 1]; p++)
+						out_graph->edges_list[offsets_list[pairs[p] >> 32]++] = (unsigned int)pairs[p];
 
-							found = uint_binary_search(out_graph->edges_list, out_graph->offsets_list[dest], out_graph->offsets_list[dest + 1], src);
-							assert(found != -1UL);
-						}	
+					current_offset = buckets_offsets[b];
+					for(unsigned int v = start_vertex; v < end_vertex; v++)
+					{
+						unsigned long next_vertex_offset = offsets_list[v];
+						offsets_list[v] = current_offset;
+						current_offset = next_vertex_offset;
+					}
 				}
 				ttimes[tid] += get_nano_time();
 			}
 			mt += get_nano_time();
-			dynamic_partitioning_reset(dp);
-			PTIP("Validation 2");
+			PTIP("  (3.2) Processing buckets");
+			exec_info && (exec_info[12] += get_nano_time());
+			mt = exec_info ? exec_info[12] : mt;
+			PT("(3) Writing edges");
 		}
 
-	// Releasing memory
-		free(partitions);
-		partitions = NULL;
-
-		dynamic_partitioning_release(dp);
-		dp = NULL;
-
-		numa_free(last_offsets, (1 + in_graph->vertices_count) * sizeof(unsigned long));
-		last_offsets = NULL;
-		
-		free(partitions_total_edges);
-		partitions_total_edges = NULL;
-
-		numa_free(edge_is_symmetric, sizeof(unsigned char) * ( 1 + in_graph->edges_count / 8));
-		edge_is_symmetric = NULL;
-
-		free(ttimes);
-		ttimes = NULL;
-
-	// Finalizing
+	// Reading PAPI & energy
 		tt += get_nano_time();
 		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
-		print_ll_400_graph(out_graph);
-
-	return out_graph;
-}
-
-/*
-	atomic_transpose() has two passes over edges to identify degree of vertex and then to write neighbour-lists.
-	Total complexity is 2|E| plus |E|log(|E|/|V|) if neighbour-lists should be sorted.
-
-	flags: 
-		bit 0 : validate results (requires bit 1 to be set)
-		bit 1 : sort neighbour-list of the output  
-		bit 2 : remove self-edges
-		bit 3 : only create offsets_list of the out_graph and do not write edges
-*/
-struct ll_400_graph* atomic_transpose(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags)
-{
-	// Initial checks
-		unsigned long tt = - get_nano_time();
-		assert(pe != NULL && in_graph != NULL);
-		printf("\n\033[3;35matomic_transpose\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
-
-	// Partitioning
-		unsigned int thread_partitions = 64;
-		unsigned int partitions_count = pe->threads_count * thread_partitions;
-		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count+1);
-		assert(partitions != NULL);
-		parallel_edge_partitioning(in_graph, partitions, partitions_count);
-		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
-
-	// Allocating memory
-		struct ll_400_graph* out_graph =calloc(sizeof(struct ll_400_graph),1);
-		assert(out_graph != NULL);
-		out_graph->vertices_count = in_graph->vertices_count;
-		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
-		assert(out_graph->offsets_list != NULL);
-
-		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
-		assert(partitions_total_edges != NULL);
-
-		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
-		assert(ttimes != NULL);
 
-	// (1) Identifying degree of vertices in the out_graph
-		unsigned long self_edges = 0;
-		unsigned long mt = - get_nano_time();
-		#pragma omp parallel  reduction(+:self_edges)
-		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
-					{
-						unsigned int dest = in_graph->edges_list[e];
-						
-						if(dest == v)
-						{
-							self_edges++;
-							if(flags & 4U)  // remove self edges
-								continue;
-						}
-
-						// Increment the degree of dest
-						__atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
-					}
-			}
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("(1) Identifying degrees");
-		printf("%-20s \t\t\t %'10lu\n","Self edges:", self_edges);
-		
-	// (2) Calculating sum of edges of each partition in partitions_total_edges
-		mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			#pragma omp for nowait 
-			for(unsigned int p = 0; p<partitions_count; p++)
-			{
-				unsigned long sum = 0;
-				for(unsigned int v = partitions[p]; v < partitions[p + 1]; v++)
-					sum += out_graph->offsets_list[v];
-				partitions_total_edges[p] = sum;
-			}
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		PTIP("(2) Calculating sum");
-	
-	// Partial sum of partitions_total_edges
+		#pragma omp parallel
 		{
-			unsigned long sum = 0;
-			for(unsigned int p = 0; p < partitions_count; p++)
-			{
-				unsigned long temp = partitions_total_edges[p];
-				partitions_total_edges[p] = sum;
-				sum += temp;
-			}
-			out_graph->edges_count = sum;
-			printf("%-20s \t\t\t %'10lu\n","out_graph edges:", out_graph->edges_count);
+			assert(0 == thread_papi_read(pe));
 		}
-		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
-
-	// (3) Updating the out_graph->offsets_list
-		mt = - get_nano_time();
-		#pragma omp parallel  
+		print_hw_events(pe, 1);
+		if(exec_info)
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				unsigned long current_offset = partitions_total_edges[partition];
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-				{
-					unsigned long t_degree = out_graph->offsets_list[v];
-					out_graph->offsets_list[v] = current_offset;
-					current_offset += t_degree;
-				}
-
-				if(partition + 1 < partitions_count)
-					assert(current_offset == partitions_total_edges[partition + 1]);
-				else
-					assert(current_offset == out_graph->edges_count);
-			}
-			ttimes[tid] += get_nano_time();
+			exec_info[0] = tt;
+			copy_reset_hw_events(pe, &exec_info[1], 1);
 		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("(3) Update offsets_list");
-
-	if(flags & 8U)
-		goto atomic_transpose_release;
 
-	out_graph->edges_list = numa_alloc_interleaved(sizeof(unsigned int) * out_graph->edges_count);
-	assert(out_graph->edges_list != NULL);
-		
-	// (4) Writing edges
-		mt = - get_nano_time();
-		#pragma omp parallel  
+		#ifdef _ENERGY_MEASUREMENT
 		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;
-				
-			while(1)
+			struct energy_counters_vals* evals = energy_measurement_stop(em);
+			printf("Energy consumption:\n");
+			printf("  Packages energy : %'.2f (J)\n", evals->packages_total/1e6);
+			printf("  DRAM energy     : %'.2f (J)\n", evals->drams_total/1e6);
+			printf("  Total energy    : %'.2f (J)\n", (evals->packages_total + evals->drams_total)/1e6);
+			if(exec_info)
 			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
-					{
-						unsigned int src = v;
-						unsigned int dest = in_graph->edges_list[e];
-
-						if(src == dest)
-							if(flags & 4U)  // remove self edges
-								continue;
-
-						unsigned long prev_offset = __atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
-						assert(prev_offset < out_graph->offsets_list[dest+1]);
-						out_graph->edges_list[prev_offset] = src;
-					}
+				exec_info[18] = evals->packages_total / 1e6;
+				exec_info[19] = evals->drams_total / 1e6;
 			}
-			ttimes[tid] += get_nano_time();
-		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("(4) Writing edges");
 
-	// (5) Updating the out_graph->offsets_list
-		mt = - get_nano_time();
-		#pragma omp parallel  
-		{
-			unsigned int tid = omp_get_thread_num();
-			ttimes[tid] = - get_nano_time();
-			unsigned int partition = -1U;		
-			while(1)
-			{
-				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
-				if(partition == -1U)
-					break; 
-				unsigned long current_offset = partitions_total_edges[partition];
-				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
-				{
-					unsigned long next_vertex_offset = out_graph->offsets_list[v];
-					out_graph->offsets_list[v] = current_offset;
-					current_offset = next_vertex_offset;
-				}
-
-				if(partition + 1 < partitions_count)
-					assert(current_offset == partitions_total_edges[partition + 1]);
-				else
-					assert(current_offset == out_graph->edges_count);
-			}
-			ttimes[tid] += get_nano_time();
+			evals = NULL;
+			energy_measurement_release(em);
+			em = NULL;
 		}
-		mt += get_nano_time();
-		dynamic_partitioning_reset(dp);
-		PTIP("(5) Updating offsets_list");	
+		#endif
 
-	// (6) Sorting
-		if(flags & (2U | 1U))
-			sort_neighbor_lists(pe, out_graph);
-			
 	// Validation
-		if((flags & 1U))
+		if((flags & 9U) == 1U)
 		{	
-			assert(flags & 2U);
-			
-			unsigned int tf = 0;
-			if(flags & 4U)
-				tf = 1U;
-			int ret = validate_transposition(pe, in_graph, out_graph, tf);
+			unsigned long mt = - get_nano_time();
+			int ret = validate_transposition(pe, in_graph, out_graph, (flags & 4U) ? 1U : 0);
 			if(ret != 1)
 			{
 				printf("  Validation failed.\n");	
 				assert(ret == 1);
 			}
+
+			mt += get_nano_time();
+			exec_info && (exec_info[14] = mt);
+			PT("Validation");
 		}
 
 	// Releasing memory
-	atomic_transpose_release: 
-
 		free(partitions);
 		partitions = NULL;
 
 		dynamic_partitioning_release(dp);
 		dp = NULL;
 
-		free(partitions_total_edges);
-		partitions_total_edges = NULL;
-
 		free(ttimes);
 		ttimes = NULL;
 
+		numa_free(threads_buckets, sizeof(unsigned long) * pe->threads_count * buckets_count);
+		threads_buckets = NULL;
+
+		free(buckets_offsets);
+		buckets_offsets = NULL;
+
+		numa_free(pairs, sizeof(unsigned long) * (1 + out_graph->edges_count));
+		pairs = NULL;
+
 	// Finalizing
-		tt += get_nano_time();
-		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		printf("\nTransposed graph:");
 		print_ll_400_graph(out_graph);
 		
 	return out_graph;
@@ -922,6 +453,7 @@ struct ll_400_graph* atomic_transpose(struct par_env* pe, struct ll_400_graph* i
 			bit 3: only create offsets_list of the out_graph and do not write edges
 			bit 4: force HLH
 			bit 5: force Atomic
+			bit 6: force Blocked, the radix-partitioned transposition of `blocked_transpose()` (pm = 2)
 
 		exec_info: an array of 40
 			[0] : total exec. time without sorting and validation
@@ -959,7 +491,7 @@ struct ll_400_graph* atomic_transpose(struct par_env* pe, struct ll_400_graph* i
 				35: Edges of k-top vertices
 				36: cache_bytes_per_HDV
 				37: MSP speedup
-				38: MSP result > 0 HLH(Hash-based LDV/HDV), <0 => Atomic
+				38: MSP result 1: HLH(Hash-based LDV/HDV), -1: Atomic, 2: Blocked
 				39: ---
 
 	Questions/Problems/Future Improvements:
@@ -972,6 +504,10 @@ struct ll_400_graph* atomic_transpose(struct par_env* pe, struct ll_400_graph* i
 
 struct ll_400_graph* potra(struct par_env* pe, struct ll_400_graph* in_graph, unsigned int flags, unsigned long* exec_info)
 {
+	// Blocked method is processed separately as it does not share the steps of HLH and Atomic
+	if(flags & (1U << 6))
+		return blocked_transpose(pe, in_graph, flags, exec_info);
+
 	#ifdef _ENERGY_MEASUREMENT
 		struct energy_measurement* em = energy_measurement_init();
 		energy_measurement_start(em);
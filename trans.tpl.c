@@ -0,0 +1,1185 @@
+/*
+	Template of the transposition and symmetrization functions for graphs with 4 Bytes and 8 Bytes vertex IDs.
+	This file is included by `trans.c` once per vertex ID type with the following macros defined:
+		`LL_T_GRAPH`: struct name of the graph, e.g., `ll_400_graph`
+		`LL_T_VID`: type of vertex IDs, e.g., `unsigned int`
+		`LL_T_PARALLEL_EDGE_PARTITIONING`, `LL_T_BINARY_SEARCH`, `LL_T_QUICK_SORT`, and `LL_T_PRINT_GRAPH`: 
+			the functions used for the vertex ID type
+		`LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex)`: waits for the edges of a streamed graph to be loaded
+		`LL_T_RELEASE_GRAPH`: the function releasing a graph allocated by `LL_T_ATOMIC_TRANSPOSE`
+		`LL_T_SORT_NEIGHBOR_LISTS`, `LL_T_VALIDATE_TRANSPOSITION`, `LL_T_SYMMETRIZE_GRAPH`, `LL_T_ATOMIC_TRANSPOSE`, 
+		and `LL_T_SYMMETRIZE_GRAPH_MERGE`: names of the functions
+*/
+
+void LL_T_SORT_NEIGHBOR_LISTS(struct par_env* pe, struct LL_T_GRAPH* g)
+{
+	assert(pe != NULL && g!= NULL);
+
+	// Allocating mem
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;	
+		LL_T_VID* partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(g, partitions, partitions_count);
+		
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Sorting
+	unsigned long mt = - get_nano_time();
+	#pragma omp parallel  
+	{
+		unsigned int tid = omp_get_thread_num();
+		ttimes[tid] = - get_nano_time();
+		unsigned int partition = -1U;	
+		while(1)
+		{
+			partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+			if(partition == -1U)
+				break; 
+			for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+			{
+				unsigned long degree = g->offsets_list[v+1] - g->offsets_list[v];
+				if(degree < 2)
+					continue;
+				LL_T_QUICK_SORT(&g->edges_list[g->offsets_list[v]], 0, degree - 1);
+			}
+		}
+		ttimes[tid] += get_nano_time();
+	}
+	mt += get_nano_time();
+	PTIP("Sorting");
+
+	// Releasing mem
+		free(partitions);
+		partitions = NULL;
+		free(ttimes);
+		ttimes = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+	return;	
+}
+
+/*
+	Validates the transposition of `g` to `t`
+	returns `1` as true, and `0` as false
+
+	`flags`:
+		bit 0: no self-edges
+*/
+int LL_T_VALIDATE_TRANSPOSITION(struct par_env* pe, struct LL_T_GRAPH* g, struct LL_T_GRAPH* t, unsigned int flags)
+{
+	assert(pe != NULL && g != NULL && t != NULL);
+
+	// Allocating mem
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;	
+		LL_T_VID* g_partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(g_partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(g, g_partitions, partitions_count);
+
+		LL_T_VID* t_partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(t_partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(t, t_partitions, partitions_count);
+		
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+		int ret = 1;
+
+	// Validation
+		// Initial checks
+			assert(t->vertices_count == g->vertices_count);
+			assert(t->offsets_list[0] == 0);
+			assert(t->offsets_list[t->vertices_count] == t->edges_count);
+			assert(t->edges_count <= g->edges_count);
+
+		// Check if `g` is sorted
+			unsigned long mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned long thread_se = 0;
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = g_partitions[partition]; v < g_partitions[partition + 1]; v++)		
+						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+							if(e < (g->offsets_list[v + 1] - 1))
+								if(g->edges_list[e] >= g->edges_list[e + 1])
+								{
+									printf("v:%'lu,  deg:%'lu,  eo:%'lu,  neighbour: %'lu,  next-neighbour: %'lu\n", (unsigned long)v, g->offsets_list[v+1] - g->offsets_list[v], e, (unsigned long)g->edges_list[e], (unsigned long)g->edges_list[e+1]);
+									assert(g->edges_list[e] < g->edges_list[e + 1] && "The input graph does not have sorted neighbour-lists");
+									ret = 0;
+								}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation 1, check input is sorted");
+			if(!ret)
+				goto validate_transposition_rel_mem;
+
+		// If an edge is in `t` it should be in `g`
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = t_partitions[partition]; v < t_partitions[partition + 1]; v++)
+					{
+						assert(t->offsets_list[v+1] >= t->offsets_list[v]);
+						for(unsigned long e = t->offsets_list[v]; e < t->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID dest = v;
+							LL_T_VID src = t->edges_list[e];
+
+							if((flags & 1U) && src == dest)
+							{
+								printf("Validation 1 error: src == dest %'lu->%'lu\n", (unsigned long)src, (unsigned long)dest);
+								assert(dest != src);
+								ret = 0;
+							}
+
+							unsigned long found = LL_T_BINARY_SEARCH(g->edges_list, g->offsets_list[src], g->offsets_list[src + 1], dest);
+							if(found == -1UL)
+							{
+								printf("Validation 1 error: cannot find %'lu->%'lu\n", (unsigned long)src, (unsigned long)dest);
+								assert(found != -1UL);
+								ret = 0;
+							}
+						}					
+					}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation 2, output includes all edges of the input");
+			if(!ret)
+				goto validate_transposition_rel_mem;
+
+		// If an edge is in `g` it should be in `t` for both endpoints 
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = g_partitions[partition]; v < g_partitions[partition + 1]; v++)
+						for(unsigned long e = g->offsets_list[v]; e < g->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID src = v;
+							LL_T_VID dest = g->edges_list[e];
+
+							if((flags & 1U) && src == dest)
+								continue;
+
+							unsigned long found = LL_T_BINARY_SEARCH(t->edges_list, t->offsets_list[dest], t->offsets_list[dest + 1], src);
+							if(found == -1UL)
+							{
+								printf("Validation 2 error: cannot find %'lu->%'lu\n", (unsigned long)src, (unsigned long)dest);
+								assert(found != -1UL);
+								ret = 0;
+							}
+						}	
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation 3, input includes all edges of the output");
+
+	// Releasing mem
+	validate_transposition_rel_mem:
+
+		free(t_partitions);
+		t_partitions = NULL;
+
+		free(g_partitions);
+		g_partitions = NULL;
+		
+		free(ttimes);
+		ttimes = NULL;
+		
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+	return ret;	
+}
+
+/*
+	The input graph should have sorted neighbour-lists as binary search is 
+	used in order to check if a reverse edges exists.
+
+	Before increasing symmetric degree of each vertex in Step 2, we search to see 
+	if that edge exists in the neighbour-list of the destination.
+	Total comlexity: O(|E|log(|E|/|V|)), assuming degree of each vertex is |E|/|V|.
+
+	We assign a bit for each edge to specify if this edge is symmetric or not. 
+	Using this bit array we do not repeat the search in Step 5.
+	
+	A faster version can rewrite all edges without searching for repeated edges 
+	(i.e., we need dynamic memory for neighbour lists of each vertex), 
+	but then after sorting we can remove repeated edges and rewrite the offsets list and filtered edges list.
+	This requires more memory, but is faster. 
+	Total complexity of this version will be: O((|E|/|V|)*log(|E|/|V|)).
+
+	Another solution is to create the csc graph from csr (2|E| + |E|log(|E|/V|)), 
+	and then creating symmetric graph from csc and csr. While the approximate complexity is the same as the first one,
+	this solution is faster as in the first solution we search out-neighbour list of each out-neighbour, 
+	but in the third solution, we sort in-neighbours of each vertex. Moreover, when we want to sort the output, 
+	sorting the symmetric graph is more prone to load imbalance than the csc graph.
+	This solution is implemented by `symmetrize_graph_merge()` and is used when there is enough memory for the csc graph.
+	Otherwise, or if bit 3 of flags is set, the binary search version is used.
+
+	flags: 
+	bit 0 : validate results
+	bit 1 : sort neighbour-list of the output  
+	bit 2 : remove self-edges
+	bit 3 : do not use `symmetrize_graph_merge()`
+*/
+struct LL_T_GRAPH* LL_T_SYMMETRIZE_GRAPH_MERGE(struct par_env* pe, struct LL_T_GRAPH* in_graph, unsigned int flags);
+
+struct LL_T_GRAPH* LL_T_SYMMETRIZE_GRAPH(struct par_env* pe, struct LL_T_GRAPH* in_graph, unsigned int flags)
+{
+	// Merging the graph and its transpose if there is enough memory
+		if(!(flags & 8U))
+		{
+			struct LL_T_GRAPH* out_graph = LL_T_SYMMETRIZE_GRAPH_MERGE(pe, in_graph, flags);
+			if(out_graph != NULL)
+				return out_graph;
+		}
+
+	// Initial checks
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && in_graph != NULL);
+		printf("\n\033[3;35msymmetrize_graph\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
+		unsigned long free_mem = get_free_mem();
+		if(free_mem < in_graph->edges_count * sizeof(LL_T_VID) + in_graph->vertices_count * sizeof(unsigned long))
+		{
+			printf("Not enough memory.\n");
+			return NULL;
+		}
+		
+	// Partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		LL_T_VID* partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(in_graph, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Allocating memory
+		struct LL_T_GRAPH* out_graph =calloc(sizeof(struct LL_T_GRAPH),1);
+		assert(out_graph != NULL);
+		out_graph->vertices_count = in_graph->vertices_count;
+		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
+		assert(out_graph->offsets_list != NULL);
+
+		unsigned long* last_offsets = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
+		assert(last_offsets != NULL);
+
+		unsigned char* edge_is_symmetric = numa_alloc_interleaved(sizeof(unsigned char) * ( 1 + in_graph->edges_count / 8));
+		assert(edge_is_symmetric != NULL);
+
+		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
+		assert(partitions_total_edges != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (1) Checking if neighbour-lists are sorted and decrease degree for self-edges	
+		unsigned long mt = - get_nano_time();
+		unsigned long self_edges = 0;
+		#pragma omp parallel  reduction(+:self_edges)
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				// Consuming partitions of a streamed graph as soon as they are loaded
+				LL_T_STREAM_WAIT_VERTICES(in_graph, partitions[partition], partitions[partition + 1]);
+
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)		
+				{
+					long degree = in_graph->offsets_list[v+1] - in_graph->offsets_list[v];
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+					{
+						if(flags & 4U)  // remove self edges
+							if(in_graph->edges_list[e] == v)
+							{
+								self_edges++;
+								degree--;
+							}
+
+						if(e < (in_graph->offsets_list[v + 1] - 1))
+							if(in_graph->edges_list[e] >= in_graph->edges_list[e + 1])
+							{
+								printf("v:%lu deg:%lu eo:%lu neighbour:%lu neighbour+1:%lu\n", (unsigned long)v, in_graph->offsets_list[v+1] - in_graph->offsets_list[v], e, (unsigned long)in_graph->edges_list[e], (unsigned long)in_graph->edges_list[e+1]);
+								assert(in_graph->edges_list[e] < in_graph->edges_list[e + 1] && "The input graph does not have sorted neighbour-lists");
+							}
+					}
+					assert(degree >= 0);
+					out_graph->offsets_list[v] = degree;
+				}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("1: Check");
+		printf("%-20s \t\t\t %'10lu\n","Self edges:", self_edges);
+
+	// (2) Identifying degree of vertices in the symmetric graph
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+					{
+						LL_T_VID dest = in_graph->edges_list[e];
+						
+						// self-edges are already in in_graph (if they should exist), so we do not add them again 
+						if(dest == v)
+							continue;
+
+						// Check if the edge exists in the neighbour-list of the dest 
+						if(LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], v) != -1UL)
+						{
+							// setting the bit in the edge_is_symmetric to prevent being searched again in Step 5
+							unsigned char val = (((unsigned char)1)<<(e % 8));
+							unsigned char val2 = __atomic_fetch_or(&edge_is_symmetric[e / 8], val, __ATOMIC_RELAXED);
+							assert((val2 & val) == 0);
+							continue;
+						}
+
+						// Increment the degree of dest
+						__atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
+					}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("2: Degree");
+		
+	// (3) Storing the total edges of each partition in partitions_total_edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			#pragma omp for nowait 
+			for(unsigned int p = 0; p<partitions_count; p++)
+			{
+				unsigned long sum = 0;
+				for(LL_T_VID v = partitions[p]; v < partitions[p + 1]; v++)
+					sum += out_graph->offsets_list[v];
+				partitions_total_edges[p] = sum;
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("3: Sum");
+	
+	// Partial sum of partitions_total_edges
+		{
+			unsigned long sum = 0;
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long temp = partitions_total_edges[p];
+				partitions_total_edges[p] = sum;
+				sum += temp;
+			}
+			out_graph->edges_count = sum;
+			printf("%-20s \t\t\t %'10lu\n","Symmetric edges:", out_graph->edges_count);
+		}
+		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
+		out_graph->edges_list = numa_alloc_interleaved(sizeof(LL_T_VID) * out_graph->edges_count);
+		assert(out_graph->edges_list != NULL);
+
+	// (4) Updating the last_offsets and out_graph->offsets_list and copying in_graph edges of each vertex
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				unsigned long current_offset = partitions_total_edges[partition];
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned long sym_degree = out_graph->offsets_list[v];
+					out_graph->offsets_list[v] = current_offset;
+					unsigned long last_offset = current_offset;
+					current_offset += sym_degree;
+
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v+1]; e++)
+					{
+						LL_T_VID neighbour = in_graph->edges_list[e];
+						if( (flags & 4U) && neighbour == v)
+							continue;
+						out_graph->edges_list[last_offset++] = neighbour;
+					}
+					
+					last_offsets[v] = last_offset;
+					assert(last_offset <= current_offset);
+				}
+
+				if(partition + 1 < partitions_count)
+					assert(current_offset == partitions_total_edges[partition + 1]);
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("4: last_offsets");	
+
+	// (5) Writing edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+				
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+					{
+						LL_T_VID src = v;
+						LL_T_VID dest = in_graph->edges_list[e];
+
+						// do not duplicate self edges
+						if(src == dest)
+							continue;
+
+						if(edge_is_symmetric[e / 8] & ( ((unsigned char)1) << (e % 8) ) )
+						// if(LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], src) != -1UL) 
+							continue;
+
+						unsigned long prev_offset = __atomic_fetch_add(&last_offsets[dest], 1UL, __ATOMIC_RELAXED);
+						assert(prev_offset < out_graph->offsets_list[dest+1]);
+						out_graph->edges_list[prev_offset] = src;
+					}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("5: Writing edges");
+
+	// Sorting
+		if((flags & 2U))
+		{	
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;	
+				
+				#pragma omp for nowait schedule(static, 16)
+				for(LL_T_VID v = 0; v < out_graph->vertices_count; v++)
+				{
+					unsigned long degree = out_graph->offsets_list[v+1] - out_graph->offsets_list[v];
+					if(degree < 2)
+						continue;
+					LL_T_QUICK_SORT(&out_graph->edges_list[out_graph->offsets_list[v]], 0, degree - 1);
+				}
+				
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+
+			PTIP("Sorting");
+		}
+
+	// Validation
+		if((flags & 1U))
+		{	
+			assert(out_graph->vertices_count == in_graph->vertices_count);
+			assert(out_graph->offsets_list[0] == 0);
+			assert(out_graph->offsets_list[out_graph->vertices_count] == out_graph->edges_count);
+
+			// If an edge is in out_graph it should be in in_graph 
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						assert(out_graph->offsets_list[v+1] == last_offsets[v]);
+						assert(out_graph->offsets_list[v+1] >= out_graph->offsets_list[v]);
+						for(unsigned long e = out_graph->offsets_list[v]; e < out_graph->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID dest = v;
+							LL_T_VID src = out_graph->edges_list[e];
+
+							if((flags & 4U) && src == dest)
+							{
+								printf("Validation error: src == dest %'lu->%'lu\n", (unsigned long)src, (unsigned long)dest);
+								assert(dest != src);
+							}
+
+							// it can be an edge in the neighbour-list of src						
+							unsigned long found =  LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[src], in_graph->offsets_list[src + 1], dest);
+							if(found != -1UL)
+								continue;
+
+							// it can be an edge in the neighbour-list of dest
+							found =  LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[dest], in_graph->offsets_list[dest + 1], src);
+							if(found == -1UL)
+							{
+								printf("Validation error: cannot find %'lu->%'lu\n", (unsigned long)src, (unsigned long)dest);
+								assert(found != -1UL);
+							}
+						}					
+					}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation 1");
+
+			// If an edge is in in_graph it should be in out_graph for both endpoints 
+			assert((flags & 2U) && "Neighbour-list should be sorted for the second evaluation.");
+			mt = - get_nano_time();
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+						for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID src = v;
+							LL_T_VID dest = in_graph->edges_list[e];
+
+							if((flags & 4U) && src == dest)
+								continue;
+
+							unsigned long found = LL_T_BINARY_SEARCH(out_graph->edges_list, out_graph->offsets_list[src], out_graph->offsets_list[src + 1], dest);
+							assert(found != -1UL);
+
+							found = LL_T_BINARY_SEARCH(out_graph->edges_list, out_graph->offsets_list[dest], out_graph->offsets_list[dest + 1], src);
+							assert(found != -1UL);
+						}	
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation 2");
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+		numa_free(last_offsets, (1 + in_graph->vertices_count) * sizeof(unsigned long));
+		last_offsets = NULL;
+		
+		free(partitions_total_edges);
+		partitions_total_edges = NULL;
+
+		numa_free(edge_is_symmetric, sizeof(unsigned char) * ( 1 + in_graph->edges_count / 8));
+		edge_is_symmetric = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		LL_T_PRINT_GRAPH(out_graph);
+
+	return out_graph;
+}
+
+/*
+	atomic_transpose() has two passes over edges to identify degree of vertex and then to write neighbour-lists.
+	Total complexity is 2|E| plus |E|log(|E|/|V|) if neighbour-lists should be sorted.
+
+	flags: 
+		bit 0 : validate results (requires bit 1 to be set)
+		bit 1 : sort neighbour-list of the output  
+		bit 2 : remove self-edges
+		bit 3 : only create offsets_list of the out_graph and do not write edges
+*/
+struct LL_T_GRAPH* LL_T_ATOMIC_TRANSPOSE(struct par_env* pe, struct LL_T_GRAPH* in_graph, unsigned int flags)
+{
+	// Initial checks
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && in_graph != NULL);
+		printf("\n\033[3;35matomic_transpose\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
+
+	// Partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		LL_T_VID* partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(in_graph, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Allocating memory
+		struct LL_T_GRAPH* out_graph =calloc(sizeof(struct LL_T_GRAPH),1);
+		assert(out_graph != NULL);
+		out_graph->vertices_count = in_graph->vertices_count;
+		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
+		assert(out_graph->offsets_list != NULL);
+
+		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
+		assert(partitions_total_edges != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (1) Identifying degree of vertices in the out_graph
+		unsigned long self_edges = 0;
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel  reduction(+:self_edges)
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				// Consuming partitions of a streamed graph as soon as they are loaded
+				LL_T_STREAM_WAIT_VERTICES(in_graph, partitions[partition], partitions[partition + 1]);
+
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+					{
+						LL_T_VID dest = in_graph->edges_list[e];
+						
+						if(dest == v)
+						{
+							self_edges++;
+							if(flags & 4U)  // remove self edges
+								continue;
+						}
+
+						// Increment the degree of dest
+						__atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
+					}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("(1) Identifying degrees");
+		printf("%-20s \t\t\t %'10lu\n","Self edges:", self_edges);
+		
+	// (2) Calculating sum of edges of each partition in partitions_total_edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			#pragma omp for nowait 
+			for(unsigned int p = 0; p<partitions_count; p++)
+			{
+				unsigned long sum = 0;
+				for(LL_T_VID v = partitions[p]; v < partitions[p + 1]; v++)
+					sum += out_graph->offsets_list[v];
+				partitions_total_edges[p] = sum;
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		PTIP("(2) Calculating sum");
+	
+	// Partial sum of partitions_total_edges
+		{
+			unsigned long sum = 0;
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long temp = partitions_total_edges[p];
+				partitions_total_edges[p] = sum;
+				sum += temp;
+			}
+			out_graph->edges_count = sum;
+			printf("%-20s \t\t\t %'10lu\n","out_graph edges:", out_graph->edges_count);
+		}
+		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
+
+	// (3) Updating the out_graph->offsets_list
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				unsigned long current_offset = partitions_total_edges[partition];
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned long t_degree = out_graph->offsets_list[v];
+					out_graph->offsets_list[v] = current_offset;
+					current_offset += t_degree;
+				}
+
+				if(partition + 1 < partitions_count)
+					assert(current_offset == partitions_total_edges[partition + 1]);
+				else
+					assert(current_offset == out_graph->edges_count);
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("(3) Update offsets_list");
+
+	if(flags & 8U)
+		goto atomic_transpose_release;
+
+	out_graph->edges_list = numa_alloc_interleaved(sizeof(LL_T_VID) * out_graph->edges_count);
+	assert(out_graph->edges_list != NULL);
+		
+	// (4) Writing edges
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+				
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+					{
+						LL_T_VID src = v;
+						LL_T_VID dest = in_graph->edges_list[e];
+
+						if(src == dest)
+							if(flags & 4U)  // remove self edges
+								continue;
+
+						unsigned long prev_offset = __atomic_fetch_add(&out_graph->offsets_list[dest], 1UL, __ATOMIC_RELAXED);
+						assert(prev_offset < out_graph->offsets_list[dest+1]);
+						out_graph->edges_list[prev_offset] = src;
+					}
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("(4) Writing edges");
+
+	// (5) Updating the out_graph->offsets_list
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+				unsigned long current_offset = partitions_total_edges[partition];
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned long next_vertex_offset = out_graph->offsets_list[v];
+					out_graph->offsets_list[v] = current_offset;
+					current_offset = next_vertex_offset;
+				}
+
+				if(partition + 1 < partitions_count)
+					assert(current_offset == partitions_total_edges[partition + 1]);
+				else
+					assert(current_offset == out_graph->edges_count);
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("(5) Updating offsets_list");	
+
+	// (6) Sorting
+		if(flags & (2U | 1U))
+			LL_T_SORT_NEIGHBOR_LISTS(pe, out_graph);
+			
+	// Validation
+		if((flags & 1U))
+		{	
+			assert(flags & 2U);
+			
+			unsigned int tf = 0;
+			if(flags & 4U)
+				tf = 1U;
+			int ret = LL_T_VALIDATE_TRANSPOSITION(pe, in_graph, out_graph, tf);
+			if(ret != 1)
+			{
+				printf("  Validation failed.\n");	
+				assert(ret == 1);
+			}
+		}
+
+	// Releasing memory
+	atomic_transpose_release: 
+
+		free(partitions);
+		partitions = NULL;
+
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+		free(partitions_total_edges);
+		partitions_total_edges = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		LL_T_PRINT_GRAPH(out_graph);
+		
+	return out_graph;
+}
+
+/*
+	symmetrize_graph_merge() creates the symmetric graph by merging the sorted neighbour-lists of 
+	the input graph (CSR) and its transpose (CSC) that is created by `atomic_transpose()`.
+
+	In contrast to `symmetrize_graph()`, no edge is searched in the neighbour-list of its destination, 
+	so there are no random log(d) probes into the neighbour-lists of hubs. Each vertex is processed 
+	by two streaming merges of its out- and in-neighbours: the first one counts the symmetric degree 
+	and the second one writes the neighbour-list. Repeated neighbours are merged, so the output has 
+	sorted and deduplicated neighbour-lists. 
+
+	The input graph should have sorted neighbour-lists. The transpose requires |E| * sizeof(VID) 
+	additional memory.
+
+	flags: 
+	bit 0 : validate results
+	bit 1 : sort neighbour-list of the output (neighbour-lists are always sorted)
+	bit 2 : remove self-edges
+*/
+struct LL_T_GRAPH* LL_T_SYMMETRIZE_GRAPH_MERGE(struct par_env* pe, struct LL_T_GRAPH* in_graph, unsigned int flags)
+{
+	// Initial checks
+		unsigned long tt = - get_nano_time();
+		assert(pe != NULL && in_graph != NULL);
+		printf("\n\033[3;35msymmetrize_graph_merge\033[0;37m using \033[3;35m%d\033[0;37m threads.\n", pe->threads_count);
+		unsigned long free_mem = get_free_mem();
+		if(free_mem < 3 * in_graph->edges_count * sizeof(LL_T_VID) + 2 * in_graph->vertices_count * sizeof(unsigned long))
+		{
+			printf("Not enough memory for the transpose.\n");
+			return NULL;
+		}
+
+	// (1) Transposing the input graph with sorted neighbour-lists
+		unsigned long mt = - get_nano_time();
+		struct LL_T_GRAPH* csc_graph = LL_T_ATOMIC_TRANSPOSE(pe, in_graph, 2U | (flags & 4U));
+		assert(csc_graph != NULL);
+		mt += get_nano_time();
+		PT("1: Transposing");
+		
+	// Partitioning
+		unsigned int thread_partitions = 64;
+		unsigned int partitions_count = pe->threads_count * thread_partitions;
+		LL_T_VID* partitions = calloc(sizeof(LL_T_VID), partitions_count+1);
+		assert(partitions != NULL);
+		LL_T_PARALLEL_EDGE_PARTITIONING(in_graph, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// Allocating memory
+		struct LL_T_GRAPH* out_graph =calloc(sizeof(struct LL_T_GRAPH),1);
+		assert(out_graph != NULL);
+		out_graph->vertices_count = in_graph->vertices_count;
+		out_graph->offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * ( 1 + in_graph->vertices_count));
+		assert(out_graph->offsets_list != NULL);
+
+		unsigned long* partitions_total_edges = calloc(sizeof(unsigned long), partitions_count);
+		assert(partitions_total_edges != NULL);
+
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// (2) Identifying degree of vertices in the symmetric graph by merging out- and in-neighbours
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				unsigned long sum = 0;
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned long e0 = in_graph->offsets_list[v];
+					unsigned long e0_end = in_graph->offsets_list[v + 1];
+					unsigned long e1 = csc_graph->offsets_list[v];
+					unsigned long e1_end = csc_graph->offsets_list[v + 1];
+					unsigned long degree = 0;
+					LL_T_VID last = -1;
+
+					for(unsigned long e = e0 + 1; e < e0_end; e++)
+						assert(in_graph->edges_list[e - 1] < in_graph->edges_list[e] && "The input graph does not have sorted neighbour-lists");
+
+					while(e0 < e0_end || e1 < e1_end)
+					{
+						LL_T_VID u;
+						if(e1 == e1_end || (e0 < e0_end && in_graph->edges_list[e0] <= csc_graph->edges_list[e1]))
+							u = in_graph->edges_list[e0++];
+						else
+							u = csc_graph->edges_list[e1++];
+
+						if(u == last || ((flags & 4U) && u == v))
+							continue;
+						last = u;
+						degree++;
+					}
+
+					out_graph->offsets_list[v] = degree;
+					sum += degree;
+				}
+				partitions_total_edges[partition] = sum;
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("2: Degree");
+	
+	// Partial sum of partitions_total_edges
+		{
+			unsigned long sum = 0;
+			for(unsigned int p = 0; p < partitions_count; p++)
+			{
+				unsigned long temp = partitions_total_edges[p];
+				partitions_total_edges[p] = sum;
+				sum += temp;
+			}
+			out_graph->edges_count = sum;
+			printf("%-20s \t\t\t %'10lu\n","Symmetric edges:", out_graph->edges_count);
+		}
+		out_graph->offsets_list[out_graph->vertices_count] = out_graph->edges_count;
+		out_graph->edges_list = numa_alloc_interleaved(sizeof(LL_T_VID) * out_graph->edges_count);
+		assert(out_graph->edges_list != NULL);
+
+	// (3) Updating the out_graph->offsets_list and writing the merged neighbour-lists
+		mt = - get_nano_time();
+		#pragma omp parallel  
+		{
+			unsigned int tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;		
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break; 
+
+				unsigned long current_offset = partitions_total_edges[partition];
+				for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned long sym_degree = out_graph->offsets_list[v];
+					out_graph->offsets_list[v] = current_offset;
+
+					unsigned long e0 = in_graph->offsets_list[v];
+					unsigned long e0_end = in_graph->offsets_list[v + 1];
+					unsigned long e1 = csc_graph->offsets_list[v];
+					unsigned long e1_end = csc_graph->offsets_list[v + 1];
+					LL_T_VID last = -1;
+
+					while(e0 < e0_end || e1 < e1_end)
+					{
+						LL_T_VID u;
+						if(e1 == e1_end || (e0 < e0_end && in_graph->edges_list[e0] <= csc_graph->edges_list[e1]))
+							u = in_graph->edges_list[e0++];
+						else
+							u = csc_graph->edges_list[e1++];
+
+						if(u == last || ((flags & 4U) && u == v))
+							continue;
+						last = u;
+						out_graph->edges_list[current_offset++] = u;
+					}
+
+					assert(current_offset == out_graph->offsets_list[v] + sym_degree);
+				}
+
+				if(partition + 1 < partitions_count)
+					assert(current_offset == partitions_total_edges[partition + 1]);
+				else
+					assert(current_offset == out_graph->edges_count);
+			}
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		PTIP("3: Writing edges");
+
+	// Validation
+		if((flags & 1U))
+		{	
+			// The transpose of the symmetric graph should be itself
+			mt = - get_nano_time();
+			int ret = LL_T_VALIDATE_TRANSPOSITION(pe, out_graph, out_graph, (flags & 4U) ? 1U : 0);
+			assert(ret == 1);
+
+			// An edge of in_graph should be in out_graph for both endpoints and vice versa
+			#pragma omp parallel  
+			{
+				unsigned int tid = omp_get_thread_num();
+				ttimes[tid] = - get_nano_time();
+				unsigned int partition = -1U;
+				while(1)
+				{
+					partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+					if(partition == -1U)
+						break; 
+					for(LL_T_VID v = partitions[partition]; v < partitions[partition + 1]; v++)
+					{
+						for(unsigned long e = in_graph->offsets_list[v]; e < in_graph->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID dest = in_graph->edges_list[e];
+							if((flags & 4U) && dest == v)
+								continue;
+
+							unsigned long found = LL_T_BINARY_SEARCH(out_graph->edges_list, out_graph->offsets_list[v], out_graph->offsets_list[v + 1], dest);
+							assert(found != -1UL);
+						}
+
+						for(unsigned long e = out_graph->offsets_list[v]; e < out_graph->offsets_list[v + 1]; e++)
+						{
+							LL_T_VID u = out_graph->edges_list[e];
+							assert(!((flags & 4U) && u == v));
+
+							unsigned long found = LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[v], in_graph->offsets_list[v + 1], u);
+							if(found == -1UL)
+								found = LL_T_BINARY_SEARCH(in_graph->edges_list, in_graph->offsets_list[u], in_graph->offsets_list[u + 1], v);
+							if(found == -1UL)
+							{
+								printf("Validation error: cannot find %'lu->%'lu\n", (unsigned long)v, (unsigned long)u);
+								assert(found != -1UL);
+							}
+						}
+					}
+				}
+				ttimes[tid] += get_nano_time();
+			}
+			mt += get_nano_time();
+			dynamic_partitioning_reset(dp);
+			PTIP("Validation");
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+
+		free(partitions_total_edges);
+		partitions_total_edges = NULL;
+
+		free(ttimes);
+		ttimes = NULL;
+
+		LL_T_RELEASE_GRAPH(csc_graph);
+		csc_graph = NULL;
+
+	// Finalizing
+		tt += get_nano_time();
+		printf("%-20s \t\t\t %'.3f (s)\n\n","Total time:", tt/1e9);
+		LL_T_PRINT_GRAPH(out_graph);
+
+	return out_graph;
+}
+
+#undef LL_T_GRAPH
+#undef LL_T_VID
+#undef LL_T_PARALLEL_EDGE_PARTITIONING
+#undef LL_T_BINARY_SEARCH
+#undef LL_T_QUICK_SORT
+#undef LL_T_PRINT_GRAPH
+#undef LL_T_STREAM_WAIT_VERTICES
+#undef LL_T_SORT_NEIGHBOR_LISTS
+#undef LL_T_VALIDATE_TRANSPOSITION
+#undef LL_T_SYMMETRIZE_GRAPH
+#undef LL_T_ATOMIC_TRANSPOSE
+#undef LL_T_SYMMETRIZE_GRAPH_MERGE
+#undef LL_T_RELEASE_GRAPH
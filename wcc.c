@@ -0,0 +1,394 @@
+#ifndef __WCC_C
+#define __WCC_C
+
+// This file contains the implementation of the Weakly Connected Components of directed graphs without symmetrization
+
+#include "aux.c"
+#include "graph.c"
+#include "omp.c"
+#include "partitioning.c"
+#include "cc.c"
+
+/*
+	The directed graph as the union of its out-neighbours (`csr`) and in-neighbours (`csc`), 
+	used to instantiate the Thrifty template (`cc_thrifty.tpl.c`) for `wcc_thrifty()`.
+	`edges_count` is the total number of edges of `csr` and `csc`.
+*/
+struct __wcc_graph
+{
+	unsigned long vertices_count;
+	unsigned long edges_count;
+	struct ll_400_graph* csr;
+	struct ll_400_graph* csc;
+};
+
+// The iterator over the out-neighbours and then the in-neighbours of a vertex
+struct __wcc_neighbours
+{
+	unsigned long e;
+	unsigned long end;
+	unsigned long in_e;
+	unsigned long in_end;
+};
+
+// Edge partitioning using the total (in + out) degrees
+int __wcc_edge_partitioning(struct __wcc_graph* g, unsigned int* partitions, unsigned int partitions_count)
+{
+	struct ll_400_graph tg = {0};
+	tg.vertices_count = g->vertices_count;
+	tg.edges_count = g->edges_count;
+	tg.offsets_list = numa_alloc_interleaved(sizeof(unsigned long) * (g->vertices_count + 1));
+	assert(tg.offsets_list != NULL);
+	#pragma omp parallel for
+	for(unsigned int v = 0; v <= g->vertices_count; v++)
+		tg.offsets_list[v] = g->csr->offsets_list[v] + g->csc->offsets_list[v];
+
+	int ret = parallel_edge_partitioning(&tg, partitions, partitions_count);
+
+	numa_free(tg.offsets_list, sizeof(unsigned long) * (g->vertices_count + 1));
+	tg.offsets_list = NULL;
+
+	return ret;
+}
+
+#define LL_T_GRAPH                         __wcc_graph
+#define LL_T_VID                           unsigned int
+#define LL_T_PARALLEL_EDGE_PARTITIONING    __wcc_edge_partitioning
+#define LL_T_STREAM_WAIT_VERTICES(g, start_vertex, end_vertex) do{}while(0)
+#define LL_T_CC_THRIFTY                    __wcc_thrifty
+#define LL_T_NEIGHBOURS                    struct __wcc_neighbours
+#define LL_T_CURSOR(g, c, v)
+#define LL_T_CURSOR_NEXT(g, c, it, v)      LL_T_GET_NEIGHBOURS(g, it, v)
+#define LL_T_GET_NEIGHBOURS(g, it, v) \
+	do{ \
+		(it).e = (g)->csr->offsets_list[v]; (it).end = (g)->csr->offsets_list[(v) + 1]; \
+		(it).in_e = (g)->csc->offsets_list[v]; (it).in_end = (g)->csc->offsets_list[(v) + 1]; \
+	}while(0)
+#define LL_T_DEGREE(g, it, v)              ((it).end - (it).e + (it).in_end - (it).in_e)
+#define LL_T_NEXT_NEIGHBOUR(g, it, u) \
+	((it).e < (it).end ? ((u) = (g)->csr->edges_list[(it).e++], 1) : \
+	(it).in_e < (it).in_end ? ((u) = (g)->csc->edges_list[(it).in_e++], 1) : 0)
+#define LL_T_INITIAL_PUSH(g, cc, v, tid) \
+	for(unsigned int __d = 0; __d < 2; __d++) \
+	{ \
+		struct ll_400_graph* __g = __d == 0 ? (g)->csr : (g)->csc; \
+		unsigned long __length = __g->offsets_list[(v) + 1] - __g->offsets_list[v]; \
+		unsigned long __start = __g->offsets_list[v] + __length * (tid) / pe->threads_count; \
+		unsigned long __end = __g->offsets_list[v] + __length * ((tid) + 1) / pe->threads_count; \
+		for(unsigned long __e = __start; __e < __end; __e++) \
+			(cc)[__g->edges_list[__e]] = 0; \
+	}
+#include "cc_thrifty.tpl.c"
+
+/*
+	Thrifty Label Propagation for Weakly Connected Components
+
+	The steps are the same as `cc_thrifty_400()` (Zero Planting, Initial Push, pull iterations with Zero
+	Convergence, Pull-Frontier, and push iterations), but instead of the symmetrized graph, both the
+	out-neighbours (`csr`) and the in-neighbours (`csc`) of each vertex are traversed. So, the symmetrized
+	graph is not materialized and `csc` can be created by `potra()` without sorting.
+	It is instantiated from `cc_thrifty.tpl.c` with a neighbour iterator over `csr` and `csc`.
+
+	The zero label is planted at the vertex with the max total (in + out) degree and the partitions are
+	created using the total degrees.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: push max-degree
+		[9]: ID of vertex with max degree, i.e., with zero CC val.
+
+	Returns the array of labels, similar to `cc_thrifty_400()`
+*/
+unsigned int* wcc_thrifty(struct par_env* pe, struct ll_400_graph* csr, struct ll_400_graph* csc, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	assert(pe != NULL && csr != NULL && csc != NULL);
+	assert(csr->vertices_count == csc->vertices_count && csr->edges_count == csc->edges_count);
+
+	struct __wcc_graph g = {csr->vertices_count, csr->edges_count + csc->edges_count, csr, csc};
+
+	return __wcc_thrifty(pe, &g, flags, exec_info, ccs_p);
+}
+
+/*
+	Afforest with a push pass for Weakly Connected Components of directed graphs using only the CSR
+
+	Similar to `cc_afforest()`, the first `LL_CC_AFFOREST_ROUNDS` out-neighbours of each vertex are linked using
+	the CAS linking of `cc_jt()`, the trees are compressed, and the largest intermediate component is identified
+	by sampling. In a symmetric graph, the remaining edges of the vertices of the largest component can be
+	skipped, as the other endpoint processes the edge. In the CSR of a directed graph, each edge is seen only
+	from its source, so the remaining edges are processed by a push pass instead:
+		- the vertices out of the largest component link all their remaining out-neighbours,
+		- the vertices in the largest component only link the out-neighbours that are not in
+		the largest component, i.e., the edges with both endpoints in the largest component are skipped.
+
+	So, neither the CSC nor the symmetrized graph are required.
+
+	flags:
+		bit 0: print stats
+		bit 1: do not reset papi
+
+	exec_info: if not NULL, will have
+		[0]: exec time
+		[1-7]: papi events
+		[8]: ID of the root of the largest intermediate component
+		[9]: number of vertices in the largest intermediate component
+		[10]: number of edges linked in the push pass
+
+	Returns the array of labels, the minimum vertex ID of each component
+*/
+
+unsigned int* wcc_afforest_push(struct par_env* pe, struct ll_400_graph* csr, unsigned int flags, unsigned long* exec_info, unsigned int* ccs_p)
+{
+	// Initial checks
+		assert(pe != NULL && csr != NULL && csr->vertices_count > 0);
+		unsigned long t0 = - get_nano_time();
+		printf("\n\033[3;31mwcc_afforest_push\033[0;37m\n");
+		const unsigned int vc = csr->vertices_count;
+
+	// Reset papi
+		if(!(flags & 2U))
+			#pragma omp parallel
+			{
+				unsigned tid = omp_get_thread_num();
+				papi_reset(pe->papi_args[tid]);
+			}
+
+	// Allocate memory
+		unsigned int* comp = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+		assert(comp != NULL);
+		unsigned long* ttimes = calloc(sizeof(unsigned long), pe->threads_count);
+		assert(ttimes != NULL);
+
+	// Edge partitioning
+		unsigned int partitions_count = pe->threads_count * 64;
+		unsigned int* partitions = calloc(sizeof(unsigned int), partitions_count + 1);
+		assert(partitions != NULL);
+		parallel_edge_partitioning(csr, partitions, partitions_count);
+		struct dynamic_partitioning* dp = dynamic_partitioning_initialize(pe, partitions_count);
+
+	// (1) Sampled linking
+		unsigned long mt = - get_nano_time();
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for
+			for(unsigned int v = 0; v < vc; v++)
+				comp[v] = v;
+
+			for(unsigned int r = 0; r < LL_CC_AFFOREST_ROUNDS; r++)
+			{
+				#pragma omp for schedule(dynamic, 4096)
+				for(unsigned int v = 0; v < vc; v++)
+					if(csr->offsets_list[v] + r < csr->offsets_list[v + 1])
+						__cc_jt_link(comp, v, csr->edges_list[csr->offsets_list[v] + r]);
+
+				#pragma omp for schedule(dynamic, 4096)
+				for(unsigned int v = 0; v < vc; v++)
+					__cc_jt_compress(comp, v);
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(1) Sampled linking:");
+
+	// (2) Finding the largest intermediate component by sampling
+		mt = - get_nano_time();
+		unsigned int largest = __cc_afforest_largest(comp, vc);
+		unsigned long largest_size = 0;
+		#pragma omp parallel for reduction(+:largest_size)
+		for(unsigned int v = 0; v < vc; v++)
+			if(comp[v] == largest)
+				largest_size++;
+		mt += get_nano_time();
+		if(flags & 1U)
+		{
+			PT("(2) Largest component:");
+			printf("Largest intermediate component: %'lu vertices (%.1f%%), root: %'u\n", largest_size, 100.0 * largest_size / vc, largest);
+		}
+
+	// (3) Push pass over the remaining edges
+		mt = - get_nano_time();
+		unsigned long pushed_edges = 0;
+		#pragma omp parallel reduction(+:pushed_edges)
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+			unsigned int partition = -1U;
+
+			while(1)
+			{
+				partition = dynamic_partitioning_get_next_partition(dp, tid, partition);
+				if(partition == -1U)
+					break;
+
+				for(unsigned int v = partitions[partition]; v < partitions[partition + 1]; v++)
+				{
+					unsigned int in_largest = comp[v] == largest;
+					for(unsigned long e = csr->offsets_list[v] + LL_CC_AFFOREST_ROUNDS; e < csr->offsets_list[v + 1]; e++)
+					{
+						unsigned int u = csr->edges_list[e];
+						if(in_largest && comp[u] == largest)
+							continue;
+
+						__cc_jt_link(comp, v, u);
+						pushed_edges++;
+					}
+				}
+			}
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		dynamic_partitioning_reset(dp);
+		if(flags & 1U)
+		{
+			char temp[255];
+			sprintf(temp, "(3) Push pass, linked edges: %'lu:", pushed_edges);
+			PTIP(temp);
+		}
+
+	// (4) Final compression
+		mt = - get_nano_time();
+		#pragma omp parallel
+		{
+			unsigned tid = omp_get_thread_num();
+			ttimes[tid] = - get_nano_time();
+
+			#pragma omp for schedule(dynamic, 4096)
+			for(unsigned int v = 0; v < vc; v++)
+				__cc_jt_compress(comp, v);
+
+			ttimes[tid] += get_nano_time();
+		}
+		mt += get_nano_time();
+		if(flags & 1U)
+			PTIP("(4) Compression:");
+
+	// Saving events
+		if(!(flags & 2U))
+		{
+			#pragma omp parallel
+			{
+				assert(0 == thread_papi_read(pe));
+			}
+			if(flags & 1U)
+				print_hw_events(pe, 1);
+			if(exec_info)
+				copy_reset_hw_events(pe, &exec_info[1], 1);
+		}
+
+	// Counting number of components
+		if(ccs_p)
+		{
+			unsigned int ccs = 0;
+			#pragma omp parallel for reduction(+:ccs)
+			for(unsigned int v = 0; v < vc; v++)
+				if(comp[v] == v)
+					ccs++;
+			printf("|CCs|:            \t\t%'u\n", ccs);
+			*ccs_p = ccs;
+		}
+
+	// Finalizing
+		t0 += get_nano_time();
+		printf("Total exec. time: \t\t %'.1f (ms)\n\n",t0/1e6);
+		if(exec_info)
+		{
+			exec_info[0] = t0;
+			exec_info[8] = largest;
+			exec_info[9] = largest_size;
+			exec_info[10] = pushed_edges;
+		}
+
+	// Releasing memory
+		free(partitions);
+		partitions = NULL;
+		dynamic_partitioning_release(dp);
+		dp = NULL;
+		free(ttimes);
+		ttimes = NULL;
+
+	return comp;
+}
+
+/*
+	Validates the labels of weakly connected components using a serial union-find over the edges of the CSR:
+		(1) all vertices of a component have the same label,
+		(2) the number of components is the same.
+	As explained in `alg2_thrifty.c`, (1) and (2) guarantee that the vertices of different components have
+	different labels.
+
+	Returns 1 if the labels are valid.
+*/
+int wcc_validate(struct par_env* pe, struct ll_400_graph* csr, unsigned int* cc, unsigned int ccs)
+{
+	assert(pe != NULL && csr != NULL && cc != NULL);
+	const unsigned int vc = csr->vertices_count;
+
+	unsigned int* root = numa_alloc_interleaved(sizeof(unsigned int) * vc);
+	assert(root != NULL);
+	for(unsigned int v = 0; v < vc; v++)
+		root[v] = v;
+
+	for(unsigned int v = 0; v < vc; v++)
+		for(unsigned long e = csr->offsets_list[v]; e < csr->offsets_list[v + 1]; e++)
+		{
+			unsigned int a = v;
+			while(root[a] != a)
+				a = root[a] = root[root[a]];
+			unsigned int b = csr->edges_list[e];
+			while(root[b] != b)
+				b = root[b] = root[root[b]];
+			if(a < b)
+				root[b] = a;
+			else if(b < a)
+				root[a] = b;
+		}
+
+	unsigned int serial_ccs = 0;
+	unsigned long errors = 0;
+	for(unsigned int v = 0; v < vc; v++)
+	{
+		unsigned int r = v;
+		while(root[r] != r)
+			r = root[r];
+		root[v] = r;
+		if(r == v)
+			serial_ccs++;
+		else if(cc[v] != cc[r])
+			errors++;
+	}
+	if(serial_ccs != ccs)
+		errors++;
+
+	if(errors)
+		printf("Validation:\t\t\033[1;31mIncorrect\033[0;37m, %'lu errors, |CCs|: %'u, serial |CCs|: %'u\n", errors, ccs, serial_ccs);
+	else
+		printf("Validation:\t\t\033[1;33mCorrect\033[0;37m\n");
+
+	numa_free(root, sizeof(unsigned int) * vc);
+	root = NULL;
+
+	return errors == 0;
+}
+
+void wcc_release(struct ll_400_graph* g, unsigned int* cc)
+{
+	assert(g != NULL && cc != NULL);
+
+	numa_free(cc, sizeof(unsigned int) * g->vertices_count);
+	cc = NULL;
+
+	return;
+}
+
+#endif